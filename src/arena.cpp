@@ -0,0 +1,221 @@
+#include "arena.h"
+#include "movement_patterns.h"
+#include <algorithm>
+
+namespace {
+  // Attempts at a random free cell before giving up for this tick
+  constexpr int kMaxSpawnAttempts = 64;
+}
+
+Arena::Arena(const BoardConfig &config, std::size_t food_count, uint32_t seed)
+    : config(config), width(static_cast<int>(config.gridWidth)),
+      height(static_cast<int>(config.gridHeight)),
+      step_seconds(1.0f / config.tickRate),
+      cells(width, height),
+      obstacles(width, height),
+      food_at(static_cast<std::size_t>(width) * height, -1),
+      head_stamp(static_cast<std::size_t>(width) * height, 0),
+      head_owner(static_cast<std::size_t>(width) * height, 0),
+      engine(seed) {
+  obstacles.SeedRandom(seed ^ 0x9E3779B9u);
+  obstacles.SetNoiseSeed(seed ^ 0xC2B2AE35u);
+  obstacles.BuildNoiseField(0); // Now, on every core, rather than mid-step on the first drifter
+  MovementPatterns::MovementCalculator::SeedRandomWalk(seed ^ 0x85EBCA6Bu);
+  obstacles.SetDifficultyLevel(config.GetDifficultyLevel(0));
+  obstacles.SetSpawnRate(config.GetSpawnRate(config.GetDifficultyLevel(0)));
+
+  foods.resize(std::max<std::size_t>(food_count, 1), SDL_Point{-1, -1});
+  for (std::size_t food = 0; food < foods.size(); ++food) {
+    PlaceFood(food);
+  }
+}
+
+std::size_t Arena::AddSnake(std::unique_ptr<SnakeInput> input) {
+  players.emplace_back(Snake(width, height, &cells), std::move(input));
+  Player &player = players.back();
+  player.snake.alive = false;
+  if (Spawn(player)) {
+    // Later spawns this tick must not land on it
+    std::size_t cell = Cell(static_cast<int>(player.snake.head_x), static_cast<int>(player.snake.head_y));
+    head_stamp[cell] = head_generation;
+    head_owner[cell] = static_cast<uint32_t>(players.size() - 1);
+  }
+  return players.size() - 1;
+}
+
+bool Arena::IsCellFree(int x, int y) const {
+  std::size_t cell = Cell(x, y);
+  return !cells.IsOccupied(x, y) && head_stamp[cell] != head_generation &&
+         !obstacles.CheckCollisionWithPoint(x, y);
+}
+
+bool Arena::Spawn(Player &player) {
+  std::uniform_int_distribution<int> random_x(0, width - 1);
+  std::uniform_int_distribution<int> random_y(0, height - 1);
+  std::uniform_int_distribution<int> random_direction(0, 3);
+  for (int attempt = 0; attempt < kMaxSpawnAttempts; ++attempt) {
+    int x = random_x(engine);
+    int y = random_y(engine);
+    if (!IsCellFree(x, y) || food_at[Cell(x, y)] >= 0) {
+      continue;
+    }
+    player.snake = Snake(width, height, &cells);
+    player.snake.head_x = static_cast<float>(x);
+    player.snake.head_y = static_cast<float>(y);
+    player.snake.direction = static_cast<Snake::Direction>(random_direction(engine));
+    player.score = 0;
+    player.on_board = true;
+    ++alive_count;
+    return true;
+  }
+  return false;
+}
+
+void Arena::PlaceFood(std::size_t food) {
+  std::uniform_int_distribution<int> random_x(0, width - 1);
+  std::uniform_int_distribution<int> random_y(0, height - 1);
+  if (foods[food].x >= 0) {
+    food_at[Cell(foods[food].x, foods[food].y)] = -1;
+  }
+  while (true) {
+    int x = random_x(engine);
+    int y = random_y(engine);
+    std::size_t cell = Cell(x, y);
+    if (!cells.IsOccupied(x, y) && food_at[cell] < 0 && obstacles.IsValidFoodPosition(x, y)) {
+      foods[food] = SDL_Point{x, y};
+      food_at[cell] = static_cast<int32_t>(food);
+      if (!food_fields.empty()) {
+        food_fields[food].SetTarget(foods[food]);
+      }
+      return;
+    }
+  }
+}
+
+void Arena::SetFlowFields(bool enabled) {
+  if (!enabled) {
+    obstacles.SetFixedObstacleListener(nullptr);
+    food_fields.clear();
+    return;
+  }
+  if (!food_fields.empty()) {
+    return;
+  }
+  std::vector<const Obstacle *> existing;
+  obstacles.QueryObstaclesInRect(SDL_Rect{0, 0, width, height}, existing);
+  food_fields.reserve(foods.size());
+  for (const SDL_Point &food : foods) {
+    food_fields.emplace_back(width, height);
+    FlowField &field = food_fields.back();
+    field.SetWrapping(true);
+    for (const Obstacle *obstacle : existing) {
+      if (obstacle->GetType() == ObstacleType::FIXED) {
+        field.Block(obstacle->GetX(), obstacle->GetY());
+      }
+    }
+    field.SetTarget(food);
+  }
+  obstacles.SetFixedObstacleListener(this);
+}
+
+void Arena::OnFixedObstacleAdded(int x, int y) {
+  for (FlowField &field : food_fields) {
+    field.Block(x, y);
+  }
+}
+
+void Arena::OnFixedObstacleRemoved(int x, int y) {
+  for (FlowField &field : food_fields) {
+    field.Unblock(x, y);
+  }
+}
+
+void Arena::Kill(std::size_t index) {
+  Player &player = players[index];
+  if (!player.on_board) {
+    return; // Listed twice after a head-on collision
+  }
+  player.on_board = false;
+  player.snake.alive = false;
+  player.snake.ClearBody(); // The board frees up at once
+  ++player.deaths;
+  --alive_count;
+}
+
+void Arena::Step() {
+  ++ticks;
+
+  // Same order as Simulation::Step
+  obstacles.UpdateObstacleMovement();
+  obstacles.UpdateObstacleLifetimes(step_seconds);
+  obstacles.ClearExpiredObstacles();
+  if (obstacles.ShouldSpawnObstacle(step_seconds)) {
+    obstacles.SpawnRandomObstacle();
+  }
+
+  // Inputs see last tick's heads; then every snake moves
+  for (std::size_t i = 0; i < players.size(); ++i) {
+    Player &player = players[i];
+    if (!player.snake.alive) {
+      if (respawn_dead) {
+        Spawn(player);
+      }
+      continue;
+    }
+    player.input->Steer(*this, i, player.snake);
+  }
+  for (Player &player : players) {
+    if (player.snake.alive) {
+      player.snake.Update(); // Moves only: the shared grid leaves collisions to us
+    }
+  }
+
+  // Settle collisions against the final positions, so the outcome does not
+  // depend on which snake moved first
+  ++head_generation;
+  dying.clear();
+  for (std::size_t i = 0; i < players.size(); ++i) {
+    Snake &snake = players[i].snake;
+    if (!snake.alive) {
+      continue; // Dead before this tick, or just lost a head-on collision
+    }
+    int x = static_cast<int>(snake.head_x);
+    int y = static_cast<int>(snake.head_y);
+    std::size_t cell = Cell(x, y);
+    if (cells.IsOccupied(x, y) || obstacles.CheckCollisionWithPoint(x, y)) {
+      snake.alive = false;
+      dying.push_back(i);
+      continue;
+    }
+    if (head_stamp[cell] == head_generation) {
+      // Head-on: both go
+      snake.alive = false;
+      dying.push_back(i);
+      players[head_owner[cell]].snake.alive = false;
+      dying.push_back(head_owner[cell]);
+      continue;
+    }
+    head_stamp[cell] = head_generation;
+    head_owner[cell] = static_cast<uint32_t>(i);
+
+    int32_t food = food_at[cell];
+    if (food >= 0) {
+      Player &player = players[i];
+      player.score++;
+      ++food_eaten;
+      snake.GrowBody();
+      snake.speed += 0.02;
+      if (player.score > best_score) {
+        best_score = player.score;
+        int level = config.GetDifficultyLevel(best_score);
+        obstacles.SetDifficultyLevel(level);
+        obstacles.SetSpawnRate(config.GetSpawnRate(level));
+      }
+      PlaceFood(static_cast<std::size_t>(food));
+    }
+  }
+
+  for (std::size_t index : dying) {
+    Kill(index);
+  }
+}
@@ -0,0 +1,125 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "SDL.h"
+#include "board_config.h"
+#include "flow_field.h"
+#include "obstacle_manager.h"
+#include "occupancy_grid.h"
+#include "snake.h"
+#include "snake_input.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Several snakes (bots or players) on one board without a window, stepped
+// one fixed tick at a time like Simulation. Every snake records its body in
+// one shared OccupancyGrid and heads are stamped into a per-cell grid each
+// tick, so a snake running into any body, head or obstacle is an O(1)
+// lookup and a tick costs O(snakes) whatever their total length. Snakes
+// move in index order without checking anything; every head is then tested
+// against the bodies, obstacles and other heads as they stand after all of
+// them moved, so the order makes no difference (a tail cell freed this tick
+// is free for any snake).
+//
+// Each snake has its own input source, score and food item (snake i goes
+// for food i % food count; any snake may eat any food).
+class Arena : private FixedObstacleListener {
+public:
+  Arena(const BoardConfig &config, std::size_t food_count, uint32_t seed);
+
+  // Snakes point into the shared grid
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  // Places the snake on a random free cell; returns its index
+  std::size_t AddSnake(std::unique_ptr<SnakeInput> input);
+
+  // Hands the snake to another input source (a network player leaving it
+  // to a bot, or a new player taking over a bot's snake)
+  void SetInput(std::size_t index, std::unique_ptr<SnakeInput> input) { players[index].input = std::move(input); }
+
+  // When set, a dead snake reappears on a free cell next tick with score 0
+  void SetRespawn(bool respawn) { respawn_dead = respawn; }
+
+  // Keeps one FlowField per food item, shared by every snake heading for
+  // it: rebuilt when the food moves and repaired as fixed obstacles appear
+  // and expire (moving obstacles and bodies change every tick, so BotInput
+  // checks those one step ahead instead). About 11 bytes per cell per food.
+  void SetFlowFields(bool enabled);
+  const FlowField *GetFlowFieldFor(std::size_t index) const {
+    return food_fields.empty() ? nullptr : &food_fields[index % food_fields.size()];
+  }
+
+  void Step(); // One fixed update (1 / config.tickRate seconds)
+
+  int GetWidth() const { return width; }
+  int GetHeight() const { return height; }
+  const BoardConfig &GetConfig() const { return config; }
+  uint64_t GetTicks() const { return ticks; }
+
+  std::size_t GetSnakeCount() const { return players.size(); }
+  std::size_t GetAliveCount() const { return alive_count; }
+  const Snake &GetSnake(std::size_t index) const { return players[index].snake; }
+  SnakeInput &GetInput(std::size_t index) { return *players[index].input; }
+  int GetScore(std::size_t index) const { return players[index].score; }
+  uint64_t GetDeaths(std::size_t index) const { return players[index].deaths; }
+  int GetBestScore() const { return best_score; } // Highest score any snake reached
+  uint64_t GetFoodEaten() const { return food_eaten; }
+
+  const std::vector<SDL_Point> &GetFoods() const { return foods; }
+  const SDL_Point &GetFoodFor(std::size_t index) const { return foods[index % foods.size()]; }
+  const ObstacleManager &GetObstacles() const { return obstacles; }
+
+  // No body, head or obstacle in the cell
+  bool IsCellFree(int x, int y) const;
+
+private:
+  struct Player {
+    Snake snake;
+    std::unique_ptr<SnakeInput> input;
+    int score{0};
+    uint64_t deaths{0};
+    bool on_board{false}; // Spawned and not yet removed
+
+    Player(Snake snake, std::unique_ptr<SnakeInput> input)
+        : snake(std::move(snake)), input(std::move(input)) {}
+  };
+
+  BoardConfig config;
+  int width;
+  int height;
+  float step_seconds;
+  OccupancyGrid cells; // Bodies of every snake
+  ObstacleManager obstacles;
+  std::vector<Player> players;
+  std::vector<SDL_Point> foods;
+  std::vector<int32_t> food_at; // Food index per cell, -1 for none
+  std::vector<FlowField> food_fields; // One per food while SetFlowFields is on
+
+  // Heads of the live snakes: a cell holds one when its stamp is the
+  // current generation, and head_owner says whose
+  std::vector<uint32_t> head_stamp;
+  std::vector<uint32_t> head_owner;
+  uint32_t head_generation{1};
+
+  std::vector<std::size_t> dying; // Scratch, reused every tick
+  std::size_t alive_count{0};
+  int best_score{0};
+  uint64_t food_eaten{0};
+  bool respawn_dead{false};
+  uint64_t ticks{0};
+
+  std::mt19937 engine;
+
+  std::size_t Cell(int x, int y) const { return static_cast<std::size_t>(y) * width + x; }
+  bool Spawn(Player &player);
+  void PlaceFood(std::size_t food);
+  void Kill(std::size_t index);
+
+  void OnFixedObstacleAdded(int x, int y) override;
+  void OnFixedObstacleRemoved(int x, int y) override;
+};
+
+#endif
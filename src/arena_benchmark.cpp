@@ -0,0 +1,90 @@
+// Multi-snake benchmark: many bot snakes (and one scripted player) on one
+// board with respawning, timing the whole tick. The cost per snake-tick
+// should stay flat as the snake count grows. A last pair of runs with a few
+// foods compares greedy bots against bots following the arena's flow fields.
+//
+// Usage: ArenaBenchmark [bots] [grid size] [ticks] [seed]
+//        (without a bot count, runs 250, 1000 and 4000 bots)
+
+#include "arena.h"
+#include "board_config.h"
+#include "snake_input.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  void RunArena(std::size_t bots, std::size_t foods, bool flow_fields, uint32_t grid, uint64_t ticks,
+                uint32_t seed) {
+    BoardConfig config(grid, grid);
+    Arena arena(config, foods, seed);
+    arena.SetRespawn(true);
+    arena.SetFlowFields(flow_fields);
+
+    // Snake 0 is driven like a local player: it turns every second
+    auto player = std::make_unique<DirectionInput>();
+    DirectionInput *player_input = player.get();
+    arena.AddSnake(std::move(player));
+    for (std::size_t i = 0; i < bots; ++i) {
+      arena.AddSnake(std::make_unique<BotInput>());
+    }
+
+    const Snake::Direction turns[] = {Snake::Direction::kLeft, Snake::Direction::kUp,
+                                      Snake::Direction::kRight, Snake::Direction::kDown};
+    uint64_t alive_total = 0;
+    auto start = Clock::now();
+    for (uint64_t tick = 0; tick < ticks; ++tick) {
+      if (tick % config.tickRate == 0) {
+        player_input->SetDirection(turns[(tick / config.tickRate) % 4]);
+      }
+      arena.Step();
+      alive_total += arena.GetAliveCount();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint64_t deaths = 0;
+    uint64_t length = 0;
+    for (std::size_t i = 0; i < arena.GetSnakeCount(); ++i) {
+      deaths += arena.GetDeaths(i);
+      length += static_cast<uint64_t>(arena.GetSnake(i).body.size());
+    }
+    double snake_ticks = static_cast<double>(ticks) * arena.GetSnakeCount();
+    std::cout << std::setw(5) << bots << " bots on " << grid << "x" << grid << ", " << foods
+              << (flow_fields ? " foods, flow fields: " : " foods: ") << std::fixed
+              << std::setprecision(1) << ticks / seconds << " ticks/s, " << std::setprecision(1)
+              << seconds * 1e9 / snake_ticks << " ns per snake-tick, avg alive "
+              << alive_total / ticks << ", food eaten " << arena.GetFoodEaten() << ", deaths "
+              << deaths << ", best score " << arena.GetBestScore() << ", total body "
+              << length << " cells, player score " << arena.GetScore(0) << std::endl;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  std::size_t bots = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 0;
+  uint32_t grid = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 512;
+  uint64_t ticks = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 6000;
+  uint32_t seed = argc > 4 ? static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 1;
+  grid = std::max<uint32_t>(grid, 8);
+  ticks = std::max<uint64_t>(ticks, 1);
+
+  std::cout << "Arena benchmark: " << ticks << " ticks per run, respawning" << std::endl;
+  if (bots > 0) {
+    RunArena(bots, std::max<std::size_t>(1, bots / 8), false, grid, ticks, seed);
+  } else {
+    for (std::size_t count : {250, 1000, 4000}) {
+      RunArena(count, count / 8, false, grid, ticks, seed);
+    }
+  }
+  // Flow fields cost about 11 bytes per cell per food, so keep the food count small
+  const std::size_t flow_bots = bots > 0 ? bots : 1000;
+  RunArena(flow_bots, 8, false, grid, ticks, seed);
+  RunArena(flow_bots, 8, true, grid, ticks, seed);
+  return 0;
+}
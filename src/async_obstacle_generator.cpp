@@ -195,6 +195,32 @@ std::vector<std::unique_ptr<Obstacle>> AsyncObstacleGenerator::GenerateObstacles
         }
     }
 
+    // Generate a flocking swarm: free cells within two of one centre, all
+    // heading the same way
+    if (config.swarm_size > 0) {
+        SDL_Point centre = GenerateRandomPosition(used_positions);
+        std::uniform_int_distribution<int> offset_dist(-2, 2);
+        std::uniform_real_distribution<float> angle_dist(0.0f, 2.0f * static_cast<float>(M_PI));
+        float angle = angle_dist(engine);
+        float lifetime = GenerateRandomLifetime(config.min_lifetime, config.max_lifetime);
+        int placed = 0;
+        for (int attempt = 0; attempt < config.swarm_size * 4 && placed < config.swarm_size; ++attempt) {
+            SDL_Point position{(centre.x + offset_dist(engine) + grid_width) % grid_width,
+                               (centre.y + offset_dist(engine) + grid_height) % grid_height};
+            if (!IsPositionValid(position, used_positions)) {
+                continue;
+            }
+            auto obstacle = std::make_unique<MovingObstacle>(
+                position.x, position.y, grid_width, grid_height, MovementPattern::FLOCKING, lifetime);
+            obstacle->SetVelocity(obstacle->GetSpeed() * std::cos(angle), obstacle->GetSpeed() * std::sin(angle));
+
+            used_positions.push_back(position);
+            obstacles.push_back(std::move(obstacle));
+            total_generated_obstacles.fetch_add(1);
+            ++placed;
+        }
+    }
+
     return obstacles;
 }
 
@@ -299,6 +325,8 @@ SDL_Point AsyncObstacleGenerator::GenerateRandomPosition(const std::vector<SDL_P
 }
 
 MovementPattern AsyncObstacleGenerator::GetRandomMovementPattern() const {
+    // Not FLOCKING, which comes as a swarm (GenerationConfig::swarm_size),
+    // or NOISE_DRIFT, which needs the level's noise field (ObstacleManager)
     std::uniform_int_distribution<int> pattern_dist(0, 4);
     int pattern_index = pattern_dist(engine);
 
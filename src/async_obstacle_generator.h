@@ -62,6 +62,7 @@ public:
         float max_lifetime{15.0f};
         bool avoid_snake_path{true};
         int max_retries{10};
+        int swarm_size{0}; // FLOCKING obstacles, placed as one group (they are never picked singly)
     };
 
     std::future<std::vector<std::unique_ptr<Obstacle>>>
@@ -0,0 +1,85 @@
+#include "atomic_file.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace AtomicFile {
+
+namespace {
+    // Writes and syncs a new file at `temp_path`
+    bool WriteTemporary(const std::string& temp_path, const uint8_t* data, std::size_t length) {
+        int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            std::cerr << "Warning: Could not create " << temp_path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        bool ok = true;
+        while (ok && length > 0) {
+            ssize_t written = ::write(fd, data, length);
+            if (written < 0) {
+                ok = errno == EINTR;
+                continue;
+            }
+            data += written;
+            length -= static_cast<std::size_t>(written);
+        }
+        ok = ok && SyncFile(fd);
+        return ::close(fd) == 0 && ok;
+    }
+}
+
+bool WriteFile(const std::string& path, const uint8_t* data, std::size_t length) {
+    std::string temp_path = path + ".tmp";
+    bool ok = WriteTemporary(temp_path, data, length);
+    ok = ok && std::rename(temp_path.c_str(), path.c_str()) == 0;
+
+    if (!ok) {
+        std::cerr << "Warning: Could not write " << path << ": " << std::strerror(errno) << std::endl;
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return SyncParentDirectory(path);
+}
+
+bool CreateExclusive(const std::string& path, const uint8_t* data, std::size_t length) {
+    // Unique per process, since callers are not serialised by any lock
+    std::string temp_path = path + ".tmp." + std::to_string(::getpid());
+    bool ok = WriteTemporary(temp_path, data, length);
+    bool linked = ok && ::link(temp_path.c_str(), path.c_str()) == 0;
+    int error = errno;
+    bool exists = linked || (ok && error == EEXIST);
+    std::remove(temp_path.c_str());
+
+    if (!exists) {
+        std::cerr << "Warning: Could not create " << path << ": " << std::strerror(error) << std::endl;
+        return false;
+    }
+    return !linked || SyncParentDirectory(path);
+}
+
+bool SyncFile(int fd) {
+#if defined(__linux__)
+    return ::fdatasync(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+bool SyncParentDirectory(const std::string& path) {
+    std::string::size_type slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+
+    int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+}
@@ -0,0 +1,26 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace AtomicFile {
+    // Replaces `path` with `data` so that after a crash the file holds either
+    // its old or its new contents: write "<path>.tmp", fsync it, rename it
+    // over `path`, then fsync the directory so the rename itself is durable.
+    bool WriteFile(const std::string& path, const uint8_t* data, std::size_t length);
+
+    // Like WriteFile, but only publishes the file if `path` does not exist
+    // yet (link instead of rename). Returns true if `path` exists afterwards,
+    // whether this call or a concurrent one created it.
+    bool CreateExclusive(const std::string& path, const uint8_t* data, std::size_t length);
+
+    // Flushes file data to stable storage (fdatasync where available)
+    bool SyncFile(int fd);
+
+    // Flushes the directory entry changes (creates, renames) under `path`'s parent
+    bool SyncParentDirectory(const std::string& path);
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "autopilot.h"
+
+namespace {
+  const Snake::Direction kDirections[] = {Snake::Direction::kUp, Snake::Direction::kRight,
+                                          Snake::Direction::kDown, Snake::Direction::kLeft};
+  const int kDirectionDx[] = {0, 1, 0, -1};
+  const int kDirectionDy[] = {-1, 0, 1, 0};
+
+  // Direction of a single step between neighbouring cells on a wrapping board
+  Snake::Direction DirectionBetween(const SDL_Point &from, const SDL_Point &to, int width, int height) {
+    if (to.x == (from.x + 1) % width && to.y == from.y) return Snake::Direction::kRight;
+    if (from.x == (to.x + 1) % width && to.y == from.y) return Snake::Direction::kLeft;
+    if (to.y == (from.y + 1) % height) return Snake::Direction::kDown;
+    return Snake::Direction::kUp;
+  }
+}
+
+void Autopilot::Steer(Snake &snake, const SDL_Point &food, const ObstacleManager &obstacles) {
+  SDL_Point head{static_cast<int>(snake.head_x), static_cast<int>(snake.head_y)};
+  if (head.x == last_head.x && head.y == last_head.y &&
+      food.x == last_food.x && food.y == last_food.y) {
+    return;
+  }
+  last_head = head;
+  last_food = food;
+
+  int width = obstacles.GetGridWidth();
+  int height = obstacles.GetGridHeight();
+  auto start = std::chrono::steady_clock::now();
+  if (pathfinder.GetWidth() != width || pathfinder.GetHeight() != height) {
+    pathfinder.Resize(width, height);
+    pathfinder.SetWrapping(true);
+  }
+  MarkBlockedCells(snake, obstacles);
+  pathfinder.FindPath(head, food, path);
+  total_plan_time += std::chrono::steady_clock::now() - start;
+  ++plan_count;
+
+  Snake::Direction direction = snake.direction;
+  if (path.size() >= 2 && !snake.IsReverse(DirectionBetween(path[0], path[1], width, height))) {
+    direction = DirectionBetween(path[0], path[1], width, height);
+  } else {
+    // No way to the food right now: stay alive and try again next cell
+    ++failed_plan_count;
+    ChooseSafeDirection(snake, obstacles, direction);
+  }
+  snake.direction = direction;
+}
+
+void Autopilot::Reset() {
+  last_head = {-1, -1};
+  last_food = {-1, -1};
+}
+
+void Autopilot::MarkBlockedCells(const Snake &snake, const ObstacleManager &obstacles) {
+  pathfinder.ClearBlocked();
+  for (const SDL_Point &cell : snake.body) {
+    pathfinder.SetBlocked(cell.x, cell.y);
+  }
+
+  SDL_Rect board{0, 0, obstacles.GetGridWidth(), obstacles.GetGridHeight()};
+  obstacles.ForEachObstacleInRect(board, [this](const Obstacle &obstacle) {
+    pathfinder.SetBlocked(obstacle.GetX(), obstacle.GetY());
+  });
+}
+
+bool Autopilot::ChooseSafeDirection(const Snake &snake, const ObstacleManager &obstacles,
+                                    Snake::Direction &direction) {
+  int head_x = static_cast<int>(snake.head_x);
+  int head_y = static_cast<int>(snake.head_y);
+  int width = obstacles.GetGridWidth();
+  int height = obstacles.GetGridHeight();
+
+  // Keep going straight if that is safe, otherwise take the first safe turn
+  int current = 0;
+  while (kDirections[current] != snake.direction) ++current;
+  for (int turn = 0; turn < 4; ++turn) {
+    int i = (current + turn) % 4;
+    if (snake.IsReverse(kDirections[i])) continue;
+    int x = (head_x + kDirectionDx[i] + width) % width; // The board wraps
+    int y = (head_y + kDirectionDy[i] + height) % height;
+    if (!snake.BodyCell(x, y) && !obstacles.CheckCollisionWithPoint(x, y)) {
+      direction = kDirections[i];
+      return true;
+    }
+  }
+  return false;
+}
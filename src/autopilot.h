@@ -0,0 +1,46 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "SDL.h"
+#include "snake.h"
+#include "obstacle_manager.h"
+#include "pathfinding_engine.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Plays the snake: steers toward the food along an A* path around obstacles
+// and the snake's own body, through the board edges where the snake wraps.
+// An input source in place of Controller::HandleInput, used by the game's
+// --autopilot mode and by the headless load generator. Planning reuses one
+// PathfindingEngine, so steering allocates nothing once warmed up.
+class Autopilot {
+public:
+  // Picks the snake's direction for this tick. Plans only when the head has
+  // entered a new cell or the food moved; otherwise keeps the last choice.
+  void Steer(Snake &snake, const SDL_Point &food, const ObstacleManager &obstacles);
+  void Reset();
+
+  // Statistics
+  uint64_t GetPlanCount() const { return plan_count; }
+  uint64_t GetFailedPlanCount() const { return failed_plan_count; } // No path to the food
+  std::chrono::nanoseconds GetTotalPlanTime() const { return total_plan_time; }
+
+private:
+  SDL_Point last_head{-1, -1};
+  SDL_Point last_food{-1, -1};
+
+  // Reused between plans
+  PathfindingEngine pathfinder{1, 1};
+  std::vector<SDL_Point> path;
+
+  uint64_t plan_count{0};
+  uint64_t failed_plan_count{0};
+  std::chrono::nanoseconds total_plan_time{0};
+
+  void MarkBlockedCells(const Snake &snake, const ObstacleManager &obstacles);
+  static bool ChooseSafeDirection(const Snake &snake, const ObstacleManager &obstacles,
+                                  Snake::Direction &direction);
+};
+
+#endif
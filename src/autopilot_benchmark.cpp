@@ -0,0 +1,76 @@
+// Headless autopilot load generator: plays complete games with the A*
+// autopilot and reports game and pathfinding throughput together, so
+// changes to either show up in one number.
+//
+// Usage: AutopilotBenchmark [games] [grid size] [seed]
+
+#include "autopilot.h"
+#include "board_config.h"
+#include "simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  // A good autopilot can survive for a long time; stop each game after
+  // this much simulated time so the run length stays predictable
+  constexpr uint64_t kMaxSimulatedSeconds = 300;
+}
+
+int main(int argc, char *argv[]) {
+  std::size_t games = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+  uint32_t grid = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 32;
+  uint32_t seed = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+  games = std::max<std::size_t>(games, 1);
+  grid = std::max<uint32_t>(grid, 4);
+
+  BoardConfig config(grid, grid);
+  Simulation simulation(config, seed);
+  Autopilot autopilot;
+  const uint64_t max_ticks = kMaxSimulatedSeconds * static_cast<uint64_t>(config.tickRate);
+
+  std::cout << "Autopilot benchmark: " << games << " games on " << config.Describe() << std::endl;
+
+  uint64_t total_score = 0;
+  uint64_t total_length = 0;
+  uint64_t total_ticks = 0;
+  int best_score = 0;
+  std::size_t timed_out = 0;
+
+  auto start = Clock::now();
+  for (std::size_t game = 0; game < games; ++game) {
+    simulation.Reset(seed + static_cast<uint32_t>(game));
+    autopilot.Reset();
+    while (!simulation.IsOver() && simulation.GetTicks() < max_ticks) {
+      autopilot.Steer(simulation.GetSnake(), simulation.GetFood(), simulation.GetObstacles());
+      simulation.Step();
+    }
+    if (!simulation.IsOver()) {
+      ++timed_out;
+    }
+    total_score += static_cast<uint64_t>(simulation.GetScore());
+    total_length += static_cast<uint64_t>(simulation.GetSnake().size);
+    total_ticks += simulation.GetTicks();
+    best_score = std::max(best_score, simulation.GetScore());
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  double plan_us = std::chrono::duration<double, std::micro>(autopilot.GetTotalPlanTime()).count();
+  uint64_t plans = autopilot.GetPlanCount();
+  std::cout << std::fixed << std::setprecision(1)
+            << "games/s: " << games / seconds << "  (" << seconds << " s total)\n"
+            << "score: avg " << static_cast<double>(total_score) / games << ", best " << best_score
+            << ", avg length " << static_cast<double>(total_length) / games << "\n"
+            << "ticks/s: " << total_ticks / seconds << "  (avg " << total_ticks / games
+            << " ticks per game, " << timed_out << " stopped at " << kMaxSimulatedSeconds << " s)\n"
+            << "plans: " << plans << ", avg " << std::setprecision(2)
+            << (plans == 0 ? 0.0 : plan_us / plans) << " us, "
+            << std::setprecision(1) << (seconds > 0 ? 100.0 * plan_us / 1e6 / seconds : 0.0)
+            << "% of run time, " << autopilot.GetFailedPlanCount() << " without a path" << std::endl;
+  return 0;
+}
@@ -0,0 +1,94 @@
+// Batch simulation: plays many autopiloted games in parallel on one board
+// configuration and prints the score, length and survival distributions,
+// for tuning the obstacle spawn curve. Also reports simulated ticks per
+// second, overall and per thread.
+//
+// Usage: BatchBenchmark [--games N] [--threads N] [--grid WxH]
+//                       [--spawn-rate R] [--spawn-increase R]
+//                       [--difficulty-interval N] [--max-seconds S] [--seed N]
+
+#include "batch_simulator.h"
+#include "board_config.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+  void PrintDistribution(const char *name, const BatchSimulator::Distribution &d) {
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+              << " mean " << std::setw(7) << d.mean << "  min " << std::setw(7) << d.min
+              << "  p10 " << std::setw(7) << d.p10 << "  p50 " << std::setw(7) << d.p50
+              << "  p90 " << std::setw(7) << d.p90 << "  max " << std::setw(7) << d.max << "\n";
+  }
+
+  void PrintUsage() {
+    std::cerr << "Usage: BatchBenchmark [--games N] [--threads N] [--grid WxH] [--spawn-rate R]"
+                 " [--spawn-increase R] [--difficulty-interval N] [--max-seconds S] [--seed N]\n";
+  }
+}
+
+int main(int argc, char *argv[]) {
+  BoardConfig config;
+  std::size_t games = 2000;
+  unsigned threads = 0;
+  float max_seconds = 300.0f;
+  uint32_t seed = 1;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      PrintUsage();
+      return 1;
+    }
+    const char *value = argv[++i];
+    if (arg == "--games") {
+      games = std::strtoul(value, nullptr, 10);
+    } else if (arg == "--threads") {
+      threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else if (arg == "--grid") {
+      unsigned long width = 0, height = 0;
+      if (std::sscanf(value, "%lux%lu", &width, &height) != 2 || width < 4 || height < 4) {
+        std::cerr << "Invalid --grid value, expected <width>x<height> of at least 4x4\n";
+        return 1;
+      }
+      config.gridWidth = width;
+      config.gridHeight = height;
+    } else if (arg == "--spawn-rate") {
+      config.baseSpawnRate = std::strtof(value, nullptr);
+    } else if (arg == "--spawn-increase") {
+      config.spawnRateIncrease = std::strtof(value, nullptr);
+    } else if (arg == "--difficulty-interval") {
+      config.difficultyInterval = std::max(1, std::atoi(value));
+    } else if (arg == "--max-seconds") {
+      max_seconds = std::strtof(value, nullptr);
+    } else if (arg == "--seed") {
+      seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    } else {
+      std::cerr << "Unknown argument: " << arg << "\n";
+      PrintUsage();
+      return 1;
+    }
+  }
+  games = std::max<std::size_t>(games, 1);
+
+  BatchSimulator batch(config, games, threads);
+  batch.SetMaxSimulatedSeconds(max_seconds);
+  std::cout << "Batch simulation: " << games << " games on " << batch.GetThreadCount()
+            << " thread(s), " << config.Describe() << std::endl;
+  batch.Run(seed);
+
+  double seconds = batch.GetRunSeconds();
+  double ticks_per_second = seconds > 0 ? batch.GetTotalTicks() / seconds : 0.0;
+  PrintDistribution("score", batch.GetScoreDistribution());
+  PrintDistribution("length", batch.GetLengthDistribution());
+  PrintDistribution("survival", batch.GetSurvivalDistribution());
+  std::cout << std::fixed << std::setprecision(1)
+            << batch.GetTimedOutCount() << " game(s) stopped at " << max_seconds << " s\n"
+            << "games/s: " << games / seconds << "  (" << seconds << " s total)\n"
+            << "ticks/s: " << ticks_per_second << "  (" << ticks_per_second / batch.GetThreadCount()
+            << " per thread, " << batch.GetTotalPlans() << " autopilot plans)" << std::endl;
+  return 0;
+}
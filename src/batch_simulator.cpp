@@ -0,0 +1,120 @@
+#include "batch_simulator.h"
+#include "autopilot.h"
+#include "noise_field.h"
+#include "simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+BatchSimulator::BatchSimulator(const BoardConfig& config, std::size_t game_count, unsigned thread_count)
+    : config(config), game_count(game_count), thread_count(thread_count) {
+  if (this->thread_count == 0) {
+    this->thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  // No point in threads without games
+  this->thread_count = static_cast<unsigned>(
+      std::max<std::size_t>(1, std::min<std::size_t>(this->thread_count, game_count)));
+}
+
+void BatchSimulator::Run(uint32_t seed) {
+  results.assign(game_count, BatchGameResult());
+  std::vector<ThreadTotals> totals(thread_count);
+
+  auto start = std::chrono::steady_clock::now();
+  auto noise_field = std::make_shared<const NoiseField>(seed ^ 0xC2B2AE35u, thread_count);
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (unsigned t = 0; t < thread_count; ++t) {
+    std::size_t first = game_count * t / thread_count;
+    std::size_t last = game_count * (t + 1) / thread_count;
+    threads.emplace_back(&BatchSimulator::RunRange, this, first, last, seed, noise_field, std::ref(totals[t]));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  run_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  total_ticks = 0;
+  total_plans = 0;
+  for (const auto& thread_totals : totals) {
+    total_ticks += thread_totals.ticks;
+    total_plans += thread_totals.plans;
+  }
+}
+
+void BatchSimulator::RunRange(std::size_t first, std::size_t last, uint32_t seed,
+                              std::shared_ptr<const NoiseField> noise_field, ThreadTotals& totals) {
+  if (first == last) {
+    return;
+  }
+  Simulation simulation(config, seed + static_cast<uint32_t>(first), std::move(noise_field));
+  Autopilot autopilot;
+  const uint64_t max_ticks = static_cast<uint64_t>(max_simulated_seconds * config.tickRate);
+
+  // Accumulate locally and publish once at the end
+  uint64_t ticks = 0;
+  for (std::size_t game = first; game < last; ++game) {
+    simulation.Reset(seed + static_cast<uint32_t>(game));
+    autopilot.Reset();
+    while (!simulation.IsOver() && simulation.GetTicks() < max_ticks) {
+      autopilot.Steer(simulation.GetSnake(), simulation.GetFood(), simulation.GetObstacles());
+      simulation.Step();
+    }
+
+    BatchGameResult& result = results[game];
+    result.score = simulation.GetScore();
+    result.length = static_cast<uint32_t>(simulation.GetSnake().size);
+    result.survival_seconds = simulation.GetElapsedSeconds();
+    result.timed_out = !simulation.IsOver();
+    ticks += simulation.GetTicks();
+  }
+  totals.ticks = ticks;
+  totals.plans = autopilot.GetPlanCount();
+}
+
+template<typename Measure>
+BatchSimulator::Distribution BatchSimulator::Summarize(Measure&& measure) const {
+  Distribution distribution;
+  if (results.empty()) {
+    return distribution;
+  }
+
+  std::vector<double> values;
+  values.reserve(results.size());
+  double sum = 0;
+  for (const auto& result : results) {
+    values.push_back(measure(result));
+    sum += values.back();
+  }
+  std::sort(values.begin(), values.end());
+
+  // Nearest-rank percentile
+  auto percentile = [&values](double p) {
+    std::size_t rank = static_cast<std::size_t>(p * (values.size() - 1) + 0.5);
+    return values[rank];
+  };
+  distribution.mean = sum / values.size();
+  distribution.min = values.front();
+  distribution.p10 = percentile(0.10);
+  distribution.p50 = percentile(0.50);
+  distribution.p90 = percentile(0.90);
+  distribution.max = values.back();
+  return distribution;
+}
+
+BatchSimulator::Distribution BatchSimulator::GetScoreDistribution() const {
+  return Summarize([](const BatchGameResult& result) { return static_cast<double>(result.score); });
+}
+
+BatchSimulator::Distribution BatchSimulator::GetLengthDistribution() const {
+  return Summarize([](const BatchGameResult& result) { return static_cast<double>(result.length); });
+}
+
+BatchSimulator::Distribution BatchSimulator::GetSurvivalDistribution() const {
+  return Summarize([](const BatchGameResult& result) { return static_cast<double>(result.survival_seconds); });
+}
+
+std::size_t BatchSimulator::GetTimedOutCount() const {
+  return static_cast<std::size_t>(std::count_if(results.begin(), results.end(),
+      [](const BatchGameResult& result) { return result.timed_out; }));
+}
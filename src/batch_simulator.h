@@ -0,0 +1,80 @@
+#ifndef BATCH_SIMULATOR_H
+#define BATCH_SIMULATOR_H
+
+#include "board_config.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class NoiseField;
+
+// Outcome of one simulated game
+struct BatchGameResult {
+  int score{0};
+  uint32_t length{0};         // Snake size when the game ended
+  float survival_seconds{0};  // Simulated time until death (or the cap)
+  bool timed_out{false};      // Still alive at the simulated time cap
+};
+
+// Plays many independent autopiloted games (see Simulation) on all cores,
+// for tuning the difficulty curve in BoardConfig. Each thread owns a
+// contiguous range of games, one Simulation and one Autopilot, and writes
+// only its own results, so threads share no locks or mutable state (the
+// NOISE_DRIFT flow field, built once per run, is shared read-only). Game i
+// is seeded with seed + i and plays the same on any thread count.
+class BatchSimulator {
+public:
+  // Percentiles of one measure over all games
+  struct Distribution {
+    double mean{0};
+    double min{0};
+    double p10{0};
+    double p50{0};
+    double p90{0};
+    double max{0};
+  };
+
+  // thread_count 0 uses every hardware thread
+  BatchSimulator(const BoardConfig& config, std::size_t game_count, unsigned thread_count = 0);
+
+  // Games still alive after this much simulated time are stopped
+  void SetMaxSimulatedSeconds(float seconds) { max_simulated_seconds = seconds; }
+
+  void Run(uint32_t seed);
+
+  const std::vector<BatchGameResult>& GetResults() const { return results; }
+  Distribution GetScoreDistribution() const;
+  Distribution GetLengthDistribution() const;
+  Distribution GetSurvivalDistribution() const;
+  std::size_t GetTimedOutCount() const;
+
+  unsigned GetThreadCount() const { return thread_count; }
+  uint64_t GetTotalTicks() const { return total_ticks; }
+  uint64_t GetTotalPlans() const { return total_plans; }
+  double GetRunSeconds() const { return run_seconds; }
+
+private:
+  BoardConfig config;
+  std::size_t game_count;
+  unsigned thread_count;
+  float max_simulated_seconds{300.0f};
+
+  std::vector<BatchGameResult> results; // Indexed by game
+  uint64_t total_ticks{0};
+  uint64_t total_plans{0};
+  double run_seconds{0};
+
+  // Counters of one thread, padded so neighbours do not share a cache line
+  struct alignas(64) ThreadTotals {
+    uint64_t ticks{0};
+    uint64_t plans{0};
+  };
+
+  void RunRange(std::size_t first, std::size_t last, uint32_t seed,
+                std::shared_ptr<const NoiseField> noise_field, ThreadTotals& totals);
+
+  template<typename Measure>
+  Distribution Summarize(Measure&& measure) const;
+};
+
+#endif
@@ -0,0 +1,118 @@
+// Bitplane encoder benchmark: encodes a 256x256 board holding a long snake
+// and a few hundred obstacles at several downsampling factors, checks each
+// encoding against a cell-by-cell reference and reports the time per board.
+//
+// Usage: BitplaneBenchmark [grid size] [encodes per factor] [seed]
+
+#include "bitplane_encoder.h"
+#include "obstacle_manager.h"
+#include "snake.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Reference: is any cell of the block at (x, y) set in `plane`?
+    bool ReferenceBit(const BitplaneEncoder& encoder, int plane, int x, int y,
+                      const Snake& snake, const SDL_Point& food, const std::vector<const Obstacle*>& obstacles,
+                      int grid) {
+        int f = encoder.GetDownsample();
+        for (int cy = y * f; cy < std::min(grid, (y + 1) * f); ++cy) {
+            for (int cx = x * f; cx < std::min(grid, (x + 1) * f); ++cx) {
+                switch (plane) {
+                case BitplaneEncoder::kHeadPlane:
+                    if (cx == static_cast<int>(snake.head_x) && cy == static_cast<int>(snake.head_y)) return true;
+                    break;
+                case BitplaneEncoder::kBodyPlane:
+                    for (const SDL_Point& cell : snake.body) {
+                        if (cell.x == cx && cell.y == cy) return true;
+                    }
+                    break;
+                case BitplaneEncoder::kFoodPlane:
+                    if (cx == food.x && cy == food.y) return true;
+                    break;
+                default:
+                    for (const Obstacle* obstacle : obstacles) {
+                        int obstacle_plane = BitplaneEncoder::kFixedObstaclePlane;
+                        if (obstacle->GetType() == ObstacleType::MOVING) {
+                            obstacle_plane = BitplaneEncoder::kFirstMovingPlane +
+                                static_cast<int>(static_cast<const MovingObstacle*>(obstacle)->GetPattern());
+                        }
+                        if (obstacle_plane == plane && obstacle->GetX() == cx && obstacle->GetY() == cy) return true;
+                    }
+                    break;
+                }
+            }
+        }
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int grid = argc > 1 ? std::max(8, std::atoi(argv[1])) : 256;
+    int encodes = argc > 2 ? std::max(1, std::atoi(argv[2])) : 2000;
+    uint32_t seed = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+
+    // A long snake from a random walk that grows every step
+    std::mt19937 rng(seed);
+    Snake snake(grid, grid);
+    snake.speed = 1.0f;
+    std::uniform_int_distribution<int> random_direction(0, 3);
+    for (int step = 0; step < grid * grid / 4; ++step) {
+        auto direction = static_cast<Snake::Direction>(random_direction(rng));
+        if (!snake.IsReverse(direction)) snake.direction = direction;
+        snake.GrowBody();
+        snake.Update();
+    }
+
+    ObstacleManager obstacles(grid, grid);
+    obstacles.SeedRandom(seed);
+    for (int i = 0; i < 300; ++i) {
+        obstacles.SpawnRandomObstacle();
+    }
+    std::uniform_int_distribution<int> random_cell(0, grid - 1);
+    SDL_Point food{random_cell(rng), random_cell(rng)};
+
+    std::vector<const Obstacle*> all_obstacles;
+    obstacles.QueryObstaclesInRect(SDL_Rect{0, 0, grid, grid}, all_obstacles);
+    std::cout << "Bitplane benchmark: " << grid << "x" << grid << " board, snake body "
+              << snake.body.size() << " cells, " << all_obstacles.size() << " obstacles, "
+              << BitplaneEncoder::kPlaneCount << " planes" << std::endl;
+
+    bool all_correct = true;
+    for (int factor : {1, 2, 4, 8}) {
+        BitplaneEncoder encoder(grid, grid, factor);
+        auto start = Clock::now();
+        for (int i = 0; i < encodes; ++i) {
+            encoder.Encode(snake, food, obstacles);
+        }
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / encodes;
+
+        // The body plane reference walks the whole body per cell, so check a
+        // sample of cells on large boards
+        bool correct = true;
+        int stride = std::max(1, encoder.GetWidth() / 64);
+        for (int plane = 0; plane < BitplaneEncoder::kPlaneCount && correct; ++plane) {
+            for (int y = 0; y < encoder.GetHeight() && correct; y += stride) {
+                for (int x = 0; x < encoder.GetWidth() && correct; x += stride) {
+                    correct = encoder.Test(plane, x, y) ==
+                              ReferenceBit(encoder, plane, x, y, snake, food, all_obstacles, grid);
+                }
+            }
+        }
+        all_correct = all_correct && correct;
+        std::cout << "downsample " << factor << ": " << std::setw(3) << encoder.GetWidth() << "x"
+                  << std::setw(3) << encoder.GetHeight() << ", " << std::setw(6)
+                  << encoder.GetData().size() * sizeof(uint64_t) << " bytes, " << std::fixed
+                  << std::setprecision(2) << std::setw(7) << us << " us per board, "
+                  << (correct ? "matches reference" : "MISMATCH") << std::endl;
+    }
+    return all_correct ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include "bitplane_encoder.h"
+#include "obstacle_manager.h"
+#include "snake.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // One bit per byte of `bytes`: bit i is set when byte i is nonzero
+    inline uint64_t NonzeroByteMask(uint64_t bytes) {
+        constexpr uint64_t kLow7 = 0x7F7F7F7F7F7F7F7FULL;
+        uint64_t high = (((bytes & kLow7) + kLow7) | bytes) & ~kLow7;
+        // Gather the eight high bits into the top byte
+        return ((high >> 7) * 0x0102040810204080ULL) >> 56;
+    }
+
+    // Bit i of the result is bit 2i | bit 2i + 1 of `word` (32 bits out)
+    inline uint64_t PoolPairs(uint64_t word) {
+        uint64_t x = (word | (word >> 1)) & 0x5555555555555555ULL;
+        x = (x | (x >> 1)) & 0x3333333333333333ULL;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+        return (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    }
+
+    std::size_t WordsFor(int bits) {
+        return (static_cast<std::size_t>(bits) + 63) / 64;
+    }
+}
+
+BitplaneEncoder::BitplaneEncoder(int grid_width, int grid_height, int downsample)
+    : width(std::max(grid_width, 1)), height(std::max(grid_height, 1)), factor(1) {
+    while (factor * 2 <= downsample) {
+        factor *= 2;
+    }
+    out_width = (width + factor - 1) / factor;
+    out_height = (height + factor - 1) / factor;
+    row_words = WordsFor(width);
+    out_row_words = WordsFor(out_width);
+    planes.assign(GetPlaneWords() * kPlaneCount, 0);
+    if (factor > 1) {
+        full.assign(row_words * height, 0);
+        pooled.assign(row_words, 0);
+    }
+}
+
+void BitplaneEncoder::Downsample(const uint64_t* source, uint64_t* out) {
+    for (int out_y = 0; out_y < out_height; ++out_y) {
+        // OR the block's rows together...
+        int first = out_y * factor;
+        int last = std::min(first + factor, height);
+        std::copy(source + first * row_words, source + (first + 1) * row_words, pooled.begin());
+        for (int y = first + 1; y < last; ++y) {
+            const uint64_t* row = source + y * row_words;
+            for (std::size_t w = 0; w < row_words; ++w) {
+                pooled[w] |= row[w];
+            }
+        }
+        // ...then halve the row's width once per factor of two
+        std::size_t words = row_words;
+        for (int step = factor; step > 1; step /= 2) {
+            std::size_t half = (words + 1) / 2;
+            for (std::size_t w = 0; w < half; ++w) {
+                uint64_t low = PoolPairs(pooled[2 * w]);
+                uint64_t high = 2 * w + 1 < words ? PoolPairs(pooled[2 * w + 1]) : 0;
+                pooled[w] = low | (high << 32);
+            }
+            words = half;
+        }
+        std::copy(pooled.begin(), pooled.begin() + out_row_words, out + out_y * out_row_words);
+    }
+}
+
+void BitplaneEncoder::PackOccupancy(const uint8_t* counts, uint64_t* plane) const {
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = counts + static_cast<std::size_t>(y) * width;
+        uint64_t* out = plane + y * row_words;
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            uint64_t bytes;
+            std::memcpy(&bytes, row + x, 8);
+            if (bytes != 0) {
+                out[x / 64] |= NonzeroByteMask(bytes) << (x % 64);
+            }
+        }
+        if (x < width) {
+            uint64_t bytes = 0; // Cells past the width read as empty
+            std::memcpy(&bytes, row + x, static_cast<std::size_t>(width - x));
+            out[x / 64] |= NonzeroByteMask(bytes) << (x % 64);
+        }
+    }
+}
+
+void BitplaneEncoder::SetCell(int plane, int x, int y) {
+    if (x >= 0 && x < width && y >= 0 && y < height) {
+        x /= factor;
+        y /= factor;
+        planes[plane * GetPlaneWords() + y * out_row_words + x / 64] |= uint64_t{1} << (x % 64);
+    }
+}
+
+void BitplaneEncoder::Encode(const Snake& snake, const SDL_Point& food, const ObstacleManager& obstacles) {
+    // Sparse planes: set the (downsampled) cell directly
+    std::fill(planes.begin(), planes.end(), 0);
+    SetCell(kHeadPlane, static_cast<int>(snake.head_x), static_cast<int>(snake.head_y));
+    SetCell(kFoodPlane, food.x, food.y);
+    board_obstacles.clear();
+    obstacles.QueryObstaclesInRect(SDL_Rect{0, 0, width, height}, board_obstacles);
+    for (const Obstacle* obstacle : board_obstacles) {
+        int plane = kFixedObstaclePlane;
+        if (obstacle->GetType() == ObstacleType::MOVING) {
+            plane = kFirstMovingPlane + static_cast<int>(static_cast<const MovingObstacle*>(obstacle)->GetPattern());
+        }
+        SetCell(plane, obstacle->GetX(), obstacle->GetY());
+    }
+
+    // The body is dense: pack its occupancy grid, then pool it
+    const OccupancyGrid& body = snake.GetBodyCells();
+    if (body.GetWidth() != width || body.GetHeight() != height) {
+        return;
+    }
+    if (factor == 1) {
+        PackOccupancy(body.GetData(), planes.data() + kBodyPlane * GetPlaneWords());
+    } else {
+        std::fill(full.begin(), full.end(), 0);
+        PackOccupancy(body.GetData(), full.data());
+        Downsample(full.data(), planes.data() + kBodyPlane * GetPlaneWords());
+    }
+}
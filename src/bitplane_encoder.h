@@ -0,0 +1,72 @@
+#ifndef BITPLANE_ENCODER_H
+#define BITPLANE_ENCODER_H
+
+#include "SDL.h"
+#include "moving_obstacle.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Obstacle;
+class ObstacleManager;
+class Snake;
+
+// Packs the board state into one bit-plane per feature: a row of a plane
+// is GetRowWords() 64-bit words, cell x in bit x % 64 of word x / 64, and
+// bits past the width are zero. Planes are stored back to back in one
+// buffer (see Plane).
+//
+// The body plane is built from the snake's occupancy grid eight cells per
+// word operation rather than by walking Snake::body; head, food and
+// obstacles (from the obstacle index) are single bits. With a downsampling
+// factor (a power of two) an output cell is set when any cell of its
+// factor x factor block is; the body plane is pooled with word-level ORs
+// and bit compaction.
+class BitplaneEncoder {
+public:
+    enum Plane {
+        kHeadPlane,
+        kBodyPlane,
+        kFoodPlane,
+        kFixedObstaclePlane,
+        kFirstMovingPlane, // One per MovementPattern, in enum order
+        kPlaneCount = kFirstMovingPlane + kMovementPatternCount
+    };
+
+    // `downsample` is rounded down to a power of two
+    BitplaneEncoder(int grid_width, int grid_height, int downsample = 1);
+
+    void Encode(const Snake& snake, const SDL_Point& food, const ObstacleManager& obstacles);
+
+    int GetWidth() const { return out_width; }   // Cells per row after downsampling
+    int GetHeight() const { return out_height; }
+    int GetDownsample() const { return factor; }
+    std::size_t GetRowWords() const { return out_row_words; }
+    std::size_t GetPlaneWords() const { return out_row_words * out_height; }
+
+    const uint64_t* GetPlane(int plane) const { return planes.data() + plane * GetPlaneWords(); }
+    const std::vector<uint64_t>& GetData() const { return planes; }
+    bool Test(int plane, int x, int y) const {
+        return (GetPlane(plane)[y * out_row_words + x / 64] >> (x % 64)) & 1u;
+    }
+
+private:
+    int width;
+    int height;
+    int factor;
+    int out_width;
+    int out_height;
+    std::size_t row_words;     // Full resolution
+    std::size_t out_row_words;
+
+    std::vector<uint64_t> full;   // Full-resolution body plane, used when downsampling
+    std::vector<uint64_t> pooled; // One pooled row
+    std::vector<uint64_t> planes; // Output
+    std::vector<const Obstacle*> board_obstacles; // Scratch
+
+    void SetCell(int plane, int x, int y); // x, y at full resolution
+    void PackOccupancy(const uint8_t* counts, uint64_t* plane) const;
+    void Downsample(const uint64_t* source, uint64_t* out);
+};
+
+#endif
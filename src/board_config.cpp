@@ -0,0 +1,66 @@
+#include "board_config.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+    constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+    uint64_t HashU32(uint64_t hash, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= kFnvPrime;
+        }
+        return hash;
+    }
+
+    uint32_t FloatBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+BoardConfig::BoardConfig(uint32_t width, uint32_t height)
+    : gridWidth(width), gridHeight(height) {}
+
+float BoardConfig::GetSpawnRate(int difficultyLevel) const {
+    return baseSpawnRate + difficultyLevel * spawnRateIncrease;
+}
+
+int BoardConfig::GetDifficultyLevel(int score) const {
+    return score / difficultyInterval + 1;
+}
+
+uint64_t BoardConfig::Fingerprint() const {
+    // Every field is hashed in a fixed order and byte order; add new fields
+    // at the end so existing fingerprints (and score files) stay valid
+    uint64_t hash = kFnvOffsetBasis;
+    hash = HashU32(hash, gridWidth);
+    hash = HashU32(hash, gridHeight);
+    hash = HashU32(hash, FloatBits(baseSpawnRate));
+    hash = HashU32(hash, FloatBits(spawnRateIncrease));
+    hash = HashU32(hash, static_cast<uint32_t>(difficultyInterval));
+    hash = HashU32(hash, static_cast<uint32_t>(tickRate));
+    return hash;
+}
+
+std::string BoardConfig::FingerprintHex() const {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(Fingerprint()));
+    return text;
+}
+
+std::string BoardConfig::Describe() const {
+    char text[96];
+    std::snprintf(text, sizeof(text), "%ux%u, %d Hz, spawn %.2g +%.2g per %d pts",
+                  gridWidth, gridHeight, tickRate, baseSpawnRate, spawnRateIncrease,
+                  difficultyInterval);
+    return text;
+}
+
+bool BoardConfig::operator==(const BoardConfig& other) const {
+    return gridWidth == other.gridWidth && gridHeight == other.gridHeight &&
+           baseSpawnRate == other.baseSpawnRate && spawnRateIncrease == other.spawnRateIncrease &&
+           difficultyInterval == other.difficultyInterval && tickRate == other.tickRate;
+}
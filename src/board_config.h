@@ -0,0 +1,37 @@
+#ifndef BOARD_CONFIG_H
+#define BOARD_CONFIG_H
+
+#include <cstdint>
+#include <string>
+
+// Settings that change how hard a game is. Scores are only comparable
+// between games played with the same configuration, so HighScoreManager
+// keeps a separate leaderboard per configuration fingerprint.
+struct BoardConfig {
+    uint32_t gridWidth{32};
+    uint32_t gridHeight{32};
+    float baseSpawnRate{0.3f};     // Obstacles per second before difficulty
+    float spawnRateIncrease{0.1f}; // Added per difficulty level
+    int difficultyInterval{5};     // Points per difficulty level
+    int tickRate{60};              // Fixed game updates per second
+
+    BoardConfig() = default;
+    BoardConfig(uint32_t width, uint32_t height);
+
+    float GetSpawnRate(int difficultyLevel) const;
+    int GetDifficultyLevel(int score) const;
+
+    // Stable across runs and platforms (FNV-1a over a fixed encoding)
+    uint64_t Fingerprint() const;
+    std::string FingerprintHex() const;
+
+    // Short human-readable summary, e.g. "32x32, 60 Hz, spawn 0.3 +0.1 per 5 pts"
+    std::string Describe() const;
+
+    bool IsDefault() const { return *this == BoardConfig(); }
+
+    bool operator==(const BoardConfig& other) const;
+    bool operator!=(const BoardConfig& other) const { return !(*this == other); }
+};
+
+#endif
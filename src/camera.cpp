@@ -0,0 +1,86 @@
+#include "camera.h"
+#include <algorithm>
+#include <cmath>
+
+Camera::Camera(std::size_t screen_width, std::size_t screen_height,
+               std::size_t grid_width, std::size_t grid_height)
+    : screen_width(static_cast<int>(screen_width)),
+      screen_height(static_cast<int>(screen_height)),
+      grid_width(static_cast<int>(grid_width)),
+      grid_height(static_cast<int>(grid_height)),
+      fit_cell_size(std::max(1, std::min(this->screen_width / this->grid_width,
+                                         this->screen_height / this->grid_height))),
+      cell_size(fit_cell_size),
+      target_x(grid_width / 2.0f),
+      target_y(grid_height / 2.0f) {
+    ResetZoom();
+}
+
+void Camera::Follow(float target_x, float target_y) {
+    this->target_x = target_x;
+    this->target_y = target_y;
+    UpdateOrigin();
+}
+
+void Camera::ZoomIn() {
+    for (int size : kZoomCellSizes) {
+        if (size > cell_size) {
+            cell_size = size;
+            break;
+        }
+    }
+    UpdateOrigin();
+}
+
+void Camera::ZoomOut() {
+    // Zooming out past the whole-board view would only add empty borders
+    int next = fit_cell_size;
+    for (int size : kZoomCellSizes) {
+        if (size < cell_size && size > next) {
+            next = size;
+        }
+    }
+    cell_size = std::min(cell_size, next);
+    UpdateOrigin();
+}
+
+void Camera::ResetZoom() {
+    // Show the whole board when cells stay legible, otherwise start zoomed in
+    cell_size = fit_cell_size >= kMinDefaultCellSize ? fit_cell_size : kDefaultCellSize;
+    UpdateOrigin();
+}
+
+SDL_Rect Camera::GetVisibleCells() const {
+    int x0 = std::max(0, -origin_x / cell_size);
+    int y0 = std::max(0, -origin_y / cell_size);
+    int x1 = std::min(grid_width, (screen_width - origin_x + cell_size - 1) / cell_size);
+    int y1 = std::min(grid_height, (screen_height - origin_y + cell_size - 1) / cell_size);
+    return {x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0)};
+}
+
+bool Camera::IsCellVisible(int x, int y) const {
+    SDL_Rect visible = GetVisibleCells();
+    return x >= visible.x && x < visible.x + visible.w &&
+           y >= visible.y && y < visible.y + visible.h;
+}
+
+SDL_Rect Camera::CellToScreen(int x, int y) const {
+    return {origin_x + x * cell_size, origin_y + y * cell_size, cell_size, cell_size};
+}
+
+void Camera::UpdateOrigin() {
+    origin_x = CenterAxis(target_x, grid_width, cell_size, screen_width);
+    origin_y = CenterAxis(target_y, grid_height, cell_size, screen_height);
+}
+
+int Camera::CenterAxis(float target, int cells, int cell_size, int screen) {
+    int board_pixels = cells * cell_size;
+    if (board_pixels <= screen) {
+        return (screen - board_pixels) / 2;
+    }
+
+    // Centre on the middle of the target cell, then keep the board edge
+    // from scrolling into view
+    int origin = static_cast<int>(std::lround(screen / 2.0f - (target + 0.5f) * cell_size));
+    return std::clamp(origin, screen - board_pixels, 0);
+}
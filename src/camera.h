@@ -0,0 +1,50 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "SDL.h"
+#include <array>
+#include <cstddef>
+
+// Maps grid cells to window pixels for a view that follows a target and can
+// be zoomed. The view never leaves the board; on boards smaller than the
+// view the board is centred instead.
+class Camera {
+public:
+    Camera(std::size_t screen_width, std::size_t screen_height,
+           std::size_t grid_width, std::size_t grid_height);
+
+    void Follow(float target_x, float target_y);
+
+    // Zoom is expressed as the on-screen size of one cell in pixels
+    void ZoomIn();
+    void ZoomOut();
+    void ResetZoom();
+    int GetCellSize() const { return cell_size; }
+
+    // Cells at least partially inside the window, clipped to the board
+    SDL_Rect GetVisibleCells() const;
+    bool IsCellVisible(int x, int y) const;
+    SDL_Rect CellToScreen(int x, int y) const;
+
+private:
+    const int screen_width;
+    const int screen_height;
+    const int grid_width;
+    const int grid_height;
+
+    int fit_cell_size;   // Largest cell size that shows the whole board
+    int cell_size;
+    int origin_x{0};     // Window pixel offset of the board origin
+    int origin_y{0};
+    float target_x{0.0f};
+    float target_y{0.0f};
+
+    static constexpr std::array<int, 10> kZoomCellSizes{1, 2, 4, 6, 8, 12, 16, 20, 32, 48};
+    static constexpr int kMinDefaultCellSize = 8;
+    static constexpr int kDefaultCellSize = 16;
+
+    void UpdateOrigin();
+    static int CenterAxis(float target, int cells, int cell_size, int screen);
+};
+
+#endif
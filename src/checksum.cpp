@@ -0,0 +1,72 @@
+#include "checksum.h"
+#include <array>
+
+namespace {
+
+using Crc32Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+// Slicing-by-8 tables: table[k][b] is the CRC of byte b followed by k zero
+// bytes, so eight input bytes can be folded in with eight lookups at once
+Crc32Tables BuildCrc32Tables() {
+    Crc32Tables tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        tables[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (std::size_t k = 1; k < 8; ++k) {
+            uint32_t previous = tables[k - 1][i];
+            tables[k][i] = tables[0][previous & 0xFF] ^ (previous >> 8);
+        }
+    }
+    return tables;
+}
+
+} // namespace
+
+namespace Checksum {
+
+uint32_t Crc32(const uint8_t* data, std::size_t length, uint32_t crc) {
+    static const Crc32Tables tables = BuildCrc32Tables();
+
+    crc = ~crc;
+    while (length >= 8) {
+        uint32_t low = crc ^ (static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+                              static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24);
+        crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^
+              tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+              tables[3][data[4]] ^ tables[2][data[5]] ^ tables[1][data[6]] ^ tables[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        crc = tables[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t Adler32(const uint8_t* data, std::size_t length, uint32_t adler) {
+    constexpr uint32_t kModAdler = 65521;
+    // Largest block that cannot overflow the 32-bit sums before reduction
+    constexpr std::size_t kMaxBlock = 5552;
+
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+
+    while (length > 0) {
+        std::size_t block = length < kMaxBlock ? length : kMaxBlock;
+        length -= block;
+        while (block-- > 0) {
+            a += *data++;
+            b += a;
+        }
+        a %= kModAdler;
+        b %= kModAdler;
+    }
+    return (b << 16) | a;
+}
+
+} // namespace Checksum
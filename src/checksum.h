@@ -0,0 +1,16 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Checksum {
+    // CRC-32 (IEEE 802.3, as used by PNG and zlib). Pass the previous result
+    // as `crc` to checksum data incrementally.
+    uint32_t Crc32(const uint8_t* data, std::size_t length, uint32_t crc = 0);
+
+    // Adler-32 as used by the zlib stream wrapper
+    uint32_t Adler32(const uint8_t* data, std::size_t length, uint32_t adler = 1);
+}
+
+#endif
@@ -50,8 +50,8 @@ bool CollisionDetector::CheckCollisionOptimized(const Snake& snake, const Obstac
     int head_x = static_cast<int>(snake.head_x);
     int head_y = static_cast<int>(snake.head_y);
 
-    // Quick bounds check (assuming grid dimensions are reasonable)
-    if (!IsInBounds(head_x, head_y, 32, 32)) { // Default grid size
+    // Quick bounds check against the actual board size
+    if (!IsInBounds(head_x, head_y, obstacleManager.GetGridWidth(), obstacleManager.GetGridHeight())) {
         return false;
     }
 
@@ -36,6 +36,33 @@ void Controller::HandleInput(const SDL_Event& event, Snake &snake) const {
   }
 }
 
+void Controller::HandleCameraInput(const SDL_Event& event, Camera &camera) const {
+  if (event.type == SDL_KEYDOWN) {
+    switch (event.key.keysym.sym) {
+    case SDLK_PLUS:
+    case SDLK_EQUALS:
+    case SDLK_KP_PLUS:
+      camera.ZoomIn();
+      break;
+
+    case SDLK_MINUS:
+    case SDLK_KP_MINUS:
+      camera.ZoomOut();
+      break;
+
+    case SDLK_0:
+      camera.ResetZoom();
+      break;
+    }
+  } else if (event.type == SDL_MOUSEWHEEL) {
+    if (event.wheel.y > 0) {
+      camera.ZoomIn();
+    } else if (event.wheel.y < 0) {
+      camera.ZoomOut();
+    }
+  }
+}
+
 void Controller::HandleTextInput(const SDL_Event& event, std::string& inputText, bool& inputComplete) const {
   if (event.type == SDL_KEYDOWN) {
     switch (event.key.keysym.sym) {
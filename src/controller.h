@@ -2,11 +2,13 @@
 #define CONTROLLER_H
 
 #include "snake.h"
+#include "camera.h"
 #include <string>
 
 class Controller {
 public:
   void HandleInput(const SDL_Event& event, Snake &snake) const;
+  void HandleCameraInput(const SDL_Event& event, Camera &camera) const;
   void HandleTextInput(const SDL_Event& event, std::string& inputText, bool& inputComplete) const;
   bool ValidatePlayerName(const std::string& name) const;
 
@@ -0,0 +1,95 @@
+// Training environment benchmark: steps a VectorEnv with random actions and
+// reports env-steps per second, finished episodes and heap allocations
+// made while stepping.
+//
+// Usage: EnvBenchmark [envs] [steps per env] [grid size] [seed]
+
+#include "vector_env.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+namespace {
+  std::atomic<uint64_t> allocation_count{0};
+}
+
+// Count every allocation in the process
+void *operator new(std::size_t size) {
+  ++allocation_count;
+  if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+int main(int argc, char *argv[]) {
+  VectorEnv::Options options;
+  options.envCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+  uint64_t steps = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+  uint32_t grid = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 32;
+  uint32_t seed = argc > 4 ? static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 1;
+  grid = std::max<uint32_t>(grid, 4);
+  options.board = BoardConfig(grid, grid);
+  steps = std::max<uint64_t>(steps, 1);
+
+  VectorEnv env(options);
+  env.Reset(seed);
+  std::vector<int32_t> actions(env.GetEnvCount());
+
+  // Random actions that mostly keep going straight, so episodes last
+  uint32_t state = seed * 2654435761u + 1;
+  auto next_random = [&state]() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  };
+
+  double reward_sum = 0;
+  uint64_t allocations_before = allocation_count;
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t step = 0; step < steps; ++step) {
+    for (auto &action : actions) {
+      uint32_t r = next_random();
+      action = (r & 31) == 0 ? static_cast<int32_t>((r >> 5) & 3) : -1;
+    }
+    env.Step(actions);
+    const float *rewards = env.GetRewards();
+    for (std::size_t i = 0; i < env.GetEnvCount(); ++i) {
+      reward_sum += rewards[i];
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  uint64_t allocations = allocation_count - allocations_before;
+
+  double total_steps = static_cast<double>(steps) * env.GetEnvCount();
+  double score_sum = 0;
+  for (std::size_t i = 0; i < env.GetEnvCount(); ++i) {
+    score_sum += env.GetLastEpisodeScore(i);
+  }
+  std::cout << "Env benchmark: " << env.GetEnvCount() << " games on " << options.board.Describe()
+            << ", " << steps << " steps each, random actions\n"
+            << std::fixed << std::setprecision(0)
+            << "env-steps/s: " << total_steps / seconds << "  (" << std::setprecision(2) << seconds
+            << " s total)\n"
+            << "episodes finished: " << env.GetFinishedEpisodes() << ", last-episode score avg "
+            << score_sum / env.GetEnvCount() << ", reward sum " << std::setprecision(0) << reward_sum
+            << "\n"
+            << "allocations while stepping: " << allocations << " (" << std::setprecision(3)
+            << allocations * 1000.0 / total_steps << " per 1000 env-steps)" << std::endl;
+  return 0;
+}
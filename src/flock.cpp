@@ -0,0 +1,262 @@
+#include "flock.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Largest velocity change per update, as a fraction of the agent's
+    // speed, so flocks turn smoothly instead of snapping
+    constexpr float kMaxTurn = 0.25f;
+
+    // Sets (out_x, out_y) to (x, y) rescaled to `length`; zero stays zero
+    void ScaleTo(float x, float y, float length, float& out_x, float& out_y) {
+        float magnitude_sq = x * x + y * y;
+        if (magnitude_sq <= 0.0f) {
+            out_x = 0.0f;
+            out_y = 0.0f;
+            return;
+        }
+        float scale = length / std::sqrt(magnitude_sq);
+        out_x = x * scale;
+        out_y = y * scale;
+    }
+}
+
+Flock::Flock(int grid_width, int grid_height, float neighbor_radius, float separation_radius)
+    : grid_width_(std::max(grid_width, 1)),
+      grid_height_(std::max(grid_height, 1)),
+      neighbor_radius_sq_(neighbor_radius * neighbor_radius),
+      separation_radius_sq_(separation_radius * separation_radius) {
+    // Whole buckets at least one radius wide, so neighbors are never more
+    // than one bucket away (across the wrapped edge too)
+    float radius = std::max(neighbor_radius, 1.0f);
+    buckets_x_ = std::max(1, static_cast<int>(grid_width_ / radius));
+    buckets_y_ = std::max(1, static_cast<int>(grid_height_ / radius));
+    bucket_scale_x_ = static_cast<float>(buckets_x_) / grid_width_;
+    bucket_scale_y_ = static_cast<float>(buckets_y_) / grid_height_;
+    bucket_start_.resize(static_cast<std::size_t>(buckets_x_) * buckets_y_ + 1);
+}
+
+void Flock::Clear() {
+    x_.clear();
+    y_.clear();
+    velocity_x_.clear();
+    velocity_y_.clear();
+    speed_.clear();
+}
+
+void Flock::Reserve(std::size_t count) {
+    for (auto* values : {&x_, &y_, &velocity_x_, &velocity_y_, &speed_,
+                         &sorted_x_, &sorted_y_, &sorted_velocity_x_, &sorted_velocity_y_}) {
+        values->reserve(count);
+    }
+    bucket_.reserve(count);
+    sorted_agent_.reserve(count);
+}
+
+std::size_t Flock::Add(float x, float y, float velocity_x, float velocity_y, float speed) {
+    x_.push_back(x);
+    y_.push_back(y);
+    velocity_x_.push_back(velocity_x);
+    velocity_y_.push_back(velocity_y);
+    speed_.push_back(speed);
+    return x_.size() - 1;
+}
+
+void Flock::BuildBuckets() {
+    const std::size_t count = x_.size();
+    bucket_.resize(count);
+    sorted_x_.resize(count);
+    sorted_y_.resize(count);
+    sorted_velocity_x_.resize(count);
+    sorted_velocity_y_.resize(count);
+    sorted_agent_.resize(count);
+
+    // Counting sort: bucket sizes, running totals (bucket ends), then
+    // placement from the back so each bucket keeps the agents' order and
+    // its entry ends up at the bucket's start
+    std::fill(bucket_start_.begin(), bucket_start_.end(), 0u);
+    for (std::size_t i = 0; i < count; ++i) {
+        int bx = std::min(std::max(static_cast<int>(x_[i] * bucket_scale_x_), 0), buckets_x_ - 1);
+        int by = std::min(std::max(static_cast<int>(y_[i] * bucket_scale_y_), 0), buckets_y_ - 1);
+        uint32_t bucket = static_cast<uint32_t>(by * buckets_x_ + bx);
+        bucket_[i] = bucket;
+        ++bucket_start_[bucket];
+    }
+    for (std::size_t b = 1; b < bucket_start_.size(); ++b) {
+        bucket_start_[b] += bucket_start_[b - 1];
+    }
+    for (std::size_t i = count; i-- > 0;) {
+        uint32_t slot = --bucket_start_[bucket_[i]];
+        sorted_x_[slot] = x_[i];
+        sorted_y_[slot] = y_[i];
+        sorted_velocity_x_[slot] = velocity_x_[i];
+        sorted_velocity_y_[slot] = velocity_y_[i];
+        sorted_agent_[slot] = static_cast<uint32_t>(i);
+    }
+    bucket_start_.back() = static_cast<uint32_t>(count);
+}
+
+int Flock::NeighborBuckets(int bucket, int count, int* out) const {
+    if (count == 1) {
+        out[0] = 0;
+        return 1;
+    }
+    if (count == 2) {
+        out[0] = bucket;
+        out[1] = 1 - bucket;
+        return 2;
+    }
+    out[0] = (bucket + count - 1) % count;
+    out[1] = bucket;
+    out[2] = (bucket + 1) % count;
+    return 3;
+}
+
+void Flock::Steer(const Weights& weights) {
+    neighbor_checks_ = 0;
+    if (x_.empty()) {
+        return;
+    }
+    BuildBuckets();
+
+    const float width = static_cast<float>(grid_width_);
+    const float height = static_cast<float>(grid_height_);
+    const float half_width = width * 0.5f;
+    const float half_height = height * 0.5f;
+    uint64_t checks = 0;
+
+    int columns[3];
+    int rows[3];
+    uint32_t range_begin[9];
+    uint32_t range_end[9];
+    for (int by = 0; by < buckets_y_; ++by) {
+        const int row_count = NeighborBuckets(by, buckets_y_, rows);
+        for (int bx = 0; bx < buckets_x_; ++bx) {
+            const int bucket = by * buckets_x_ + bx;
+            const uint32_t begin = bucket_start_[bucket];
+            const uint32_t end = bucket_start_[bucket + 1];
+            if (begin == end) {
+                continue;
+            }
+
+            // The neighborhood's agents: per neighbor row, the buckets
+            // around this column are contiguous unless they wrap
+            int column_count = NeighborBuckets(bx, buckets_x_, columns);
+            int range_count = 0;
+            for (int r = 0; r < row_count; ++r) {
+                const int row = rows[r] * buckets_x_;
+                if (bx > 0 && bx < buckets_x_ - 1) {
+                    range_begin[range_count] = bucket_start_[row + bx - 1];
+                    range_end[range_count] = bucket_start_[row + bx + 2];
+                    ++range_count;
+                    continue;
+                }
+                for (int c = 0; c < column_count; ++c) {
+                    range_begin[range_count] = bucket_start_[row + columns[c]];
+                    range_end[range_count] = bucket_start_[row + columns[c] + 1];
+                    ++range_count;
+                }
+            }
+
+            for (uint32_t self = begin; self < end; ++self) {
+                const float px = sorted_x_[self];
+                const float py = sorted_y_[self];
+                float separation_x = 0.0f, separation_y = 0.0f;
+                float alignment_x = 0.0f, alignment_y = 0.0f;
+                float cohesion_x = 0.0f, cohesion_y = 0.0f;
+                int neighbors = 0;
+
+                for (int r = 0; r < range_count && neighbors < max_neighbors_; ++r) {
+                    for (uint32_t other = range_begin[r]; other < range_end[r]; ++other) {
+                        if (other == self) {
+                            continue;
+                        }
+                        ++checks;
+                        // Shortest offset on the wrapping board
+                        float dx = sorted_x_[other] - px;
+                        float dy = sorted_y_[other] - py;
+                        if (dx > half_width) dx -= width;
+                        else if (dx < -half_width) dx += width;
+                        if (dy > half_height) dy -= height;
+                        else if (dy < -half_height) dy += height;
+                        float distance_sq = dx * dx + dy * dy;
+                        if (distance_sq >= neighbor_radius_sq_) {
+                            continue;
+                        }
+
+                        cohesion_x += dx;
+                        cohesion_y += dy;
+                        alignment_x += sorted_velocity_x_[other];
+                        alignment_y += sorted_velocity_y_[other];
+                        if (distance_sq < separation_radius_sq_ && distance_sq > 0.0f) {
+                            // Stronger the closer the neighbor
+                            separation_x -= dx / distance_sq;
+                            separation_y -= dy / distance_sq;
+                        }
+                        if (++neighbors == max_neighbors_) {
+                            break;
+                        }
+                    }
+                }
+
+                const uint32_t agent = sorted_agent_[self];
+                const float speed = speed_[agent];
+                float velocity_x = sorted_velocity_x_[self];
+                float velocity_y = sorted_velocity_y_[self];
+                if (neighbors > 0) {
+                    // Each rule asks for a velocity at full speed; steer by
+                    // the weighted differences from the current one
+                    float desired_x, desired_y;
+                    float steer_x = 0.0f, steer_y = 0.0f;
+                    ScaleTo(separation_x, separation_y, speed, desired_x, desired_y);
+                    if (desired_x != 0.0f || desired_y != 0.0f) {
+                        steer_x += weights.separation * (desired_x - velocity_x);
+                        steer_y += weights.separation * (desired_y - velocity_y);
+                    }
+                    ScaleTo(alignment_x, alignment_y, speed, desired_x, desired_y);
+                    steer_x += weights.alignment * (desired_x - velocity_x);
+                    steer_y += weights.alignment * (desired_y - velocity_y);
+                    ScaleTo(cohesion_x, cohesion_y, speed, desired_x, desired_y);
+                    steer_x += weights.cohesion * (desired_x - velocity_x);
+                    steer_y += weights.cohesion * (desired_y - velocity_y);
+
+                    float steer_sq = steer_x * steer_x + steer_y * steer_y;
+                    float max_steer = kMaxTurn * speed;
+                    if (steer_sq > max_steer * max_steer) {
+                        ScaleTo(steer_x, steer_y, max_steer, steer_x, steer_y);
+                    }
+                    velocity_x += steer_x;
+                    velocity_y += steer_y;
+                }
+
+                // Constant speed; an agent that has stopped keeps still
+                float new_x, new_y;
+                ScaleTo(velocity_x, velocity_y, speed, new_x, new_y);
+                velocity_x_[agent] = new_x;
+                velocity_y_[agent] = new_y;
+            }
+        }
+    }
+    neighbor_checks_ = checks;
+}
+
+void Flock::Integrate() {
+    const float width = static_cast<float>(grid_width_);
+    const float height = static_cast<float>(grid_height_);
+    const std::size_t count = x_.size();
+    float* x = x_.data();
+    float* y = y_.data();
+    const float* velocity_x = velocity_x_.data();
+    const float* velocity_y = velocity_y_.data();
+    // Speeds stay well under a cell, so one correction wraps any step
+    for (std::size_t i = 0; i < count; ++i) {
+        float new_x = x[i] + velocity_x[i];
+        float new_y = y[i] + velocity_y[i];
+        new_x += new_x < 0.0f ? width : 0.0f;
+        new_x -= new_x >= width ? width : 0.0f;
+        new_y += new_y < 0.0f ? height : 0.0f;
+        new_y -= new_y >= height ? height : 0.0f;
+        x[i] = new_x;
+        y[i] = new_y;
+    }
+}
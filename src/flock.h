@@ -0,0 +1,91 @@
+#ifndef FLOCK_H
+#define FLOCK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Boids steering (separation, alignment, cohesion) for many agents on a
+// wrapping grid, behind the FLOCKING movement pattern.
+//
+// Agents are stored as structure-of-arrays (x, y, velocity x, velocity y,
+// speed), refilled by the caller each tick. Steer buckets them with a
+// counting sort into a uniform grid whose buckets are at least one
+// neighbor radius wide, so each agent only looks at the 3x3 buckets around
+// its own and the whole update is O(n) for a bounded density. Neighbors are
+// read from bucket-sorted copies of the arrays, so a bucket's agents, and
+// the three buckets side by side in a row, are contiguous in memory.
+// Nothing is allocated once the arrays have grown to the flock's size.
+class Flock {
+public:
+    struct Weights {
+        float separation{1.5f};
+        float alignment{1.0f};
+        float cohesion{0.6f};
+    };
+
+    // `neighbor_radius` and `separation_radius` are in cells
+    Flock(int grid_width, int grid_height, float neighbor_radius = 3.0f, float separation_radius = 1.0f);
+
+    void Clear(); // Keeps capacity
+    void Reserve(std::size_t count);
+
+    // `speed` is in cells per update; Steer keeps each agent at its speed
+    std::size_t Add(float x, float y, float velocity_x, float velocity_y, float speed);
+    std::size_t GetSize() const { return x_.size(); }
+
+    // Replaces every velocity by the steered one
+    void Steer(const Weights& weights);
+
+    // Moves every agent by its velocity, wrapping at the board edges; one
+    // pass over the arrays, so callers need not move agents one by one
+    void Integrate();
+
+    float GetX(std::size_t agent) const { return x_[agent]; }
+    float GetY(std::size_t agent) const { return y_[agent]; }
+    float GetVelocityX(std::size_t agent) const { return velocity_x_[agent]; }
+    float GetVelocityY(std::size_t agent) const { return velocity_y_[agent]; }
+
+    // Neighbors looked at per agent are capped, so a tight cluster costs a
+    // bounded amount per agent
+    void SetMaxNeighbors(int count) { max_neighbors_ = count > 0 ? count : 1; }
+
+    // Statistics for the last Steer
+    uint64_t GetNeighborChecks() const { return neighbor_checks_; }
+
+private:
+    int grid_width_;
+    int grid_height_;
+    float neighbor_radius_sq_;
+    float separation_radius_sq_;
+    int max_neighbors_{32};
+
+    // Bucket grid: every bucket spans at least neighbor_radius cells
+    int buckets_x_;
+    int buckets_y_;
+    float bucket_scale_x_; // Buckets per cell
+    float bucket_scale_y_;
+    std::vector<uint32_t> bucket_start_; // Prefix sums, buckets_x_ * buckets_y_ + 1 entries
+
+    // Agents, in the order they were added
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> velocity_x_;
+    std::vector<float> velocity_y_;
+    std::vector<float> speed_;
+    std::vector<uint32_t> bucket_;
+
+    // The same agents sorted by bucket
+    std::vector<float> sorted_x_;
+    std::vector<float> sorted_y_;
+    std::vector<float> sorted_velocity_x_;
+    std::vector<float> sorted_velocity_y_;
+    std::vector<uint32_t> sorted_agent_;
+
+    uint64_t neighbor_checks_{0};
+
+    void BuildBuckets();
+    int NeighborBuckets(int bucket, int count, int* out) const; // Distinct wrapped neighbors along one axis
+};
+
+#endif
@@ -0,0 +1,145 @@
+// Flocking benchmark: fills a board with FLOCKING obstacles and times
+// ObstacleManager's steering (bucket build plus neighbor rules) and the whole
+// movement update against a 60 Hz frame, at a sparse and a dense population.
+// Alignment is the length of the mean unit heading: 0 for random headings,
+// 1 for one shared heading. Over the whole board it stays near 0 while many
+// separate flocks form, so it is also given per 4x4-cell patch (averaged
+// over obstacles in patches of two or more), where random headings score
+// about 1/sqrt(obstacles per patch) and local flocks push it toward 1.
+//
+// Usage: FlockBenchmark [obstacles] [updates] [seed]
+
+#include "obstacle_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr double kFrameBudgetMs = 1000.0 / 60.0;
+
+    // Length of the mean unit heading over every FLOCKING obstacle
+    double Alignment(const ObstacleManager& manager, std::vector<ObstacleManager::ObstacleState>& states) {
+        manager.CaptureObstacles(states);
+        double sum_x = 0.0, sum_y = 0.0;
+        for (const auto& state : states) {
+            double length = std::hypot(state.velocity_x, state.velocity_y);
+            if (length > 0.0) {
+                sum_x += state.velocity_x / length;
+                sum_y += state.velocity_y / length;
+            }
+        }
+        return states.empty() ? 0.0 : std::hypot(sum_x, sum_y) / states.size();
+    }
+
+    // The same per 4x4-cell patch, from the last CaptureObstacles in `states`
+    double LocalAlignment(const std::vector<ObstacleManager::ObstacleState>& states, int grid) {
+        constexpr int kPatch = 4;
+        const int patches = (grid + kPatch - 1) / kPatch;
+        std::vector<double> sum_x(static_cast<std::size_t>(patches) * patches, 0.0);
+        std::vector<double> sum_y(sum_x.size(), 0.0);
+        std::vector<int> counts(sum_x.size(), 0);
+        for (const auto& state : states) {
+            double length = std::hypot(state.velocity_x, state.velocity_y);
+            if (length > 0.0) {
+                std::size_t patch = static_cast<std::size_t>(state.y / kPatch) * patches + state.x / kPatch;
+                sum_x[patch] += state.velocity_x / length;
+                sum_y[patch] += state.velocity_y / length;
+                ++counts[patch];
+            }
+        }
+        double weighted = 0.0;
+        long long members = 0;
+        for (std::size_t patch = 0; patch < counts.size(); ++patch) {
+            if (counts[patch] >= 2) {
+                weighted += std::hypot(sum_x[patch], sum_y[patch]); // Mean length times count
+                members += counts[patch];
+            }
+        }
+        return members > 0 ? weighted / members : 0.0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50000;
+    int updates = argc > 2 ? std::max(1, std::atoi(argv[2])) : 120;
+    uint32_t seed = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+    constexpr float kSpeed = 0.2f;
+
+    std::cout << "Flock benchmark: " << count << " flocking obstacles, " << updates
+              << " updates per board, budget " << std::fixed << std::setprecision(1)
+              << kFrameBudgetMs << " ms per frame" << std::endl;
+
+    // Sparse: about 5 cells per obstacle; dense: about 1.3
+    for (int grid : {1024, 256}) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> random_position(0.0f, static_cast<float>(grid));
+        std::uniform_real_distribution<float> random_angle(0.0f, 2.0f * static_cast<float>(M_PI));
+        std::vector<ObstacleManager::ObstacleState> states(count);
+        for (auto& state : states) {
+            state.exact_x = random_position(rng);
+            state.exact_y = random_position(rng);
+            state.x = std::min(static_cast<int>(state.exact_x), grid - 1);
+            state.y = std::min(static_cast<int>(state.exact_y), grid - 1);
+            state.type = ObstacleType::MOVING;
+            state.pattern = MovementPattern::FLOCKING;
+            state.direction = 1;
+            state.movement_counter = 0.0f;
+            state.speed = kSpeed;
+            float angle = random_angle(rng);
+            state.velocity_x = kSpeed * std::cos(angle);
+            state.velocity_y = kSpeed * std::sin(angle);
+            state.lifetime = 1e6f;
+        }
+
+        ObstacleManager manager(grid, grid);
+        manager.RestoreObstacles(states);
+        double alignment_before = Alignment(manager, states);
+        double local_before = LocalAlignment(states, grid);
+
+        // The steering on its own, through a Flock sized like the manager's
+        Flock flock(grid, grid);
+        flock.Reserve(states.size());
+        double steer_ms = 0.0;
+        uint64_t checks = 0;
+        for (int i = 0; i < updates; ++i) {
+            flock.Clear();
+            for (const auto& state : states) {
+                flock.Add(state.exact_x, state.exact_y, state.velocity_x, state.velocity_y, state.speed);
+            }
+            auto start = Clock::now();
+            flock.Steer(Flock::Weights{});
+            steer_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            checks += flock.GetNeighborChecks();
+        }
+
+        // The full movement update: gather, steer, integrate in bulk, write
+        // back and reindex the obstacles that changed cell
+        double update_ms = 0.0;
+        double worst_ms = 0.0;
+        for (int i = 0; i < updates; ++i) {
+            auto start = Clock::now();
+            manager.UpdateObstacleMovement();
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            update_ms += ms;
+            worst_ms = std::max(worst_ms, ms);
+        }
+        double alignment_after = Alignment(manager, states);
+        double local_after = LocalAlignment(states, grid);
+
+        std::cout << grid << "x" << grid << ": steer " << std::setprecision(2) << steer_ms / updates
+                  << " ms, movement update " << update_ms / updates << " ms (worst " << worst_ms
+                  << " ms, " << std::setprecision(0) << 100.0 * update_ms / updates / kFrameBudgetMs
+                  << "% of a frame), " << std::setprecision(1)
+                  << static_cast<double>(checks) / updates / count << " neighbor checks per obstacle, alignment "
+                  << std::setprecision(2) << alignment_before << " -> " << alignment_after << " (per patch "
+                  << local_before << " -> " << local_after << ")" << std::endl;
+    }
+    return 0;
+}
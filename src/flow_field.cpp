@@ -0,0 +1,270 @@
+#include "flow_field.h"
+#include <algorithm>
+
+FlowField::FlowField(int grid_width, int grid_height) {
+    Resize(grid_width, grid_height);
+}
+
+void FlowField::Resize(int grid_width, int grid_height) {
+    width = std::max(grid_width, 1);
+    height = std::max(grid_height, 1);
+    std::size_t count = static_cast<std::size_t>(width) * height;
+    distance.assign(count, kUnreachable);
+    block_count.assign(count, 0);
+    in_invalidated.assign(count, 0);
+    if (queue.capacity() < count) {
+        queue.reserve(count);
+        invalidated.reserve(count);
+        seeds.reserve(count);
+    }
+    has_target = false;
+    last_update_cells = 0;
+}
+
+void FlowField::SetWrapping(bool wrap) {
+    if (wrapping != wrap) {
+        wrapping = wrap;
+        Rebuild();
+    }
+}
+
+void FlowField::SetTarget(const SDL_Point& new_target) {
+    if (new_target.x < 0 || new_target.x >= width || new_target.y < 0 || new_target.y >= height) {
+        has_target = false;
+        Rebuild();
+        return;
+    }
+    if (has_target && new_target.x == target.x && new_target.y == target.y) {
+        return;
+    }
+    target = new_target;
+    has_target = true;
+    Rebuild();
+}
+
+void FlowField::Block(int x, int y) {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return;
+    }
+    int32_t cell = y * width + x;
+    if (block_count[cell]++ == 0) {
+        RepairAfterBlock(cell);
+    }
+}
+
+void FlowField::Unblock(int x, int y) {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return;
+    }
+    int32_t cell = y * width + x;
+    if (block_count[cell] > 0 && --block_count[cell] == 0) {
+        RepairAfterUnblock(cell);
+    }
+}
+
+void FlowField::ClearBlocked() {
+    std::fill(block_count.begin(), block_count.end(), 0);
+    Rebuild();
+}
+
+bool FlowField::IsBlocked(int x, int y) const {
+    return x >= 0 && x < width && y >= 0 && y < height &&
+           block_count[static_cast<std::size_t>(y) * width + x] != 0;
+}
+
+uint32_t FlowField::GetDistance(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return kUnreachable;
+    }
+    return distance[static_cast<std::size_t>(y) * width + x];
+}
+
+bool FlowField::GetNextStep(int x, int y, SDL_Point& next) const {
+    uint32_t here = GetDistance(x, y);
+    if (here == kUnreachable || here == 0) {
+        return false;
+    }
+    int32_t neighbours[4];
+    int count = Neighbours(y * width + x, neighbours);
+    for (int i = 0; i < count; ++i) {
+        if (distance[neighbours[i]] == here - 1) {
+            next.x = neighbours[i] % width;
+            next.y = neighbours[i] / width;
+            return true;
+        }
+    }
+    return false; // Not reached: a finite distance always has a predecessor
+}
+
+int FlowField::Neighbours(int32_t cell, int32_t (&out)[4]) const {
+    int x = cell % width;
+    int y = cell / width;
+    int count = 0;
+    if (wrapping) {
+        out[count++] = y * width + (x + 1 == width ? 0 : x + 1);
+        out[count++] = y * width + (x == 0 ? width - 1 : x - 1);
+        out[count++] = (y + 1 == height ? 0 : y + 1) * width + x;
+        out[count++] = (y == 0 ? height - 1 : y - 1) * width + x;
+        return count;
+    }
+    if (x + 1 < width) out[count++] = cell + 1;
+    if (x > 0) out[count++] = cell - 1;
+    if (y + 1 < height) out[count++] = cell + width;
+    if (y > 0) out[count++] = cell - width;
+    return count;
+}
+
+void FlowField::Rebuild() {
+    std::fill(distance.begin(), distance.end(), kUnreachable);
+    last_update_cells = 0;
+    if (!has_target) {
+        return;
+    }
+    int32_t cell = target.y * width + target.x;
+    if (block_count[cell] != 0) {
+        return;
+    }
+    distance[cell] = 0;
+    queue.clear();
+    queue.push_back(cell);
+    seeds.clear();
+    Propagate(0);
+}
+
+// Settles cells in order of distance, taking the smaller of the next seed
+// (sorted, distances already written) and the FIFO queue; with unit costs
+// this is Dijkstra without a heap
+void FlowField::Propagate(std::size_t seed_count) {
+    std::size_t head = 0;
+    std::size_t next_seed = 0;
+    int32_t neighbours[4];
+    last_update_cells += queue.size() + seed_count;
+
+    while (head < queue.size() || next_seed < seed_count) {
+        int32_t cell;
+        if (next_seed < seed_count &&
+            (head == queue.size() || seeds[next_seed].first <= distance[queue[head]])) {
+            const auto& seed = seeds[next_seed++];
+            if (seed.first != distance[seed.second]) {
+                continue; // Improved since, and queued with its new distance
+            }
+            cell = seed.second;
+        } else {
+            cell = queue[head++];
+        }
+
+        uint32_t next_distance = distance[cell] + 1;
+        int count = Neighbours(cell, neighbours);
+        for (int i = 0; i < count; ++i) {
+            int32_t neighbour = neighbours[i];
+            if (block_count[neighbour] == 0 && distance[neighbour] > next_distance) {
+                distance[neighbour] = next_distance;
+                queue.push_back(neighbour);
+                ++last_update_cells;
+            }
+        }
+    }
+    queue.clear();
+}
+
+void FlowField::RepairAfterUnblock(int32_t cell) {
+    last_update_cells = 0;
+    if (!has_target) {
+        return;
+    }
+    uint32_t best = kUnreachable;
+    if (cell == target.y * width + target.x) {
+        best = 0;
+    } else {
+        int32_t neighbours[4];
+        int count = Neighbours(cell, neighbours);
+        for (int i = 0; i < count; ++i) {
+            if (distance[neighbours[i]] != kUnreachable) {
+                best = std::min(best, distance[neighbours[i]] + 1);
+            }
+        }
+    }
+    if (best == kUnreachable) {
+        return; // Still cut off; so is everything behind it
+    }
+    distance[cell] = best;
+    queue.clear();
+    queue.push_back(cell);
+    seeds.clear();
+    Propagate(0);
+}
+
+void FlowField::RepairAfterBlock(int32_t cell) {
+    last_update_cells = 0;
+    uint32_t old_distance = distance[cell];
+    distance[cell] = kUnreachable;
+    if (old_distance == kUnreachable) {
+        return;
+    }
+    if (old_distance == 0) {
+        Rebuild(); // The target itself: nothing can reach it
+        return;
+    }
+
+    // Phase 1: walk outward level by level from the blocked cell and
+    // invalidate every cell left without a neighbour one step closer.
+    // Levels are processed in order, so a cell is checked only after every
+    // candidate predecessor has been decided.
+    int32_t neighbours[4];
+    queue.clear();
+    invalidated.clear();
+    int count = Neighbours(cell, neighbours);
+    for (int i = 0; i < count; ++i) {
+        if (distance[neighbours[i]] == old_distance + 1) {
+            queue.push_back(neighbours[i]);
+        }
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int32_t current = queue[head];
+        if (in_invalidated[current]) {
+            continue;
+        }
+        uint32_t here = distance[current];
+        bool supported = false;
+        count = Neighbours(current, neighbours);
+        for (int i = 0; i < count && !supported; ++i) {
+            supported = !in_invalidated[neighbours[i]] && distance[neighbours[i]] == here - 1;
+        }
+        if (supported) {
+            continue;
+        }
+        in_invalidated[current] = 1;
+        invalidated.push_back(current);
+        for (int i = 0; i < count; ++i) {
+            if (!in_invalidated[neighbours[i]] && distance[neighbours[i]] == here + 1) {
+                queue.push_back(neighbours[i]);
+            }
+        }
+    }
+    queue.clear();
+
+    // Phase 2: reseed the invalidated region from its valid border and
+    // propagate inward
+    for (int32_t current : invalidated) {
+        distance[current] = kUnreachable;
+    }
+    seeds.clear();
+    for (int32_t current : invalidated) {
+        in_invalidated[current] = 0;
+        uint32_t best = kUnreachable;
+        count = Neighbours(current, neighbours);
+        for (int i = 0; i < count; ++i) {
+            if (distance[neighbours[i]] != kUnreachable) {
+                best = std::min(best, distance[neighbours[i]] + 1);
+            }
+        }
+        if (best != kUnreachable) {
+            seeds.emplace_back(best, current);
+        }
+    }
+    std::sort(seeds.begin(), seeds.end());
+    for (const auto& seed : seeds) {
+        distance[seed.second] = std::min(distance[seed.second], seed.first);
+    }
+    Propagate(seeds.size());
+}
@@ -0,0 +1,82 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "SDL.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Distance map toward one target cell (the food) on a 4-connected grid,
+// shared by every agent heading for it: one BFS per target change, then
+// each agent's next step is an O(1) lookup instead of its own A* search.
+//
+// Blocking or unblocking a cell repairs the map incrementally. Unblocking
+// propagates the shorter distances outward from the cell; blocking first
+// invalidates the cells whose every shortest path ran through it, then
+// refills only those from their still-valid neighbours. Both touch the
+// affected region only, and no memory is allocated after the first update
+// at a given grid size.
+class FlowField {
+public:
+    static constexpr uint32_t kUnreachable = UINT32_MAX;
+
+    FlowField(int grid_width, int grid_height);
+
+    // Clears blocked cells and the target; reallocates only when the grid grows
+    void Resize(int grid_width, int grid_height);
+
+    // When set, steps may leave one edge and enter at the opposite one, as
+    // the snake does. Rebuilds the map.
+    void SetWrapping(bool wrap);
+
+    // Full BFS from `target` (skipped if it is already the target)
+    void SetTarget(const SDL_Point& target);
+    const SDL_Point& GetTarget() const { return target; }
+    bool HasTarget() const { return has_target; }
+
+    // Blocks are counted, so overlapping obstacles each add and remove their
+    // own; the map changes only when a cell's count goes 0 -> 1 or 1 -> 0
+    void Block(int x, int y);
+    void Unblock(int x, int y);
+    void ClearBlocked(); // Rebuilds the map
+    bool IsBlocked(int x, int y) const;
+
+    // Steps from (x, y) to the target, kUnreachable if there is no way
+    uint32_t GetDistance(int x, int y) const;
+
+    // Neighbour of (x, y) one step closer to the target; false at the target,
+    // on a blocked cell or when the target cannot be reached
+    bool GetNextStep(int x, int y, SDL_Point& next) const;
+
+    // Cells whose distance was written by the last update (BFS or repair)
+    std::size_t GetLastUpdateCells() const { return last_update_cells; }
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+private:
+    int width{0};
+    int height{0};
+    bool wrapping{false};
+    bool has_target{false};
+    SDL_Point target{0, 0};
+
+    std::vector<uint32_t> distance;
+    std::vector<uint16_t> block_count;
+
+    // Scratch buffers reused by every update
+    std::vector<int32_t> queue;
+    std::vector<int32_t> invalidated;
+    std::vector<uint8_t> in_invalidated;
+    std::vector<std::pair<uint32_t, int32_t>> seeds; // (distance, cell)
+
+    std::size_t last_update_cells{0};
+
+    int Neighbours(int32_t cell, int32_t (&out)[4]) const;
+    void Rebuild();
+    void Propagate(std::size_t seed_count); // Unit-cost relaxation from the queue and seeds
+    void RepairAfterUnblock(int32_t cell);
+    void RepairAfterBlock(int32_t cell);
+};
+
+#endif
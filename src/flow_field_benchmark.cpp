@@ -0,0 +1,150 @@
+// Flow field benchmark: on random boards with 20% of cells blocked, times
+// the full BFS, incremental repairs as obstacles appear and expire, and
+// next-step lookups for many agents, against one A* search per agent.
+// Every repaired map is compared with a full rebuild.
+//
+// Usage: FlowFieldBenchmark [agents] [obstacle changes per board] [seed]
+
+#include "flow_field.h"
+#include "pathfinding_engine.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double MicrosecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    SDL_Point RandomCell(int size, std::mt19937& rng) {
+        std::uniform_int_distribution<int> coordinate(0, size - 1);
+        return SDL_Point{coordinate(rng), coordinate(rng)};
+    }
+
+    bool SameDistances(const FlowField& repaired, const FlowField& rebuilt) {
+        for (int y = 0; y < repaired.GetHeight(); ++y) {
+            for (int x = 0; x < repaired.GetWidth(); ++x) {
+                if (repaired.GetDistance(x, y) != rebuilt.GetDistance(x, y)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool BenchmarkBoard(int size, std::size_t agents, std::size_t changes, uint32_t seed) {
+        std::mt19937 rng(seed);
+        FlowField field(size, size);
+        field.SetWrapping(true);
+        std::vector<SDL_Point> blocked_cells;
+        std::bernoulli_distribution blocked(0.2);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (blocked(rng)) {
+                    blocked_cells.push_back(SDL_Point{x, y});
+                }
+            }
+        }
+        for (const auto& cell : blocked_cells) {
+            field.Block(cell.x, cell.y);
+        }
+
+        SDL_Point target = RandomCell(size, rng);
+        while (field.IsBlocked(target.x, target.y)) {
+            target = RandomCell(size, rng);
+        }
+        auto start = Clock::now();
+        field.SetTarget(target);
+        double bfs_us = MicrosecondsSince(start);
+
+        // Obstacles appear and expire one at a time
+        double repair_us = 0;
+        std::size_t repair_cells = 0;
+        bool correct = true;
+        std::size_t check_every = std::max<std::size_t>(1, changes / 20);
+        for (std::size_t i = 0; i < changes; ++i) {
+            std::size_t victim = std::uniform_int_distribution<std::size_t>(0, blocked_cells.size() - 1)(rng);
+            SDL_Point added = RandomCell(size, rng);
+            start = Clock::now();
+            field.Unblock(blocked_cells[victim].x, blocked_cells[victim].y);
+            repair_cells += field.GetLastUpdateCells();
+            field.Block(added.x, added.y);
+            repair_cells += field.GetLastUpdateCells();
+            repair_us += MicrosecondsSince(start);
+            blocked_cells[victim] = added;
+
+            if (i % check_every == 0 || i + 1 == changes) {
+                FlowField rebuilt(size, size);
+                rebuilt.SetWrapping(true);
+                for (const auto& cell : blocked_cells) {
+                    rebuilt.Block(cell.x, cell.y);
+                }
+                rebuilt.SetTarget(field.GetTarget());
+                correct = correct && SameDistances(field, rebuilt);
+            }
+        }
+
+        // Every agent takes its next step from the shared field
+        std::vector<SDL_Point> positions;
+        for (std::size_t i = 0; i < agents; ++i) {
+            positions.push_back(RandomCell(size, rng));
+        }
+        std::size_t moved = 0;
+        start = Clock::now();
+        for (const auto& position : positions) {
+            SDL_Point next;
+            moved += field.GetNextStep(position.x, position.y, next) ? 1 : 0;
+        }
+        double lookup_us = MicrosecondsSince(start);
+
+        // The same agents with one A* search each (capped on large boards)
+        PathfindingEngine engine(size, size);
+        engine.SetWrapping(true);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (field.IsBlocked(x, y)) {
+                    engine.SetBlocked(x, y);
+                }
+            }
+        }
+        std::size_t searched = std::min<std::size_t>(agents, size >= 1024 ? 20 : 200);
+        std::vector<SDL_Point> path;
+        start = Clock::now();
+        for (std::size_t i = 0; i < searched; ++i) {
+            engine.FindPath(positions[i], field.GetTarget(), path);
+        }
+        double astar_us = MicrosecondsSince(start) / searched * agents;
+
+        std::cout << std::setw(4) << size << "x" << std::left << std::setw(5) << size << std::right
+                  << std::fixed << std::setprecision(1)
+                  << " BFS " << std::setw(8) << bfs_us << " us"
+                  << "  repair avg " << std::setw(7) << repair_us / (2 * changes) << " us, "
+                  << std::setw(6) << repair_cells / (2 * changes) << " cells"
+                  << "  " << agents << " agents: lookups " << std::setw(7) << lookup_us << " us ("
+                  << moved << " moved), A* each ~" << std::setw(9) << astar_us << " us"
+                  << "  " << (correct ? "matches rebuild" : "MISMATCH") << std::endl;
+        return correct;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t agents = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    std::size_t changes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+    uint32_t seed = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+    agents = std::max<std::size_t>(agents, 1);
+    changes = std::max<std::size_t>(changes, 1);
+
+    std::cout << "Flow field benchmark: " << agents << " agents, " << changes
+              << " obstacle changes per board, 20% blocked, wrapping" << std::endl;
+    bool correct = true;
+    for (int size : {64, 256, 1024}) {
+        correct = BenchmarkBoard(size, agents, changes, seed) && correct;
+    }
+    return correct ? 0 : 1;
+}
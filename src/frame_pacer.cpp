@@ -0,0 +1,173 @@
+#include "frame_pacer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+FramePacer::FramePacer(PacingMode mode, int target_fps)
+    : mode(mode),
+      target_fps(std::max(1, target_fps)),
+      frequency(SDL_GetPerformanceFrequency()),
+      frame_period(frequency / static_cast<uint64_t>(std::max(1, target_fps))),
+      display_period(frame_period) {
+    sleep_overshoot = static_cast<uint64_t>(frequency * 0.001);
+    Resync();
+}
+
+double FramePacer::EndFrame() {
+    uint64_t work_done = SDL_GetPerformanceCounter();
+
+    switch (mode) {
+    case PacingMode::SLEEP_SPIN:
+        if (work_done > next_deadline) {
+            // Work overran the deadline: no waiting, and restart the schedule
+            // from now instead of trying to catch up with short frames
+            ++missed_deadlines;
+            next_deadline = work_done;
+        } else {
+            WaitUntil(next_deadline);
+        }
+        next_deadline += frame_period;
+        break;
+
+    case PacingMode::VSYNC:
+    case PacingMode::UNCAPPED:
+        break;
+    }
+
+    uint64_t frame_end = SDL_GetPerformanceCounter();
+    uint64_t interval = frame_end - last_frame_end;
+    last_frame_end = frame_end;
+    RecordFrame(interval);
+
+    if (mode == PacingMode::VSYNC) {
+        if (interval > display_period + display_period / 2) {
+            ++missed_deadlines; // At least one refresh was skipped
+        }
+        fast_vsync_frames = interval < display_period / 2 ? fast_vsync_frames + 1 : 0;
+        if (fast_vsync_frames >= kVsyncFallbackFrames) {
+            std::cerr << "VSync does not appear to be active, falling back to sleep-spin pacing.\n";
+            mode = PacingMode::SLEEP_SPIN;
+            next_deadline = frame_end + frame_period;
+        }
+    }
+
+    return static_cast<double>(interval) / frequency;
+}
+
+void FramePacer::Resync() {
+    last_frame_end = SDL_GetPerformanceCounter();
+    next_deadline = last_frame_end + frame_period;
+}
+
+void FramePacer::SetDisplayRefreshRate(int hz) {
+    display_period = hz > 0 ? frequency / static_cast<uint64_t>(hz) : frame_period;
+}
+
+double FramePacer::GetTargetFrameSeconds() const {
+    return 1.0 / target_fps;
+}
+
+double FramePacer::GetAverageFrameTimeMs() const {
+    return TicksToMs(mean_frame_ticks);
+}
+
+double FramePacer::GetFrameTimeStdDevMs() const {
+    if (frame_count < 2) {
+        return 0.0;
+    }
+    return TicksToMs(std::sqrt(frame_ticks_m2 / (frame_count - 1)));
+}
+
+double FramePacer::GetMaxFrameTimeMs() const {
+    return TicksToMs(static_cast<double>(max_frame_ticks));
+}
+
+void FramePacer::LogPacingReport() const {
+    std::cout << "\n=== Frame Pacing Report ===" << std::endl;
+    std::cout << "Mode: " << GetModeName(mode) << " @ " << target_fps << " FPS" << std::endl;
+    if (mode == PacingMode::VSYNC) {
+        std::cout << "Display: " << std::fixed << std::setprecision(1)
+                  << static_cast<double>(frequency) / display_period << " Hz" << std::endl;
+    }
+    std::cout << "Frames: " << frame_count << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Frame Time: avg " << GetAverageFrameTimeMs() << " ms, stddev "
+              << GetFrameTimeStdDevMs() << " ms, max " << GetMaxFrameTimeMs() << " ms" << std::endl;
+    std::cout << "Missed Deadlines: " << missed_deadlines << std::endl;
+    std::cout << "Late Frames: " << late_frames << std::endl;
+    std::cout << "===========================" << std::endl;
+}
+
+bool FramePacer::ParseMode(const std::string& text, PacingMode& mode) {
+    if (text == "vsync") {
+        mode = PacingMode::VSYNC;
+    } else if (text == "sleep-spin") {
+        mode = PacingMode::SLEEP_SPIN;
+    } else if (text == "uncapped") {
+        mode = PacingMode::UNCAPPED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* FramePacer::GetModeName(PacingMode mode) {
+    switch (mode) {
+    case PacingMode::VSYNC:
+        return "vsync";
+    case PacingMode::SLEEP_SPIN:
+        return "sleep-spin";
+    case PacingMode::UNCAPPED:
+        return "uncapped";
+    }
+    return "unknown";
+}
+
+void FramePacer::WaitUntil(uint64_t deadline) {
+    const uint64_t min_spin = static_cast<uint64_t>(frequency * kMinSpinSeconds);
+    const uint64_t max_spin = static_cast<uint64_t>(frequency * kMaxSpinSeconds);
+    const uint64_t spin_window = std::clamp(sleep_overshoot + sleep_overshoot / 4, min_spin, max_spin);
+
+    // Coarse phase: sleep, leaving the expected overshoot as spin time
+    uint64_t now = SDL_GetPerformanceCounter();
+    if (deadline > now + spin_window) {
+        uint64_t sleep_ticks = deadline - now - spin_window;
+        auto requested = std::chrono::nanoseconds(sleep_ticks * 1000000000ull / frequency);
+        std::this_thread::sleep_for(requested);
+
+        uint64_t woke = SDL_GetPerformanceCounter();
+        uint64_t slept = woke - now;
+        uint64_t overshoot = slept > sleep_ticks ? slept - sleep_ticks : 0;
+        // Track the worst recent overshoot, decaying slowly so one outlier
+        // does not keep the spin window wide forever
+        sleep_overshoot = std::max(overshoot, sleep_overshoot - sleep_overshoot / 32);
+        now = woke;
+    }
+
+    // Fine phase: yield-spin the last stretch for sub-millisecond precision
+    while (now < deadline) {
+        std::this_thread::yield();
+        now = SDL_GetPerformanceCounter();
+    }
+}
+
+void FramePacer::RecordFrame(uint64_t interval) {
+    ++frame_count;
+    double delta = static_cast<double>(interval) - mean_frame_ticks;
+    mean_frame_ticks += delta / static_cast<double>(frame_count);
+    frame_ticks_m2 += delta * (static_cast<double>(interval) - mean_frame_ticks);
+    max_frame_ticks = std::max(max_frame_ticks, interval);
+
+    uint64_t period = mode == PacingMode::VSYNC ? display_period : frame_period;
+    if (mode != PacingMode::UNCAPPED &&
+        static_cast<double>(interval) > period * (1.0 + kLateFrameTolerance)) {
+        ++late_frames;
+    }
+}
+
+double FramePacer::TicksToMs(double ticks) const {
+    return ticks * 1000.0 / static_cast<double>(frequency);
+}
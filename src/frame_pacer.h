@@ -0,0 +1,84 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include "SDL.h"
+#include <cstdint>
+#include <string>
+
+enum class PacingMode {
+    VSYNC,      // Present blocks on the display; the pacer only measures
+    SLEEP_SPIN, // Sleep until just before the deadline, then spin to it
+    UNCAPPED    // No waiting at all
+};
+
+// Paces the main loop against absolute deadlines (so timing error does not
+// accumulate) and keeps frame time statistics.
+class FramePacer {
+public:
+    explicit FramePacer(PacingMode mode, int target_fps);
+
+    // Call once per loop iteration after presenting. Waits according to the
+    // pacing mode and returns the seconds elapsed since the previous call.
+    double EndFrame();
+
+    // Restart timing after the loop was intentionally idle (no frames),
+    // so the gap is not counted as a late frame
+    void Resync();
+
+    // Refresh rate of the display the window is on (0 if unknown). With
+    // vsync, frames follow the display rather than the target rate, so the
+    // vsync checks measure against its period.
+    void SetDisplayRefreshRate(int hz);
+
+    PacingMode GetMode() const { return mode; }
+    int GetTargetFps() const { return target_fps; }
+    double GetTargetFrameSeconds() const;
+
+    // Statistics
+    uint64_t GetFrameCount() const { return frame_count; }
+    uint64_t GetMissedDeadlineCount() const { return missed_deadlines; }
+    uint64_t GetLateFrameCount() const { return late_frames; }
+    double GetAverageFrameTimeMs() const;
+    double GetFrameTimeStdDevMs() const;
+    double GetMaxFrameTimeMs() const;
+    void LogPacingReport() const;
+
+    static bool ParseMode(const std::string& text, PacingMode& mode);
+    static const char* GetModeName(PacingMode mode);
+
+private:
+    PacingMode mode;
+    const int target_fps;
+    const uint64_t frequency;
+    const uint64_t frame_period;
+    uint64_t display_period; // frame_period until SetDisplayRefreshRate
+    uint64_t next_deadline{0};
+    uint64_t last_frame_end{0};
+
+    // Running estimate of how far sleeps overshoot; we stop sleeping this
+    // long before the deadline and spin for the rest
+    uint64_t sleep_overshoot{0};
+
+    // VSync sanity check: presents returning much faster than the display
+    // period mean the driver ignored the request, so fall back to SLEEP_SPIN
+    int fast_vsync_frames{0};
+
+    // Frame interval statistics (Welford's online variance)
+    uint64_t frame_count{0};
+    uint64_t missed_deadlines{0};
+    uint64_t late_frames{0};
+    double mean_frame_ticks{0.0};
+    double frame_ticks_m2{0.0};
+    uint64_t max_frame_ticks{0};
+
+    static constexpr double kLateFrameTolerance = 0.1;     // 10% over the period
+    static constexpr int kVsyncFallbackFrames = 30;
+    static constexpr double kMinSpinSeconds = 0.0002;      // 200 us
+    static constexpr double kMaxSpinSeconds = 0.004;       // 4 ms
+
+    void WaitUntil(uint64_t deadline);
+    void RecordFrame(uint64_t interval);
+    double TicksToMs(double ticks) const;
+};
+
+#endif
@@ -0,0 +1,483 @@
+#include "frame_recorder.h"
+#include "checksum.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+
+// Little-endian bit sink for the deflate stream
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    void PutBits(uint32_t value, int count) {
+        accumulator |= static_cast<uint64_t>(value) << bit_count;
+        bit_count += count;
+        while (bit_count >= 8) {
+            out.push_back(static_cast<uint8_t>(accumulator & 0xFF));
+            accumulator >>= 8;
+            bit_count -= 8;
+        }
+    }
+
+    // Huffman codes are stored most significant bit first
+    void PutHuffman(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        PutBits(reversed, length);
+    }
+
+    void Flush() {
+        if (bit_count > 0) {
+            out.push_back(static_cast<uint8_t>(accumulator & 0xFF));
+        }
+        accumulator = 0;
+        bit_count = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out;
+    uint64_t accumulator{0};
+    int bit_count{0};
+};
+
+constexpr int kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27,
+                                 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr int kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr int kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                   193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+                                   6145, 8193, 12289, 16385, 24577};
+constexpr int kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+constexpr int kMaxMatchLength = 258;
+constexpr int kMaxMatchDistance = 32768;
+
+// Fixed Huffman literal/length alphabet (RFC 1951, 3.2.6)
+void PutLiteralLengthSymbol(BitWriter& bits, int symbol) {
+    if (symbol <= 143) {
+        bits.PutHuffman(0x30 + symbol, 8);
+    } else if (symbol <= 255) {
+        bits.PutHuffman(0x190 + (symbol - 144), 9);
+    } else if (symbol <= 279) {
+        bits.PutHuffman(symbol - 256, 7);
+    } else {
+        bits.PutHuffman(0xC0 + (symbol - 280), 8);
+    }
+}
+
+void PutMatch(BitWriter& bits, int length, int distance) {
+    int length_code = 28;
+    while (kLengthBase[length_code] > length) {
+        --length_code;
+    }
+    PutLiteralLengthSymbol(bits, 257 + length_code);
+    bits.PutBits(length - kLengthBase[length_code], kLengthExtra[length_code]);
+
+    int distance_code = 29;
+    while (kDistanceBase[distance_code] > distance) {
+        --distance_code;
+    }
+    bits.PutHuffman(distance_code, 5);
+    bits.PutBits(distance - kDistanceBase[distance_code], kDistanceExtra[distance_code]);
+}
+
+int MatchLength(const std::vector<uint8_t>& data, std::size_t position, std::size_t distance) {
+    if (distance == 0 || distance > position || distance > kMaxMatchDistance) {
+        return 0;
+    }
+    std::size_t limit = std::min<std::size_t>(kMaxMatchLength, data.size() - position);
+    std::size_t length = 0;
+    while (length < limit && data[position + length] == data[position + length - distance]) {
+        ++length;
+    }
+    return static_cast<int>(length);
+}
+
+void AppendBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+} // namespace
+
+FrameRecorder::FrameRecorder(CaptureFormat format, const std::string& output_path,
+                             int frames_per_second, std::size_t pool_size)
+    : format(format),
+      output_path(output_path),
+      frames_per_second(frames_per_second) {
+    frame_pool.reserve(pool_size);
+    free_frames.reserve(pool_size);
+    for (std::size_t i = 0; i < pool_size; ++i) {
+        frame_pool.emplace_back(std::make_unique<CapturedFrame>());
+        free_frames.push_back(frame_pool.back().get());
+    }
+}
+
+FrameRecorder::~FrameRecorder() {
+    Stop();
+}
+
+void FrameRecorder::Start() {
+    if (recording.load()) {
+        return;
+    }
+
+    try {
+        if (format == CaptureFormat::PNG_SEQUENCE) {
+            std::filesystem::create_directories(output_path);
+        } else {
+            y4m_stream.open(output_path, std::ios::binary | std::ios::trunc);
+            if (!y4m_stream.is_open()) {
+                std::cerr << "Could not open capture file: " << output_path << "\n";
+                return;
+            }
+            y4m_header_written = false;
+        }
+        capture_width = 0;
+        capture_height = 0;
+    } catch (const std::filesystem::filesystem_error& e) {
+        std::cerr << "Could not create capture directory: " << e.what() << "\n";
+        return;
+    }
+
+    stop_requested.store(false);
+    recording.store(true);
+    encoder_thread = std::thread(&FrameRecorder::EncoderWorkerThread, this);
+}
+
+void FrameRecorder::Stop() {
+    if (!recording.load()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        stop_requested.store(true);
+    }
+    pending_condition.notify_all();
+
+    if (encoder_thread.joinable()) {
+        encoder_thread.join();
+    }
+
+    if (y4m_stream.is_open()) {
+        y4m_stream.close();
+    }
+    recording.store(false);
+}
+
+bool FrameRecorder::IsRecording() const {
+    return recording.load();
+}
+
+CapturedFrame* FrameRecorder::AcquireFrame(int width, int height) {
+    if (!recording.load() || width <= 0 || height <= 0) {
+        return nullptr;
+    }
+
+    if (capture_width == 0) {
+        capture_width = width;
+        capture_height = height;
+    } else if (format == CaptureFormat::Y4M_STREAM &&
+               (width != capture_width || height != capture_height)) {
+        // Every Y4M frame must match the header, so end the stream cleanly
+        std::cerr << "Warning: output resized from " << capture_width << "x" << capture_height
+                  << " to " << width << "x" << height << ", stopping Y4M recording of "
+                  << output_path << "\n";
+        Stop();
+        return nullptr;
+    }
+
+    CapturedFrame* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (free_frames.empty()) {
+            // Drop policy: the encoder is behind, so skip this frame rather
+            // than stall the game loop or grow the queue without bound.
+            dropped_frames.fetch_add(1);
+            return nullptr;
+        }
+        frame = free_frames.back();
+        free_frames.pop_back();
+    }
+
+    // Only allocates the first time a pooled buffer is used at this size
+    frame->pixels.resize(static_cast<std::size_t>(width) * height * 4);
+    frame->width = width;
+    frame->height = height;
+    return frame;
+}
+
+void FrameRecorder::SubmitFrame(CapturedFrame* frame) {
+    if (frame == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        frame->frame_index = next_frame_index++;
+        pending_frames.push_back(frame);
+    }
+    submitted_frames.fetch_add(1);
+    pending_condition.notify_one();
+}
+
+void FrameRecorder::ReleaseFrame(CapturedFrame* frame) {
+    if (frame == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    free_frames.push_back(frame);
+}
+
+uint64_t FrameRecorder::GetSubmittedFrameCount() const {
+    return submitted_frames.load();
+}
+
+uint64_t FrameRecorder::GetDroppedFrameCount() const {
+    return dropped_frames.load();
+}
+
+uint64_t FrameRecorder::GetEncodedFrameCount() const {
+    return encoded_frames.load();
+}
+
+std::chrono::nanoseconds FrameRecorder::GetAverageEncodeTime() const {
+    uint64_t count = encoded_frames.load();
+    if (count > 0) {
+        return std::chrono::nanoseconds(total_encode_time_ns.load() / count);
+    }
+    return std::chrono::nanoseconds(0);
+}
+
+void FrameRecorder::LogRecordingReport() const {
+    std::cout << "\n=== Frame Capture Report ===" << std::endl;
+    std::cout << "Output: " << output_path << std::endl;
+    std::cout << "Frames Submitted: " << GetSubmittedFrameCount() << std::endl;
+    std::cout << "Frames Encoded: " << GetEncodedFrameCount() << std::endl;
+    std::cout << "Frames Dropped: " << GetDroppedFrameCount() << std::endl;
+    std::cout << "Average Encode Time: " << GetAverageEncodeTime().count() / 1000 << " μs" << std::endl;
+    std::cout << "============================" << std::endl;
+}
+
+bool FrameRecorder::ParseCaptureSpec(const std::string& spec, CaptureFormat& format,
+                                     std::string& output_path) {
+    std::size_t separator = spec.find(':');
+    if (separator == std::string::npos || separator + 1 >= spec.size()) {
+        return false;
+    }
+
+    std::string kind = spec.substr(0, separator);
+    if (kind == "png") {
+        format = CaptureFormat::PNG_SEQUENCE;
+    } else if (kind == "y4m") {
+        format = CaptureFormat::Y4M_STREAM;
+    } else {
+        return false;
+    }
+
+    output_path = spec.substr(separator + 1);
+    return true;
+}
+
+void FrameRecorder::EncoderWorkerThread() {
+    while (true) {
+        CapturedFrame* frame = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            pending_condition.wait(lock, [this]() {
+                return stop_requested.load() || !pending_frames.empty();
+            });
+
+            // Drain everything already submitted before honouring a stop
+            if (pending_frames.empty()) {
+                break;
+            }
+            frame = pending_frames.front();
+            pending_frames.pop_front();
+        }
+
+        auto start_time = std::chrono::steady_clock::now();
+        EncodeFrame(*frame);
+        auto end_time = std::chrono::steady_clock::now();
+        total_encode_time_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+        encoded_frames.fetch_add(1);
+
+        ReleaseFrame(frame);
+    }
+}
+
+void FrameRecorder::EncodeFrame(const CapturedFrame& frame) {
+    switch (format) {
+    case CaptureFormat::PNG_SEQUENCE:
+        WritePngFrame(frame);
+        break;
+    case CaptureFormat::Y4M_STREAM:
+        WriteY4mFrame(frame);
+        break;
+    }
+}
+
+void FrameRecorder::WritePngFrame(const CapturedFrame& frame) {
+    std::vector<uint8_t> png;
+    png.reserve(frame.pixels.size() / 4);
+
+    static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png.insert(png.end(), kSignature, kSignature + 8);
+
+    std::vector<uint8_t> header;
+    AppendBigEndian32(header, static_cast<uint32_t>(frame.width));
+    AppendBigEndian32(header, static_cast<uint32_t>(frame.height));
+    header.push_back(8); // Bit depth
+    header.push_back(6); // Colour type: RGBA
+    header.push_back(0); // Compression: deflate
+    header.push_back(0); // Filter method
+    header.push_back(0); // No interlace
+    AppendPngChunk(png, "IHDR", header.data(), header.size());
+
+    std::vector<uint8_t> image_data;
+    DeflateRgbaRows(frame, image_data);
+    AppendPngChunk(png, "IDAT", image_data.data(), image_data.size());
+    AppendPngChunk(png, "IEND", nullptr, 0);
+
+    std::ofstream file(GetPngFramePath(frame.frame_index), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Could not write capture frame: " << GetPngFramePath(frame.frame_index) << "\n";
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+}
+
+void FrameRecorder::WriteY4mFrame(const CapturedFrame& frame) {
+    if (!y4m_stream.is_open()) {
+        return;
+    }
+
+    if (!y4m_header_written) {
+        y4m_stream << "YUV4MPEG2 W" << frame.width << " H" << frame.height
+                   << " F" << frames_per_second << ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+        y4m_header_written = true;
+    }
+
+    const int width = frame.width;
+    const int height = frame.height;
+    const int chroma_width = (width + 1) / 2;
+    const int chroma_height = (height + 1) / 2;
+    const std::size_t luma_size = static_cast<std::size_t>(width) * height;
+    const std::size_t chroma_size = static_cast<std::size_t>(chroma_width) * chroma_height;
+
+    encode_buffer.resize(luma_size + 2 * chroma_size);
+    uint8_t* y_plane = encode_buffer.data();
+    uint8_t* u_plane = y_plane + luma_size;
+    uint8_t* v_plane = u_plane + chroma_size;
+    const uint8_t* rgba = frame.pixels.data();
+
+    // BT.601 full-range conversion in 16.16 fixed point
+    for (int i = 0; i < width * height; ++i) {
+        int r = rgba[i * 4];
+        int g = rgba[i * 4 + 1];
+        int b = rgba[i * 4 + 2];
+        y_plane[i] = static_cast<uint8_t>((19595 * r + 38470 * g + 7471 * b + 32768) >> 16);
+    }
+
+    for (int cy = 0; cy < chroma_height; ++cy) {
+        for (int cx = 0; cx < chroma_width; ++cx) {
+            int r = 0, g = 0, b = 0;
+            for (int dy = 0; dy < 2; ++dy) {
+                int y = std::min(cy * 2 + dy, height - 1);
+                for (int dx = 0; dx < 2; ++dx) {
+                    int x = std::min(cx * 2 + dx, width - 1);
+                    const uint8_t* pixel = rgba + (static_cast<std::size_t>(y) * width + x) * 4;
+                    r += pixel[0];
+                    g += pixel[1];
+                    b += pixel[2];
+                }
+            }
+            // Sum of four samples, so shift by two more bits
+            int u = (-11059 * r - 21709 * g + 32768 * b + (128 << 18) + (1 << 17)) >> 18;
+            int v = (32768 * r - 27439 * g - 5329 * b + (128 << 18) + (1 << 17)) >> 18;
+            std::size_t index = static_cast<std::size_t>(cy) * chroma_width + cx;
+            u_plane[index] = static_cast<uint8_t>(std::clamp(u, 0, 255));
+            v_plane[index] = static_cast<uint8_t>(std::clamp(v, 0, 255));
+        }
+    }
+
+    y4m_stream << "FRAME\n";
+    y4m_stream.write(reinterpret_cast<const char*>(encode_buffer.data()),
+                     static_cast<std::streamsize>(encode_buffer.size()));
+}
+
+std::string FrameRecorder::GetPngFramePath(uint64_t frame_index) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06llu.png", static_cast<unsigned long long>(frame_index));
+    return (std::filesystem::path(output_path) / name).string();
+}
+
+void FrameRecorder::AppendPngChunk(std::vector<uint8_t>& out, const char* type,
+                                   const uint8_t* data, std::size_t length) {
+    AppendBigEndian32(out, static_cast<uint32_t>(length));
+    std::size_t type_offset = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (length > 0) {
+        out.insert(out.end(), data, data + length);
+    }
+    uint32_t crc = Checksum::Crc32(out.data() + type_offset, length + 4);
+    AppendBigEndian32(out, crc);
+}
+
+void FrameRecorder::DeflateRgbaRows(const CapturedFrame& frame, std::vector<uint8_t>& out) {
+    // Raw scanlines, each prefixed with filter type 0 (None)
+    const std::size_t row_bytes = static_cast<std::size_t>(frame.width) * 4;
+    const std::size_t stride = row_bytes + 1;
+    std::vector<uint8_t> raw(stride * frame.height);
+    for (int y = 0; y < frame.height; ++y) {
+        raw[y * stride] = 0;
+        std::copy_n(frame.pixels.data() + y * row_bytes, row_bytes, raw.data() + y * stride + 1);
+    }
+
+    // zlib wrapper: 32K window, no preset dictionary, fastest level
+    out.push_back(0x78);
+    out.push_back(0x01);
+
+    // A single fixed-Huffman block. Game frames are large flat-coloured
+    // areas, so matching only against the previous pixel and the pixel
+    // directly above gets most of the gain of a full LZ77 search at a small
+    // fraction of its cost.
+    BitWriter bits(out);
+    bits.PutBits(1, 1); // BFINAL
+    bits.PutBits(1, 2); // BTYPE = fixed Huffman
+
+    std::size_t position = 0;
+    while (position < raw.size()) {
+        int left_match = MatchLength(raw, position, 4);
+        int up_match = MatchLength(raw, position, stride);
+
+        if (left_match >= 3 || up_match >= 3) {
+            if (up_match > left_match) {
+                PutMatch(bits, up_match, static_cast<int>(stride));
+                position += up_match;
+            } else {
+                PutMatch(bits, left_match, 4);
+                position += left_match;
+            }
+        } else {
+            PutLiteralLengthSymbol(bits, raw[position]);
+            ++position;
+        }
+    }
+
+    PutLiteralLengthSymbol(bits, 256); // End of block
+    bits.Flush();
+
+    AppendBigEndian32(out, Checksum::Adler32(raw.data(), raw.size()));
+}
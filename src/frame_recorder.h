@@ -0,0 +1,112 @@
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class CaptureFormat {
+    PNG_SEQUENCE, // One numbered .png per frame inside an output directory
+    Y4M_STREAM    // Single raw YUV4MPEG2 (4:2:0) stream file
+};
+
+// Frame buffer handed between the game loop and the encoder thread.
+// Pixels are tightly packed RGBA32 (4 bytes per pixel, no row padding).
+struct CapturedFrame {
+    std::vector<uint8_t> pixels;
+    int width{0};
+    int height{0};
+    uint64_t frame_index{0};
+};
+
+class FrameRecorder {
+public:
+    explicit FrameRecorder(CaptureFormat format, const std::string& output_path,
+                           int frames_per_second, std::size_t pool_size = 8);
+    ~FrameRecorder();
+
+    // Rule of Five - owns a worker thread, neither copyable nor movable
+    FrameRecorder(const FrameRecorder& other) = delete;
+    FrameRecorder& operator=(const FrameRecorder& other) = delete;
+    FrameRecorder(FrameRecorder&& other) = delete;
+    FrameRecorder& operator=(FrameRecorder&& other) = delete;
+
+    void Start();
+    void Stop(); // Encodes every frame already submitted, then joins the thread
+    bool IsRecording() const;
+
+    // Game loop side. Neither call waits on the encoder or on disk I/O:
+    // AcquireFrame returns nullptr when every pooled buffer is still queued
+    // for encoding, and the caller drops that frame. The one exception is a
+    // Y4M frame of a new size: that stops the recording (flushing the queue)
+    // and every later call returns nullptr.
+    CapturedFrame* AcquireFrame(int width, int height);
+    void SubmitFrame(CapturedFrame* frame);
+    void ReleaseFrame(CapturedFrame* frame); // Return an acquired frame unused
+
+    // Statistics
+    uint64_t GetSubmittedFrameCount() const;
+    uint64_t GetDroppedFrameCount() const;
+    uint64_t GetEncodedFrameCount() const;
+    std::chrono::nanoseconds GetAverageEncodeTime() const;
+    void LogRecordingReport() const;
+
+    // Parses "png:<directory>" or "y4m:<file>" as given on the command line
+    static bool ParseCaptureSpec(const std::string& spec, CaptureFormat& format,
+                                 std::string& output_path);
+
+private:
+    const CaptureFormat format;
+    const std::string output_path;
+    const int frames_per_second;
+
+    // Buffer pool: every frame is either free or pending, so the pending queue
+    // is bounded by the pool size without any extra bookkeeping.
+    std::vector<std::unique_ptr<CapturedFrame>> frame_pool;
+    std::vector<CapturedFrame*> free_frames;
+    std::deque<CapturedFrame*> pending_frames;
+    mutable std::mutex pool_mutex;
+    std::condition_variable pending_condition;
+
+    std::thread encoder_thread;
+    std::atomic<bool> stop_requested{false};
+    std::atomic<bool> recording{false};
+
+    // Size of the first frame acquired; a Y4M header fixes the size of the
+    // whole stream (only touched by the capturing thread)
+    int capture_width{0};
+    int capture_height{0};
+
+    // Counters
+    uint64_t next_frame_index{0};
+    std::atomic<uint64_t> submitted_frames{0};
+    std::atomic<uint64_t> dropped_frames{0};
+    std::atomic<uint64_t> encoded_frames{0};
+    std::atomic<uint64_t> total_encode_time_ns{0};
+
+    // Encoder thread state (only touched by the encoder thread)
+    std::ofstream y4m_stream;
+    bool y4m_header_written{false};
+    std::vector<uint8_t> encode_buffer;
+
+    void EncoderWorkerThread();
+    void EncodeFrame(const CapturedFrame& frame);
+    void WritePngFrame(const CapturedFrame& frame);
+    void WriteY4mFrame(const CapturedFrame& frame);
+    std::string GetPngFramePath(uint64_t frame_index) const;
+
+    // Helpers for the minimal PNG writer
+    static void AppendPngChunk(std::vector<uint8_t>& out, const char* type,
+                               const uint8_t* data, std::size_t length);
+    static void DeflateRgbaRows(const CapturedFrame& frame, std::vector<uint8_t>& out);
+};
+
+#endif
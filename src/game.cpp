@@ -1,63 +1,71 @@
 #include "game.h"
 #include "collision_detector.h"
+#include "movement_patterns.h"
 #include "SDL.h"
 #include <iostream>
 
-Game::Game(std::size_t grid_width, std::size_t grid_height)
+Game::Game(std::size_t grid_width, std::size_t grid_height, const std::string &score_file,
+           const std::string &legacy_score_file)
     : snake(grid_width, grid_height), engine(dev()),
       random_w(0, static_cast<int>(grid_width - 1)),
       random_h(0, static_cast<int>(grid_height - 1)),
-      highScoreManager(std::make_unique<HighScoreManager>()),
+      config(static_cast<uint32_t>(grid_width), static_cast<uint32_t>(grid_height)),
+      update_step_seconds(1.0f / config.tickRate),
+      highScoreManager(std::make_unique<HighScoreManager>(score_file, legacy_score_file, config)),
       obstacleManager(std::make_unique<ThreadedObstacleManager>(grid_width, grid_height)),
       asyncGenerator(std::make_unique<AsyncObstacleGenerator>(grid_width, grid_height)) {
   PlaceFood();
+  StartNoiseField();
   InitializeObstacleThreads();
 }
 
-void Game::Run(Controller const &controller, Renderer &renderer,
-               std::size_t target_frame_duration) {
+void Game::Run(Controller const &controller, Renderer &renderer, FramePacer &pacer) {
   Uint32 title_timestamp = SDL_GetTicks();
-  Uint32 frame_start;
   Uint32 frame_end;
-  Uint32 frame_duration;
   int frame_count = 0;
+  double update_accumulator = 0.0;
+  double frame_seconds = pacer.GetTargetFrameSeconds();
   bool running = true;
 
   while (running) {
-    frame_start = SDL_GetTicks();
-
-    // Poll ALL events once per frame
     SDL_Event e;
-    while (SDL_PollEvent(&e)) {
-      if (e.type == SDL_QUIT) {
-        // Save score if quitting during gameplay
-        if (currentState == GameState::PLAYING) {
-          SaveCurrentScore();
-        }
-        running = false;
-        continue;
+    if (IsIdle()) {
+      // Nothing on screen can change until an event arrives, so sleep in
+      // the event queue instead of re-rendering identical frames
+      if (SDL_WaitEventTimeout(&e, kIdleWaitTimeoutMs)) {
+        HandleEvent(e, controller, renderer, running);
+      } else if (window_visible && highScoreManager->RefreshScores()) {
+        // Another game instance saved a score to the shared log
+        redraw_needed = true;
       }
+      pacer.Resync();
+    }
 
-      // Process event based on current state
-      switch (currentState) {
-      case GameState::ENTER_NAME:
-        UpdateEnterName(controller, e);
-        break;
-      case GameState::PLAYING:
-        UpdatePlaying(controller, e);
-        break;
-      case GameState::GAME_OVER:
-        UpdateGameOver(controller, e);
-        break;
-      case GameState::SHOW_SCORES:
-        UpdateShowScores(controller, e);
-        break;
-      }
+    // Poll ALL pending events once per frame
+    while (SDL_PollEvent(&e)) {
+      HandleEvent(e, controller, renderer, running);
+    }
+
+    if (!running || IsIdle()) {
+      continue;
     }
 
-    // Update game logic (separate from event handling)
+    // Update game logic (separate from event handling) in fixed steps, so
+    // the game speed does not depend on the render rate or pacing mode
     if (currentState == GameState::PLAYING) {
-      Update();
+      update_accumulator += frame_seconds;
+      int updates = 0;
+      while (update_accumulator >= update_step_seconds && updates < kMaxUpdatesPerFrame &&
+             currentState == GameState::PLAYING) {
+        Update();
+        update_accumulator -= update_step_seconds;
+        ++updates;
+      }
+      if (updates == kMaxUpdatesPerFrame) {
+        update_accumulator = 0.0;
+      }
+    } else {
+      update_accumulator = 0.0;
     }
 
     // State-specific rendering
@@ -72,17 +80,17 @@ void Game::Run(Controller const &controller, Renderer &renderer,
       renderer.RenderGameOverScreen(score, highScoreManager->IsNewHighestScore(score));
       break;
     case GameState::SHOW_SCORES:
-      renderer.RenderEnhancedHighScores(highScoreManager->GetTopScores(10),
-        [this](const std::string& timestamp) { return highScoreManager->FormatTimestamp(timestamp); });
+      renderer.RenderEnhancedHighScores(highScoreManager->GetTopScoreRows(10),
+                                        config.Describe());
       break;
     }
+    redraw_needed = false;
 
+    // Wait for the next frame deadline; the measured frame time feeds the
+    // next iteration's fixed update steps.
+    frame_seconds = pacer.EndFrame();
     frame_end = SDL_GetTicks();
-
-    // Keep track of how long each loop through the input/update/render cycle
-    // takes.
     frame_count++;
-    frame_duration = frame_end - frame_start;
 
     // After every second, update the window title.
     if (frame_end - title_timestamp >= 1000) {
@@ -90,16 +98,76 @@ void Game::Run(Controller const &controller, Renderer &renderer,
       frame_count = 0;
       title_timestamp = frame_end;
     }
+  }
+
+  pacer.LogPacingReport();
+}
+
+void Game::HandleEvent(const SDL_Event &e, Controller const &controller,
+                       Renderer &renderer, bool &running) {
+  if (e.type == SDL_QUIT) {
+    // Save score if quitting during gameplay, or the game itself when it
+    // can be resumed (the score is saved when that run ends)
+    if (currentState == GameState::PLAYING) {
+      if (snapshotWriter) {
+        Autosave();
+      } else {
+        SaveCurrentScore();
+      }
+    }
+    running = false;
+    return;
+  }
 
-    // If the time for this frame is too small (i.e. frame_duration is
-    // smaller than the target ms_per_frame), delay the loop to
-    // achieve the correct frame rate.
-    if (frame_duration < target_frame_duration) {
-      SDL_Delay(target_frame_duration - frame_duration);
+  if (e.type == SDL_WINDOWEVENT) {
+    switch (e.window.event) {
+    case SDL_WINDOWEVENT_HIDDEN:
+    case SDL_WINDOWEVENT_MINIMIZED:
+      window_visible = false;
+      break;
+    case SDL_WINDOWEVENT_SHOWN:
+    case SDL_WINDOWEVENT_RESTORED:
+    case SDL_WINDOWEVENT_MAXIMIZED:
+    case SDL_WINDOWEVENT_EXPOSED:
+    case SDL_WINDOWEVENT_SIZE_CHANGED:
+      window_visible = true;
+      redraw_needed = true;
+      break;
     }
+    return;
+  }
+
+  // Process event based on current state
+  GameState previousState = currentState;
+  switch (currentState) {
+  case GameState::ENTER_NAME:
+    UpdateEnterName(controller, e);
+    break;
+  case GameState::PLAYING:
+    UpdatePlaying(controller, e);
+    controller.HandleCameraInput(e, renderer.GetCamera());
+    break;
+  case GameState::GAME_OVER:
+    UpdateGameOver(controller, e);
+    break;
+  case GameState::SHOW_SCORES:
+    UpdateShowScores(controller, e);
+    break;
+  }
+
+  // Menu screens only change in response to key presses and text input
+  if (currentState != previousState || e.type == SDL_KEYDOWN || e.type == SDL_TEXTINPUT) {
+    redraw_needed = true;
   }
 }
 
+bool Game::IsIdle() const {
+  // Gameplay renders every frame; menus only when something changed, and
+  // nothing renders while the window is hidden or minimised (which also
+  // pauses gameplay)
+  return !window_visible || (currentState != GameState::PLAYING && !redraw_needed);
+}
+
 void Game::PlaceFood() {
   int x, y;
   while (true) {
@@ -126,10 +194,12 @@ void Game::Update() {
   // Handle obstacle updates and spawning
   obstacleManager->UpdateObstacleMovement();
 
-  // Calculate delta time for obstacle spawning (60 FPS = ~16.67ms per frame)
-  static const float frame_delta_time = 1.0f / 60.0f;
-  HandleObstacleSpawning(frame_delta_time);
+  // Each call is one fixed update step
+  HandleObstacleSpawning(update_step_seconds);
 
+  if (autopilot) {
+    autopilot->Steer(snake, food, *obstacleManager);
+  }
   snake.Update();
 
   // Check obstacle collisions
@@ -157,6 +227,71 @@ void Game::Update() {
     // Update difficulty based on score
     UpdateDifficulty();
   }
+
+  if (snapshotWriter) {
+    autosave_timer += update_step_seconds;
+    if (autosave_timer >= kAutosaveIntervalSeconds) {
+      Autosave();
+    }
+  }
+}
+
+void Game::Autosave() {
+  autosave_timer = 0.0f;
+  CaptureSnapshot(*autosaveSnapshot);
+  snapshotWriter->Submit(autosaveSnapshot);
+}
+
+bool Game::EnableAutosave(const std::string &path) {
+  snapshotWriter = std::make_unique<SnapshotWriter>(path);
+  snapshotWriter->Start();
+  autosaveSnapshot = std::make_unique<GameSnapshot>();
+
+  GameSnapshot saved;
+  if (!GameSnapshotFile::Read(path, saved) || !saved.alive || saved.player_name.empty()) {
+    return false;
+  }
+  if (!RestoreSnapshot(saved)) {
+    std::cerr << "Warning: " << path << " holds a game for another board; starting a new game" << std::endl;
+    return false;
+  }
+  currentState = GameState::PLAYING;
+  redraw_needed = true;
+  std::cout << "Resumed " << playerName << "'s game at score " << score << " from " << path << std::endl;
+  return true;
+}
+
+void Game::CaptureSnapshot(GameSnapshot &snapshot) const {
+  snapshot.config_fingerprint = config.Fingerprint();
+  snapshot.grid_width = config.gridWidth;
+  snapshot.grid_height = config.gridHeight;
+  snapshot.player_name = playerName;
+  snapshot.score = score;
+  snapshot.ticks = 0;
+  snapshot.CaptureSnake(snake);
+  snapshot.food = food;
+  snapshot.CaptureObstacles(*obstacleManager);
+  snapshot.food_engine = engine;
+  snapshot.random_walk_engine = MovementPatterns::MovementCalculator::GetRandomWalkEngine();
+}
+
+bool Game::RestoreSnapshot(const GameSnapshot &snapshot) {
+  if (snapshot.config_fingerprint != config.Fingerprint()) {
+    return false;
+  }
+  playerName = snapshot.player_name;
+  score = snapshot.score;
+  snapshot.RestoreSnake(snake);
+  food = snapshot.food;
+  snapshot.RestoreObstacles(*obstacleManager);
+  obstacleManager->BuildNoiseField(0); // Before play resumes, on every core
+  engine = snapshot.food_engine;
+  MovementPatterns::MovementCalculator::SetRandomWalkEngine(snapshot.random_walk_engine);
+  if (autopilot) {
+    autopilot->Reset();
+  }
+  autosave_timer = 0.0f;
+  return true;
 }
 
 void Game::SaveCurrentScore() {
@@ -180,7 +315,13 @@ void Game::UpdateEnterName(const Controller& controller, const SDL_Event& event)
 }
 
 void Game::UpdatePlaying(const Controller& controller, const SDL_Event& event) {
-  controller.HandleInput(event, snake);
+  if (!autopilot) {
+    controller.HandleInput(event, snake);
+  }
+}
+
+void Game::EnableAutopilot() {
+  autopilot = std::make_unique<Autopilot>();
 }
 
 void Game::UpdateGameOver(const Controller& controller, const SDL_Event& event) {
@@ -214,6 +355,12 @@ void Game::UpdateShowScores(const Controller& controller, const SDL_Event& event
 }
 
 void Game::TransitionToState(GameState newState) {
+  if (newState == GameState::SHOW_SCORES) {
+    highScoreManager->RefreshScores();
+  }
+  if (newState == GameState::GAME_OVER && snapshotWriter) {
+    snapshotWriter->Discard(); // The run is over; nothing to resume
+  }
   currentState = newState;
 }
 
@@ -221,8 +368,20 @@ void Game::ResetGame() {
   score = 0;
   playerName.clear();
   snake = Snake(random_w.max() + 1, random_h.max() + 1);
+  if (autopilot) {
+    autopilot->Reset();
+  }
   obstacleManager->ClearAllObstacles();
+  autosave_timer = 0.0f;
   PlaceFood();
+  StartNoiseField();
+}
+
+void Game::StartNoiseField() {
+  // Built now on every core, between games, rather than on one thread by
+  // the update that spawns the first drifting obstacle
+  obstacleManager->SetNoiseSeed(static_cast<uint32_t>(engine()));
+  obstacleManager->BuildNoiseField(0);
 }
 
 int Game::GetScore() const { return score; }
@@ -238,8 +397,9 @@ void Game::CheckObstacleCollisions() {
 }
 
 void Game::UpdateDifficulty() {
-  int difficulty_level = score / kDifficultyIncreaseInterval + 1;
+  int difficulty_level = config.GetDifficultyLevel(score);
   obstacleManager->SetDifficultyLevel(difficulty_level);
+  obstacleManager->SetSpawnRate(config.GetSpawnRate(difficulty_level));
 }
 
 void Game::HandleObstacleSpawning(float delta_time) {
@@ -265,7 +425,7 @@ void Game::HandleAsyncObstacleGeneration() {
 
   // Check if it's time for async generation
   if (async_generation_timer >= kAsyncGenerationInterval && !async_generation_pending) {
-    int difficulty_level = score / kDifficultyIncreaseInterval + 1;
+    int difficulty_level = config.GetDifficultyLevel(score);
     int fixed_count = std::min(difficulty_level / 2, 3); // Max 3 fixed obstacles
     int moving_count = std::min(difficulty_level / 3, 2); // Max 2 moving obstacles
 
@@ -6,8 +6,13 @@
 #include "renderer.h"
 #include "snake.h"
 #include "highscore_manager.h"
+#include "board_config.h"
 #include "threaded_obstacle_manager.h"
 #include "async_obstacle_generator.h"
+#include "frame_pacer.h"
+#include "autopilot.h"
+#include "game_snapshot.h"
+#include "snapshot_writer.h"
 #include <random>
 #include <string>
 #include <memory>
@@ -22,9 +27,20 @@ enum class GameState {
 
 class Game {
 public:
-  Game(std::size_t grid_width, std::size_t grid_height);
-  void Run(Controller const &controller, Renderer &renderer,
-           std::size_t target_frame_duration);
+  // Scores are kept in `score_file`, importing `legacy_score_file` once if
+  // it exists (an empty name skips the import; see HighScoreManager)
+  Game(std::size_t grid_width, std::size_t grid_height, const std::string &score_file = "scores.bin",
+       const std::string &legacy_score_file = "scores.txt");
+  void Run(Controller const &controller, Renderer &renderer, FramePacer &pacer);
+  void EnableAutopilot(); // The snake steers itself; arrow keys are ignored
+
+  // Saves the running game to `path` every few seconds and when the window
+  // closes, and deletes the save when the snake dies. If `path` already
+  // holds a game for this board, it is resumed; returns true then.
+  bool EnableAutosave(const std::string &path);
+
+  void CaptureSnapshot(GameSnapshot &snapshot) const;
+  bool RestoreSnapshot(const GameSnapshot &snapshot); // False for another board
   int GetScore() const;
   int GetSize() const;
   GameState GetState() const;
@@ -39,23 +55,42 @@ private:
   std::uniform_int_distribution<int> random_w;
   std::uniform_int_distribution<int> random_h;
 
+  // Grid size, difficulty curve and tick rate; scores are kept per config
+  BoardConfig config;
+  float update_step_seconds;
+
   int score{0};
   GameState currentState{GameState::ENTER_NAME};
   std::string playerName;
   std::unique_ptr<HighScoreManager> highScoreManager;
+  std::unique_ptr<Autopilot> autopilot; // Replaces keyboard steering when set
+
+  // Autosave: captured on this thread, written by snapshotWriter's
+  std::unique_ptr<SnapshotWriter> snapshotWriter;
+  std::unique_ptr<GameSnapshot> autosaveSnapshot; // Reused capture buffer
+  float autosave_timer{0.0f};
+  static constexpr float kAutosaveIntervalSeconds = 5.0f;
 
   // Add threaded obstacle management
   std::unique_ptr<ThreadedObstacleManager> obstacleManager;
   std::unique_ptr<AsyncObstacleGenerator> asyncGenerator;
 
-  // Configuration
-  static constexpr float kInitialSpawnRate = 0.3f; // obstacles per second
-  static constexpr float kSpawnRateIncrease = 0.1f; // increase per difficulty level
-  static constexpr int kDifficultyIncreaseInterval = 5; // Every 5 points
+  // Game logic advances in fixed steps (config.tickRate per second)
+  // regardless of the render rate
+  static constexpr int kMaxUpdatesPerFrame = 5; // Drop time beyond this after a stall
+
+  // Idle handling: menus redraw only when dirty, and nothing draws while hidden
+  static constexpr int kIdleWaitTimeoutMs = 500;
+  bool redraw_needed{true};
+  bool window_visible{true};
 
   void PlaceFood();
   void Update();
+  void HandleEvent(const SDL_Event &e, Controller const &controller,
+                   Renderer &renderer, bool &running);
+  bool IsIdle() const;
   void SaveCurrentScore();
+  void Autosave();
   void UpdateEnterName(const Controller& controller, const SDL_Event& event);
   void UpdatePlaying(const Controller& controller, const SDL_Event& event);
   void UpdateGameOver(const Controller& controller, const SDL_Event& event);
@@ -63,6 +98,7 @@ private:
 
   void TransitionToState(GameState newState);
   void ResetGame();
+  void StartNoiseField(); // A fresh NOISE_DRIFT field for the new game
 
   // New obstacle-related methods
   void CheckObstacleCollisions();
@@ -0,0 +1,130 @@
+#include "game_client.h"
+#include "moving_obstacle.h"
+#include <iostream>
+
+namespace {
+  uint32_t GetU32(const uint8_t *data) {
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+  }
+
+  // Obstacles only render; they never expire between two states
+  constexpr float kShownLifetime = 60.0f;
+}
+
+bool GameClient::Connect(uint16_t port) {
+  int fd = LoopbackSocket::Connect(port);
+  if (fd < 0) {
+    return false;
+  }
+  stream = std::make_unique<MessageStream>(fd);
+  frame = WorldFrame{};
+  welcomed = false;
+  states_received = 0;
+  return true;
+}
+
+bool GameClient::Poll() {
+  if (!stream) {
+    return false;
+  }
+  bool open = stream->Receive();
+
+  uint8_t type;
+  const uint8_t *data;
+  std::size_t length;
+  while (stream->NextMessage(type, data, length)) {
+    if (type == NetMessage::kWelcome && length == 12) {
+      frame = WorldFrame{};
+      frame.width = GetU32(data);
+      frame.height = GetU32(data + 4);
+      snake_index = GetU32(data + 8);
+      welcomed = frame.width > 0 && frame.height > 0;
+      ++frame_version;
+    } else if (type == NetMessage::kState && welcomed) {
+      if (!WorldDelta::Apply(frame, data, length)) {
+        std::cerr << "Warning: Disconnecting after a malformed state from the server" << std::endl;
+        stream.reset();
+        return false;
+      }
+      ++states_received;
+      ++frame_version;
+    }
+  }
+  return open;
+}
+
+void GameClient::SendDirection(Snake::Direction direction) {
+  if (stream) {
+    uint8_t value = static_cast<uint8_t>(direction);
+    stream->Send(NetMessage::kInput, &value, 1);
+    stream->Flush();
+  }
+}
+
+void GameClient::BuildSnake(Snake &snake) const {
+  std::vector<SDL_Point> body;
+  if (snake_index < frame.snakes.size()) {
+    const WorldFrame::SnakeState &state = frame.snakes[snake_index];
+    for (uint32_t cell : state.body) {
+      body.push_back(Point(cell));
+    }
+    snake.alive = state.alive && !body.empty();
+    snake.direction = static_cast<Snake::Direction>(state.direction);
+  } else {
+    snake.alive = false;
+  }
+  if (!body.empty()) {
+    snake.head_x = static_cast<float>(body.back().x);
+    snake.head_y = static_cast<float>(body.back().y);
+    snake.size = static_cast<int>(body.size());
+    body.pop_back();
+  }
+  snake.RestoreBody(body);
+}
+
+void GameClient::BuildObstacles(ObstacleManager &obstacles) {
+  if (obstacles_version == frame_version) {
+    return;
+  }
+  obstacles_version = frame_version;
+  obstacle_states.clear();
+  for (const WorldFrame::ObstacleState &obstacle : frame.obstacles) {
+    SDL_Point cell = Point(obstacle.cell);
+    ObstacleManager::ObstacleState state{};
+    state.x = cell.x;
+    state.y = cell.y;
+    state.type = static_cast<ObstacleType>(obstacle.type);
+    state.pattern = static_cast<MovementPattern>(obstacle.pattern);
+    state.exact_x = static_cast<float>(cell.x);
+    state.exact_y = static_cast<float>(cell.y);
+    state.lifetime = kShownLifetime;
+    obstacle_states.push_back(state);
+  }
+  for (std::size_t i = 0; i < frame.snakes.size(); ++i) {
+    if (i == snake_index) {
+      continue;
+    }
+    for (uint32_t body_cell : frame.snakes[i].body) {
+      SDL_Point cell = Point(body_cell);
+      ObstacleManager::ObstacleState state{};
+      state.x = cell.x;
+      state.y = cell.y;
+      state.type = ObstacleType::FIXED;
+      state.lifetime = kShownLifetime;
+      obstacle_states.push_back(state);
+    }
+  }
+  obstacles.RestoreObstacles(obstacle_states);
+}
+
+SDL_Point GameClient::GetFood() const {
+  if (frame.foods.empty()) {
+    return SDL_Point{-1, -1};
+  }
+  return Point(frame.foods[snake_index % frame.foods.size()]);
+}
+
+int GameClient::GetScore() const {
+  return snake_index < frame.snakes.size() ? frame.snakes[snake_index].score : 0;
+}
@@ -0,0 +1,57 @@
+#ifndef GAME_CLIENT_H
+#define GAME_CLIENT_H
+
+#include "SDL.h"
+#include "message_stream.h"
+#include "obstacle_manager.h"
+#include "snake.h"
+#include "world_delta.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// The other end of GameServer: keeps a WorldFrame current from the
+// server's deltas and sends the player's direction. The Build methods turn
+// the frame into what Renderer draws; the other snakes come out as fixed
+// obstacles, since Renderer draws one snake.
+class GameClient {
+public:
+  bool Connect(uint16_t port);
+
+  // Reads and applies what the server sent; false once the connection
+  // closed or a state could not be applied
+  bool Poll();
+  bool IsReady() const { return welcomed && states_received > 0; }
+
+  void SendDirection(Snake::Direction direction); // Sent at once
+
+  const WorldFrame &GetFrame() const { return frame; }
+  std::size_t GetSnakeIndex() const { return snake_index; }
+  uint64_t GetStatesReceived() const { return states_received; }
+  uint64_t GetBytesReceived() const { return stream ? stream->GetBytesReceived() : 0; }
+
+  // `snake` must be sized for the server's grid (see GetFrame); it takes
+  // the server's heading, so local turns start from where the snake goes
+  void BuildSnake(Snake &snake) const;
+  // Replaces the obstacles only when a state arrived since the last call,
+  // so frames drawn between two server ticks keep the ones they have
+  void BuildObstacles(ObstacleManager &obstacles);
+  SDL_Point GetFood() const; // This client's food item
+  int GetScore() const;
+
+private:
+  std::unique_ptr<MessageStream> stream;
+  WorldFrame frame;
+  std::size_t snake_index{0};
+  bool welcomed{false};
+  uint64_t states_received{0};
+  uint64_t frame_version{0};                // Bumped whenever `frame` changes
+  uint64_t obstacles_version{UINT64_MAX};   // frame_version BuildObstacles last built
+  std::vector<ObstacleManager::ObstacleState> obstacle_states; // Scratch
+
+  SDL_Point Point(uint32_t cell) const {
+    return SDL_Point{static_cast<int>(cell % frame.width), static_cast<int>(cell / frame.width)};
+  }
+};
+
+#endif
@@ -0,0 +1,212 @@
+#include "game_server.h"
+#include "moving_obstacle.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+  void PutU32(std::vector<uint8_t> &out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+}
+
+GameServer::GameServer(const BoardConfig &config, const Options &options)
+    : config(config), options(options), arena(config, options.food_count, options.seed) {
+  arena.SetRespawn(true);
+  arena.SetFlowFields(options.flow_fields);
+  empty.width = config.gridWidth;
+  empty.height = config.gridHeight;
+  previous = empty;
+}
+
+GameServer::~GameServer() {
+  clients.clear(); // Closes their sockets
+  LoopbackSocket::Close(listen_fd);
+}
+
+bool GameServer::Start() {
+  listen_fd = LoopbackSocket::Listen(options.port);
+  if (listen_fd < 0) {
+    return false;
+  }
+  port = LoopbackSocket::GetPort(listen_fd);
+  return true;
+}
+
+void GameServer::Tick() {
+  auto start = Clock::now();
+
+  AcceptClients();
+  ReadInputs();
+  arena.Step();
+  CaptureFrame(current);
+  Broadcast();
+  std::swap(previous, current);
+
+  double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  ++stats_ticks;
+  total_tick_us += us;
+  max_tick_us = std::max(max_tick_us, us);
+}
+
+void GameServer::AcceptClients() {
+  while (listen_fd >= 0 && clients.size() < options.max_clients) {
+    int fd = LoopbackSocket::Accept(listen_fd);
+    if (fd < 0) {
+      return;
+    }
+    auto input = std::make_unique<DirectionInput>();
+    DirectionInput *raw_input = input.get();
+    std::size_t snake;
+    if (!free_snakes.empty()) {
+      snake = free_snakes.back();
+      free_snakes.pop_back();
+      arena.SetInput(snake, std::move(input));
+    } else {
+      snake = arena.AddSnake(std::move(input));
+    }
+    clients.push_back(Client{std::make_unique<MessageStream>(fd), snake, raw_input});
+  }
+}
+
+void GameServer::ReadInputs() {
+  for (std::size_t i = clients.size(); i-- > 0;) {
+    Client &client = clients[i];
+    uint64_t before = client.stream->GetBytesReceived();
+    bool open = client.stream->Receive();
+    bytes_received += client.stream->GetBytesReceived() - before;
+
+    // Inputs that arrived before a disconnect still count
+    uint8_t type;
+    const uint8_t *data;
+    std::size_t length;
+    while (client.stream->NextMessage(type, data, length)) {
+      if (type == NetMessage::kInput && length == 1 &&
+          data[0] <= static_cast<uint8_t>(Snake::Direction::kRight)) {
+        client.input->SetDirection(static_cast<Snake::Direction>(data[0]));
+      }
+    }
+    if (!open || !client.stream->IsOpen()) {
+      DropClient(i);
+    }
+  }
+}
+
+void GameServer::CaptureFrame(WorldFrame &frame) {
+  const int width = arena.GetWidth();
+  frame.width = empty.width;
+  frame.height = empty.height;
+  frame.tick = arena.GetTicks();
+
+  frame.snakes.resize(arena.GetSnakeCount());
+  for (std::size_t i = 0; i < frame.snakes.size(); ++i) {
+    const Snake &snake = arena.GetSnake(i);
+    WorldFrame::SnakeState &state = frame.snakes[i];
+    state.alive = snake.alive;
+    state.direction = static_cast<uint8_t>(snake.direction);
+    state.score = arena.GetScore(i);
+    state.body.clear();
+    if (snake.alive) {
+      for (const SDL_Point &cell : snake.body) {
+        state.body.push_back(static_cast<uint32_t>(cell.y * width + cell.x));
+      }
+      state.body.push_back(static_cast<uint32_t>(static_cast<int>(snake.head_y) * width +
+                                                 static_cast<int>(snake.head_x)));
+    }
+  }
+
+  frame.foods.clear();
+  for (const SDL_Point &food : arena.GetFoods()) {
+    frame.foods.push_back(static_cast<uint32_t>(food.y * width + food.x));
+  }
+
+  // An obstacle keeps its id while it lives at the same address with the
+  // same type and pattern. An address reused within one tick by a lookalike
+  // reads as the old obstacle moving, which draws the same.
+  obstacle_scratch.clear();
+  arena.GetObstacles().QueryObstaclesInRect(SDL_Rect{0, 0, width, arena.GetHeight()}, obstacle_scratch);
+  next_obstacle_ids.clear();
+  frame.obstacles.clear();
+  for (const Obstacle *obstacle : obstacle_scratch) {
+    WorldFrame::ObstacleState state{0, static_cast<uint32_t>(obstacle->GetY() * width + obstacle->GetX()),
+                                    static_cast<uint8_t>(obstacle->GetType()), 0};
+    if (obstacle->GetType() == ObstacleType::MOVING) {
+      state.pattern = static_cast<uint8_t>(static_cast<const MovingObstacle *>(obstacle)->GetPattern());
+    }
+    auto known = obstacle_ids.find(obstacle);
+    if (known != obstacle_ids.end() && known->second.type == state.type &&
+        known->second.pattern == state.pattern) {
+      state.id = known->second.id;
+    } else {
+      state.id = next_obstacle_id++;
+    }
+    if (next_obstacle_ids.emplace(obstacle, state).second) {
+      frame.obstacles.push_back(state);
+    }
+  }
+  obstacle_ids.swap(next_obstacle_ids);
+  std::sort(frame.obstacles.begin(), frame.obstacles.end(),
+            [](const WorldFrame::ObstacleState &a, const WorldFrame::ObstacleState &b) { return a.id < b.id; });
+}
+
+void GameServer::Broadcast() {
+  WorldDelta::Encode(previous, current, payload);
+  state_message.clear();
+  MessageStream::Frame(NetMessage::kState, payload.data(), payload.size(), state_message);
+  state_bytes += state_message.size();
+  keyframe_message.clear();
+
+  for (std::size_t i = clients.size(); i-- > 0;) {
+    Client &client = clients[i];
+    if (client.welcomed) {
+      client.stream->SendFramed(state_message);
+    } else {
+      if (keyframe_message.empty()) {
+        WorldDelta::Encode(empty, current, payload);
+        MessageStream::Frame(NetMessage::kState, payload.data(), payload.size(), keyframe_message);
+        last_keyframe_bytes = keyframe_message.size();
+      }
+      welcome.clear();
+      PutU32(welcome, empty.width);
+      PutU32(welcome, empty.height);
+      PutU32(welcome, static_cast<uint32_t>(client.snake));
+      client.stream->Send(NetMessage::kWelcome, welcome.data(), welcome.size());
+      client.stream->SendFramed(keyframe_message);
+      client.welcomed = true;
+    }
+
+    uint64_t before = client.stream->GetBytesSent();
+    bool open = client.stream->Flush();
+    bytes_sent += client.stream->GetBytesSent() - before;
+    if (!open || client.stream->GetPendingBytes() > options.max_pending_bytes) {
+      DropClient(i);
+    }
+  }
+}
+
+void GameServer::DropClient(std::size_t index) {
+  std::size_t snake = clients[index].snake;
+  arena.SetInput(snake, std::make_unique<BotInput>());
+  free_snakes.push_back(snake);
+  clients.erase(clients.begin() + static_cast<std::ptrdiff_t>(index));
+  ++dropped_clients;
+}
+
+double GameServer::GetAverageTickMicroseconds() const {
+  return stats_ticks > 0 ? total_tick_us / stats_ticks : 0.0;
+}
+
+double GameServer::GetAverageStateBytes() const {
+  return stats_ticks > 0 ? static_cast<double>(state_bytes) / stats_ticks : 0.0;
+}
+
+void GameServer::ResetStats() {
+  stats_ticks = 0;
+  total_tick_us = 0.0;
+  max_tick_us = 0.0;
+  state_bytes = 0;
+  bytes_sent = 0;
+  bytes_received = 0;
+  dropped_clients = 0;
+}
@@ -0,0 +1,110 @@
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include "arena.h"
+#include "board_config.h"
+#include "message_stream.h"
+#include "world_delta.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Runs an Arena authoritatively for clients on loopback TCP. Every client
+// steers one snake; each Tick accepts new clients, applies their inputs,
+// steps the arena once and sends every client the same WorldDelta against
+// the previous tick (a joining client gets a keyframe first). The delta is
+// encoded once per tick whatever the number of clients.
+//
+// Snakes are never removed: a client that leaves hands its snake to a bot,
+// and the next client to join takes it over. Dead snakes respawn.
+// Single-threaded; call Tick at the board's tick rate.
+class GameServer {
+public:
+  struct Options {
+    uint16_t port{0};              // 0 picks a free port (see GetPort)
+    std::size_t food_count{8};
+    bool flow_fields{true};        // Bots follow Arena flow fields to the food
+    uint32_t seed{1};
+    std::size_t max_clients{512};
+    std::size_t max_pending_bytes{1u << 20}; // A client further behind is dropped
+  };
+
+  GameServer(const BoardConfig &config, const Options &options);
+  ~GameServer();
+
+  GameServer(const GameServer &) = delete;
+  GameServer &operator=(const GameServer &) = delete;
+
+  bool Start(); // False if the port cannot be bound
+  uint16_t GetPort() const { return port; }
+
+  void Tick();
+
+  const Arena &GetArena() const { return arena; }
+  const WorldFrame &GetFrame() const { return previous; } // As last sent
+  std::size_t GetClientCount() const { return clients.size(); }
+
+  // Statistics since the last ResetStats
+  uint64_t GetTicks() const { return stats_ticks; }
+  double GetAverageTickMicroseconds() const;
+  double GetMaxTickMicroseconds() const { return max_tick_us; }
+  double GetAverageStateBytes() const; // Per tick, as sent to every client
+  uint64_t GetBytesSent() const { return bytes_sent; }
+  uint64_t GetBytesReceived() const { return bytes_received; }
+  std::size_t GetLastKeyframeBytes() const { return last_keyframe_bytes; }
+  uint64_t GetDroppedClients() const { return dropped_clients; }
+  void ResetStats();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Client {
+    std::unique_ptr<MessageStream> stream;
+    std::size_t snake;
+    DirectionInput *input; // Owned by the arena
+    bool welcomed{false};
+  };
+
+  BoardConfig config;
+  Options options;
+  Arena arena;
+  int listen_fd{-1};
+  uint16_t port{0};
+  std::vector<Client> clients;
+  std::vector<std::size_t> free_snakes; // Left by clients, driven by bots
+
+  // Obstacles have no identity of their own; ids follow their addresses
+  // from tick to tick
+  std::unordered_map<const Obstacle *, WorldFrame::ObstacleState> obstacle_ids;
+  std::unordered_map<const Obstacle *, WorldFrame::ObstacleState> next_obstacle_ids;
+  uint32_t next_obstacle_id{0};
+  std::vector<const Obstacle *> obstacle_scratch;
+
+  WorldFrame previous; // Last state sent
+  WorldFrame current;
+  WorldFrame empty;    // Keyframes are deltas against this
+  std::vector<uint8_t> payload;
+  std::vector<uint8_t> welcome;
+  std::vector<uint8_t> state_message;
+  std::vector<uint8_t> keyframe_message;
+
+  // Statistics
+  uint64_t stats_ticks{0};
+  double total_tick_us{0.0};
+  double max_tick_us{0.0};
+  uint64_t state_bytes{0};
+  uint64_t bytes_sent{0};
+  uint64_t bytes_received{0};
+  std::size_t last_keyframe_bytes{0};
+  uint64_t dropped_clients{0};
+
+  void AcceptClients();
+  void ReadInputs();
+  void CaptureFrame(WorldFrame &frame);
+  void Broadcast();
+  void DropClient(std::size_t index);
+};
+
+#endif
@@ -0,0 +1,403 @@
+#include "game_snapshot.h"
+#include "atomic_file.h"
+#include "checksum.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+namespace {
+    const char kSnapshotMagic[4] = {'S', 'N', 'K', 'S'};
+    constexpr std::size_t kObstacleSizeV1 = 20;
+    constexpr std::size_t kObstacleSize = 36;
+    constexpr std::size_t kMaxEngineWords = 1024; // mt19937 needs 625 (624 state words and a position)
+
+    void PutU16(uint8_t* out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    void PutU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void PutU64(uint8_t* out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    // Appends little-endian values to a byte buffer
+    class Writer {
+    public:
+        explicit Writer(std::vector<uint8_t>& out) : out_(out) {}
+
+        void U8(uint8_t value) { out_.push_back(value); }
+        void U16(uint16_t value) { Append(value, 2); }
+        void U32(uint32_t value) { Append(value, 4); }
+        void U64(uint64_t value) { Append(value, 8); }
+        void F32(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            U32(bits);
+        }
+
+    private:
+        std::vector<uint8_t>& out_;
+
+        void Append(uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; ++i) {
+                out_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+    };
+
+    // Reads little-endian values; once a read runs past the end every
+    // later read returns 0 and Ok() is false
+    class Reader {
+    public:
+        Reader(const uint8_t* data, std::size_t length) : data_(data), length_(length) {}
+
+        bool Ok() const { return ok_; }
+        bool AtEnd() const { return position_ == length_; }
+        bool Has(std::size_t bytes) const { return ok_ && length_ - position_ >= bytes; }
+
+        uint8_t U8() { return Take(1) ? data_[position_ - 1] : 0; }
+        uint16_t U16() {
+            if (!Take(2)) return 0;
+            const uint8_t* in = data_ + position_ - 2;
+            return static_cast<uint16_t>(in[0] | (in[1] << 8));
+        }
+        uint32_t U32() {
+            if (!Take(4)) return 0;
+            uint32_t value = 0;
+            for (int i = 3; i >= 0; --i) {
+                value = (value << 8) | data_[position_ - 4 + i];
+            }
+            return value;
+        }
+        uint64_t U64() {
+            uint64_t low = U32();
+            return low | (static_cast<uint64_t>(U32()) << 32);
+        }
+        float F32() {
+            uint32_t bits = U32();
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+    private:
+        const uint8_t* data_;
+        std::size_t length_;
+        std::size_t position_{0};
+        bool ok_{true};
+
+        bool Take(std::size_t bytes) {
+            if (!Has(bytes)) {
+                ok_ = false;
+                return false;
+            }
+            position_ += bytes;
+            return true;
+        }
+    };
+
+    // The standard only defines a generator's state through its text form,
+    // so the words are carried over from that
+    void WriteEngine(Writer& writer, const std::mt19937& engine) {
+        std::ostringstream text;
+        text << engine;
+        std::istringstream words(text.str());
+        std::vector<uint32_t> values{std::istream_iterator<uint32_t>(words), std::istream_iterator<uint32_t>()};
+        writer.U16(static_cast<uint16_t>(values.size()));
+        for (uint32_t value : values) {
+            writer.U32(value);
+        }
+    }
+
+    bool ReadEngine(Reader& reader, std::mt19937& engine) {
+        uint16_t count = reader.U16();
+        if (count == 0 || count > kMaxEngineWords || !reader.Has(count * 4u)) {
+            return false;
+        }
+        std::ostringstream text;
+        for (uint16_t i = 0; i < count; ++i) {
+            text << (i ? " " : "") << reader.U32();
+        }
+        std::istringstream in(text.str());
+        in >> engine;
+        return !in.fail();
+    }
+
+    bool InGrid(int x, int y, uint32_t width, uint32_t height) {
+        return x >= 0 && y >= 0 && static_cast<uint32_t>(x) < width && static_cast<uint32_t>(y) < height;
+    }
+}
+
+void GameSnapshot::CaptureSnake(const Snake& snake) {
+    head_x = snake.head_x;
+    head_y = snake.head_y;
+    speed = snake.speed;
+    direction = snake.direction;
+    size = snake.size;
+    alive = snake.alive;
+    growing = snake.IsGrowing();
+    body.assign(snake.body.begin(), snake.body.end());
+}
+
+void GameSnapshot::RestoreSnake(Snake& snake) const {
+    snake.Reset();
+    snake.head_x = head_x;
+    snake.head_y = head_y;
+    snake.speed = speed;
+    snake.direction = direction;
+    snake.size = size;
+    snake.alive = alive;
+    snake.RestoreBody(body);
+    if (growing) {
+        snake.GrowBody();
+    }
+}
+
+void GameSnapshot::CaptureObstacles(const ObstacleManager& manager) {
+    manager.CaptureObstacles(obstacles);
+    difficulty_level = manager.GetDifficultyLevel();
+    moving_obstacle_speed = manager.GetMovingObstacleSpeed();
+    spawn_rate = manager.GetSpawnRate();
+    spawn_timer = manager.GetSpawnTimer();
+    noise_seed = manager.GetNoiseSeed();
+    obstacle_engine = manager.GetRandomEngine();
+}
+
+void GameSnapshot::RestoreObstacles(ObstacleManager& manager) const {
+    manager.SetNoiseSeed(noise_seed); // First, so restored drifters get this field
+    manager.RestoreObstacles(obstacles);
+    manager.RestoreSpawnState(difficulty_level, moving_obstacle_speed, spawn_rate, spawn_timer);
+    manager.SetRandomEngine(obstacle_engine);
+}
+
+namespace GameSnapshotFile {
+
+void Encode(const GameSnapshot& snapshot, std::vector<uint8_t>& out) {
+    out.assign(kHeaderSize, 0);
+    Writer writer(out);
+    writer.U32(snapshot.grid_width);
+    writer.U32(snapshot.grid_height);
+    std::size_t name_length = std::min<std::size_t>(snapshot.player_name.size(), UINT16_MAX);
+    writer.U16(static_cast<uint16_t>(name_length));
+    out.insert(out.end(), snapshot.player_name.begin(), snapshot.player_name.begin() + name_length);
+    writer.U32(static_cast<uint32_t>(snapshot.score));
+    writer.U64(snapshot.ticks);
+
+    writer.F32(snapshot.head_x);
+    writer.F32(snapshot.head_y);
+    writer.F32(snapshot.speed);
+    writer.U8(static_cast<uint8_t>(snapshot.direction));
+    writer.U8(snapshot.alive ? 1 : 0);
+    writer.U8(snapshot.growing ? 1 : 0);
+    writer.U8(0);
+    writer.U32(static_cast<uint32_t>(snapshot.size));
+    writer.U32(static_cast<uint32_t>(snapshot.body.size()));
+    for (const SDL_Point& cell : snapshot.body) {
+        writer.U16(static_cast<uint16_t>(cell.x));
+        writer.U16(static_cast<uint16_t>(cell.y));
+    }
+    writer.U16(static_cast<uint16_t>(snapshot.food.x));
+    writer.U16(static_cast<uint16_t>(snapshot.food.y));
+
+    writer.U32(static_cast<uint32_t>(snapshot.difficulty_level));
+    writer.F32(snapshot.moving_obstacle_speed);
+    writer.F32(snapshot.spawn_rate);
+    writer.F32(snapshot.spawn_timer);
+    writer.U32(static_cast<uint32_t>(snapshot.obstacles.size()));
+    for (const auto& obstacle : snapshot.obstacles) {
+        writer.U16(static_cast<uint16_t>(obstacle.x));
+        writer.U16(static_cast<uint16_t>(obstacle.y));
+        writer.U8(static_cast<uint8_t>(obstacle.type));
+        writer.U8(static_cast<uint8_t>(obstacle.pattern));
+        writer.U8(static_cast<uint8_t>(static_cast<int8_t>(obstacle.direction)));
+        writer.U8(0);
+        writer.F32(obstacle.movement_counter);
+        writer.F32(obstacle.speed);
+        writer.F32(obstacle.lifetime);
+        writer.F32(obstacle.exact_x);
+        writer.F32(obstacle.exact_y);
+        writer.F32(obstacle.velocity_x);
+        writer.F32(obstacle.velocity_y);
+    }
+
+    WriteEngine(writer, snapshot.food_engine);
+    WriteEngine(writer, snapshot.obstacle_engine);
+    WriteEngine(writer, snapshot.random_walk_engine);
+    writer.U32(snapshot.noise_seed);
+
+    // Header last: it covers the payload
+    std::size_t payload_size = out.size() - kHeaderSize;
+    uint8_t* header = out.data();
+    std::memcpy(header, kSnapshotMagic, 4);
+    PutU16(header + 4, kVersion);
+    PutU16(header + 6, 0);
+    PutU64(header + 8, snapshot.config_fingerprint);
+    PutU32(header + 16, static_cast<uint32_t>(payload_size));
+    PutU32(header + 20, Checksum::Crc32(out.data() + kHeaderSize, payload_size));
+}
+
+bool Decode(const uint8_t* data, std::size_t length, GameSnapshot& snapshot) {
+    if (length < kHeaderSize || std::memcmp(data, kSnapshotMagic, 4) != 0) {
+        return false;
+    }
+    Reader header(data + 4, kHeaderSize - 4);
+    uint16_t version = header.U16();
+    header.U16();
+    uint64_t fingerprint = header.U64();
+    uint32_t payload_size = header.U32();
+    uint32_t crc = header.U32();
+    if (version < 1 || version > kVersion || payload_size != length - kHeaderSize ||
+        crc != Checksum::Crc32(data + kHeaderSize, payload_size)) {
+        return false;
+    }
+
+    Reader reader(data + kHeaderSize, payload_size);
+    snapshot.config_fingerprint = fingerprint;
+    snapshot.grid_width = reader.U32();
+    snapshot.grid_height = reader.U32();
+    const uint32_t width = snapshot.grid_width;
+    const uint32_t height = snapshot.grid_height;
+    const uint64_t cell_count = static_cast<uint64_t>(width) * height;
+    if (width == 0 || height == 0 || width > UINT16_MAX || height > UINT16_MAX) {
+        return false;
+    }
+
+    uint16_t name_length = reader.U16();
+    if (!reader.Has(name_length)) {
+        return false;
+    }
+    snapshot.player_name.clear();
+    for (uint16_t i = 0; i < name_length; ++i) {
+        snapshot.player_name.push_back(static_cast<char>(reader.U8()));
+    }
+    snapshot.score = static_cast<int32_t>(reader.U32());
+    snapshot.ticks = reader.U64();
+
+    snapshot.head_x = reader.F32();
+    snapshot.head_y = reader.F32();
+    snapshot.speed = reader.F32();
+    uint8_t direction = reader.U8();
+    snapshot.alive = reader.U8() != 0;
+    snapshot.growing = reader.U8() != 0;
+    reader.U8();
+    snapshot.size = static_cast<int32_t>(reader.U32());
+    uint32_t body_length = reader.U32();
+    if (direction > static_cast<uint8_t>(Snake::Direction::kRight) ||
+        !(snapshot.head_x >= 0 && snapshot.head_x < width) ||
+        !(snapshot.head_y >= 0 && snapshot.head_y < height) ||
+        body_length > cell_count || !reader.Has(body_length * 4ull)) {
+        return false;
+    }
+    snapshot.direction = static_cast<Snake::Direction>(direction);
+    snapshot.body.clear();
+    for (uint32_t i = 0; i < body_length; ++i) {
+        SDL_Point cell{reader.U16(), reader.U16()}; // Braced lists evaluate left to right
+        if (!InGrid(cell.x, cell.y, width, height)) {
+            return false;
+        }
+        snapshot.body.push_back(cell);
+    }
+    snapshot.food.x = reader.U16();
+    snapshot.food.y = reader.U16();
+
+    snapshot.difficulty_level = static_cast<int32_t>(reader.U32());
+    snapshot.moving_obstacle_speed = reader.F32();
+    snapshot.spawn_rate = reader.F32();
+    snapshot.spawn_timer = reader.F32();
+    uint32_t obstacle_count = reader.U32();
+    const std::size_t obstacle_size = version == 1 ? kObstacleSizeV1 : kObstacleSize;
+    if (!InGrid(snapshot.food.x, snapshot.food.y, width, height) ||
+        obstacle_count > cell_count || !reader.Has(obstacle_count * obstacle_size)) {
+        return false;
+    }
+    snapshot.obstacles.clear();
+    for (uint32_t i = 0; i < obstacle_count; ++i) {
+        ObstacleManager::ObstacleState obstacle;
+        obstacle.x = reader.U16();
+        obstacle.y = reader.U16();
+        uint8_t type = reader.U8();
+        uint8_t pattern = reader.U8();
+        obstacle.direction = static_cast<int8_t>(reader.U8());
+        reader.U8();
+        obstacle.movement_counter = reader.F32();
+        obstacle.speed = reader.F32();
+        obstacle.lifetime = reader.F32();
+        if (version == 1) {
+            // Before FLOCKING and NOISE_DRIFT: at rest in the middle of its cell
+            obstacle.exact_x = obstacle.x + 0.5f;
+            obstacle.exact_y = obstacle.y + 0.5f;
+            obstacle.velocity_x = 0.0f;
+            obstacle.velocity_y = 0.0f;
+        } else {
+            obstacle.exact_x = reader.F32();
+            obstacle.exact_y = reader.F32();
+            obstacle.velocity_x = reader.F32();
+            obstacle.velocity_y = reader.F32();
+        }
+        if (!InGrid(obstacle.x, obstacle.y, width, height) ||
+            type > static_cast<uint8_t>(ObstacleType::MOVING) || pattern >= kMovementPatternCount ||
+            !(obstacle.exact_x >= 0 && obstacle.exact_x < width) ||
+            !(obstacle.exact_y >= 0 && obstacle.exact_y < height) ||
+            !std::isfinite(obstacle.velocity_x) || !std::isfinite(obstacle.velocity_y)) {
+            return false;
+        }
+        obstacle.type = static_cast<ObstacleType>(type);
+        obstacle.pattern = static_cast<MovementPattern>(pattern);
+        snapshot.obstacles.push_back(obstacle);
+    }
+
+    if (!ReadEngine(reader, snapshot.food_engine) || !ReadEngine(reader, snapshot.obstacle_engine) ||
+        !ReadEngine(reader, snapshot.random_walk_engine)) {
+        return false;
+    }
+
+    if (version == 3 || version == 4) {
+        // Obstacle-batch state these versions saved for a path the game
+        // never runs
+        bool has_engine = reader.U8() != 0;
+        reader.U8();
+        reader.U16();
+        reader.F32();
+        reader.U32();
+        reader.U32();
+        std::mt19937 unused;
+        if (has_engine && !ReadEngine(reader, unused)) {
+            return false;
+        }
+    }
+    snapshot.noise_seed = version >= 4 ? reader.U32() : kLegacyNoiseSeed;
+    return reader.Ok() && reader.AtEnd();
+}
+
+bool Write(const std::string& path, const GameSnapshot& snapshot) {
+    std::vector<uint8_t> bytes;
+    Encode(snapshot, bytes);
+    return AtomicFile::WriteFile(path, bytes.data(), bytes.size());
+}
+
+bool Read(const std::string& path, GameSnapshot& snapshot) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    if (!Decode(bytes.data(), bytes.size(), snapshot)) {
+        std::cerr << "Warning: ignoring invalid saved game " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace GameSnapshotFile
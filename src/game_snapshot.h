@@ -0,0 +1,102 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include "SDL.h"
+#include "obstacle_manager.h"
+#include "snake.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Everything needed to resume a game exactly where it was saved. Capturing
+// one only copies plain values (a few KB, mostly the three generators), so
+// it is cheap enough for the game thread; encoding and writing it happen
+// on SnapshotWriter's thread. The vectors keep their capacity when a
+// snapshot is captured again, so a reused snapshot stops allocating.
+struct GameSnapshot {
+    uint64_t config_fingerprint{0}; // BoardConfig::Fingerprint of the board played
+    uint32_t grid_width{0};
+    uint32_t grid_height{0};
+    std::string player_name;
+    int32_t score{0};
+    uint64_t ticks{0}; // Fixed updates played (headless simulations; 0 from the game)
+
+    // Snake
+    float head_x{0};
+    float head_y{0};
+    float speed{0};
+    Snake::Direction direction{Snake::Direction::kUp};
+    int32_t size{1};
+    bool alive{true};
+    bool growing{false};
+    std::vector<SDL_Point> body; // Tail first
+
+    SDL_Point food{0, 0};
+
+    // Obstacles in update order, and the spawning state behind new ones
+    std::vector<ObstacleManager::ObstacleState> obstacles;
+    int32_t difficulty_level{1};
+    float moving_obstacle_speed{0};
+    float spawn_rate{0};
+    float spawn_timer{0};
+    uint32_t noise_seed{0}; // The level's NOISE_DRIFT field (ObstacleManager::SetNoiseSeed)
+
+    // Generators: food placement, obstacle placement, random-walk movement
+    std::mt19937 food_engine;
+    std::mt19937 obstacle_engine;
+    std::mt19937 random_walk_engine;
+
+    // The parts Game and Simulation share
+    void CaptureSnake(const Snake& snake);
+    void RestoreSnake(Snake& snake) const;
+    void CaptureObstacles(const ObstacleManager& manager);
+    void RestoreObstacles(ObstacleManager& manager) const;
+};
+
+// Snapshot file layout, version 5 (all integers little-endian, floats as
+// their IEEE-754 bits):
+//   header  : "SNKS", u16 version, u16 reserved, u64 config fingerprint,
+//             u32 payload size, u32 CRC-32 of the payload
+//   payload : u32 grid width, u32 grid height, u16 name length + name,
+//             i32 score, u64 ticks,
+//             snake  f32 head x, f32 head y, f32 speed, u8 direction,
+//                    u8 alive, u8 growing, u8 reserved, i32 size,
+//                    u32 body length + u16 x, u16 y per cell,
+//             u16 food x, u16 food y,
+//             i32 difficulty level, f32 moving speed, f32 spawn rate,
+//             f32 spawn timer,
+//             u32 obstacle count + 36 bytes each (u16 x, u16 y, u8 type,
+//                    u8 pattern, i8 direction, u8 reserved,
+//                    f32 movement counter, f32 speed, f32 lifetime,
+//                    f32 exact x, f32 exact y, f32 velocity x,
+//                    f32 velocity y),
+//             3 generators, each u16 word count + u32 words,
+//             u32 noise seed
+//
+// Older files still load. Version 1 has 20-byte obstacles (without the
+// flock fields). Versions 3 and 4 have a block after the generators that
+// is skipped: 16 bytes, then a generator if its first byte is nonzero.
+// Before version 4 there is no noise seed; those games drifted on
+// kLegacyNoiseSeed.
+//
+// Files are replaced atomically (AtomicFile), so a crash while saving
+// leaves the previous snapshot.
+namespace GameSnapshotFile {
+    constexpr uint16_t kVersion = 5;
+    constexpr uint32_t kLegacyNoiseSeed = 0x5EEDF1E1u;
+    constexpr std::size_t kHeaderSize = 24;
+
+    // `out` is reused: it only grows
+    void Encode(const GameSnapshot& snapshot, std::vector<uint8_t>& out);
+
+    // False for a truncated, corrupt or newer file, or one whose contents
+    // do not fit its own board
+    bool Decode(const uint8_t* data, std::size_t length, GameSnapshot& snapshot);
+
+    bool Write(const std::string& path, const GameSnapshot& snapshot);
+    bool Read(const std::string& path, GameSnapshot& snapshot); // False if missing or invalid
+}
+
+#endif
@@ -1,67 +1,161 @@
 #include "highscore_manager.h"
+#include "score_csv.h"
+#include "timestamp_format.h"
 #include <fstream>
-#include <sstream>
 #include <algorithm>
+#include <cstdio>
 #include <iostream>
-#include <chrono>
-#include <iomanip>
 #include <stdexcept>
 
-HighScoreManager::HighScoreManager(const std::string& filename)
-    : filename_(filename) {
-    LoadScores();
+HighScoreManager::Partition::Partition(const BoardConfig& config, const std::string& path)
+    : board(config), filename(path),
+      log(std::make_unique<ScoreLog>(path)),
+      writer(std::make_unique<ScoreWriter>(*log)),
+      leaderboard(kTopScoresCached) {}
+
+HighScoreManager::HighScoreManager(const std::string& filename, const std::string& legacyFilename,
+                                   const BoardConfig& board)
+    : filename_(filename), legacyFilename_(legacyFilename) {
+    SelectBoard(board);
 }
 
-HighScoreManager::~HighScoreManager() = default;
+HighScoreManager::~HighScoreManager() {
+    ClosePartitions();
+}
 
 HighScoreManager::HighScoreManager(HighScoreManager&& other) noexcept
-    : filename_(std::move(other.filename_)), scores_(std::move(other.scores_)) {}
+    : filename_(std::move(other.filename_)), legacyFilename_(std::move(other.legacyFilename_)),
+      partitions_(std::move(other.partitions_)), active_(other.active_) {
+    other.partitions_.clear();
+    other.active_ = nullptr;
+}
 
 HighScoreManager& HighScoreManager::operator=(HighScoreManager&& other) noexcept {
     if (this != &other) {
+        ClosePartitions();
         filename_ = std::move(other.filename_);
-        scores_ = std::move(other.scores_);
+        legacyFilename_ = std::move(other.legacyFilename_);
+        partitions_ = std::move(other.partitions_);
+        active_ = other.active_;
+        other.partitions_.clear();
+        other.active_ = nullptr;
+        displayRowsValid_ = false;
     }
     return *this;
 }
 
-void HighScoreManager::LoadScores() {
-    scores_.clear();
+void HighScoreManager::SelectBoard(const BoardConfig& board) {
+    if (active_ && active_->board == board) {
+        return;
+    }
+    displayRowsValid_ = false;
 
-    if (!FileExists(filename_)) {
-        CreateEmptyFile();
+    auto found = partitions_.find(board.Fingerprint());
+    if (found != partitions_.end()) {
+        active_ = found->second.get();
         return;
     }
 
-    std::ifstream file(filename_);
-    if (!file.is_open()) {
-        std::cerr << "Warning: Could not open scores file: " << filename_ << std::endl;
+    // First use of this board: open and load only its log
+    auto partition = std::make_unique<Partition>(board, GetBoardFilename(board));
+    LoadPartition(*partition);
+    partition->writer->Start();
+    active_ = partition.get();
+    partitions_.emplace(board.Fingerprint(), std::move(partition));
+}
+
+const BoardConfig& HighScoreManager::GetBoard() const {
+    return active_->board;
+}
+
+std::string HighScoreManager::GetBoardFilename(const BoardConfig& board) const {
+    if (board.IsDefault()) {
+        return filename_;
+    }
+    // "scores.bin" -> "scores-<fingerprint>.bin"
+    std::string::size_type slash = filename_.find_last_of('/');
+    std::string::size_type dot = filename_.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = filename_.size();
+    }
+    return filename_.substr(0, dot) + "-" + board.FingerprintHex() + filename_.substr(dot);
+}
+
+void HighScoreManager::ClosePartitions() {
+    for (auto& item : partitions_) {
+        Partition& partition = *item.second;
+        if (partition.writer) {
+            partition.writer->Stop();
+        }
+        FlushIndex(partition);
+    }
+    partitions_.clear();
+    active_ = nullptr;
+}
+
+void HighScoreManager::LoadScores() {
+    active_->writer->Flush();
+    LoadPartition(*active_);
+}
+
+void HighScoreManager::LoadPartition(Partition& partition) {
+    partition.leaderboard.Clear();
+    partition.indexedRecords = 0;
+
+    ScoreLog& log = *partition.log;
+    if (!log.IsOpen()) {
         return;
     }
 
-    std::string line;
-    std::getline(file, line);
+    // Held throughout, so only one instance imports the legacy file and the
+    // index matches the records it is replayed against
+    ScoreLog::Lock lock(log);
+    log.CatchUp();
+    log.TakeReset();
 
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
+    if (partition.board.IsDefault() && !legacyFilename_.empty() && FileExists(legacyFilename_)) {
+        ImportLegacyScores(partition);
+    }
 
-        std::stringstream ss(line);
-        std::string name, scoreStr, timestamp;
+    // Start from the persisted aggregates, then replay only the records
+    // appended after they were written (normally none)
+    ScoreIndex index;
+    uint64_t covered = 0;
+    if (log.ReadIndex(index) && index.covered_records <= log.GetRecordCount()) {
+        partition.leaderboard.Restore(index);
+        covered = index.covered_records;
+    }
 
-        if (std::getline(ss, name, ',') &&
-            std::getline(ss, scoreStr, ',') &&
-            std::getline(ss, timestamp)) {
+    log.ReadRecords(covered, [&partition](const ScoreView& entry) { partition.leaderboard.Add(entry); });
+    log.MarkRead();
+    partition.indexedRecords = covered;
+    FlushIndex(partition);
+}
 
-            try {
-                int score = std::stoi(scoreStr);
-                scores_.emplace_back(name, score, timestamp);
-            } catch (const std::exception& e) {
-                std::cerr << "Warning: Invalid score entry: " << line << std::endl;
-            }
-        }
+bool HighScoreManager::RefreshScores() {
+    ScoreLog& log = *active_->log;
+    if (!log.IsOpen() || !log.HasExternalChanges()) {
+        return false;
     }
+    active_->writer->Flush();
+    ScoreLog::Lock lock(log);
+    return MergeExternalChanges(*active_);
+}
 
-    SortScores();
+// Call with the log locked and the writer idle
+bool HighScoreManager::MergeExternalChanges(Partition& partition) {
+    partition.log->CatchUp();
+    bool changed = false;
+    if (partition.log->TakeReset()) {
+        partition.leaderboard.Clear();
+        partition.indexedRecords = 0;
+        changed = true;
+    }
+    uint64_t before = partition.leaderboard.GetTotalCount();
+    partition.log->ReadExternalRecords([&partition](const ScoreView& entry) {
+        partition.leaderboard.Add(entry);
+    });
+    return changed || partition.leaderboard.GetTotalCount() != before;
 }
 
 void HighScoreManager::SaveScore(const std::string& name, int score) {
@@ -74,71 +168,134 @@ void HighScoreManager::SaveScore(const std::string& name, int score) {
         throw std::invalid_argument("Invalid player name: " + name);
     }
 
-    std::string timestamp = GetCurrentTimestamp();
-    scores_.emplace_back(sanitizedName, score, timestamp);
-
-    SortScores();
-    TrimScores();
-
-    std::ofstream file(filename_);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open scores file for writing: " + filename_);
+    if (!active_->log->IsOpen()) {
+        throw std::runtime_error("Could not open score log for writing: " + active_->filename);
     }
 
-    file << "PlayerName,Score,Timestamp\n";
-    for (const auto& entry : scores_) {
-        file << entry.playerName << "," << entry.score << "," << entry.timestamp << "\n";
-    }
-
-    if (file.fail()) {
-        throw std::runtime_error("Error writing to scores file: " + filename_);
-    }
+    // The leaderboard updates now; the record is appended in the background
+    // and the index is brought up to date lazily
+    ScoreEntry entry(sanitizedName, score, TimestampFormat::Now());
+    active_->leaderboard.Add(entry);
+    active_->writer->Enqueue(std::move(entry));
 }
 
 std::vector<ScoreEntry> HighScoreManager::GetTopScores(std::size_t count) const {
-    std::size_t actualCount = std::min(count, scores_.size());
-    return std::vector<ScoreEntry>(scores_.begin(), scores_.begin() + actualCount);
+    return active_->leaderboard.GetTop(count);
 }
 
+const std::vector<ScoreDisplayRow>& HighScoreManager::GetTopScoreRows(std::size_t count) const {
+    const Leaderboard& leaderboard = active_->leaderboard;
+    if (displayRowsValid_ && displayRowsVersion_ == leaderboard.GetTopVersion() &&
+        displayRowsCount_ == count) {
+        return displayRows_;
+    }
+
+    displayRows_.clear();
+    for (const auto& entry : leaderboard.GetTop(count)) {
+        ScoreDisplayRow row;
+        row.rank = std::to_string(displayRows_.size() + 1) + ".";
+        row.playerName = entry.playerName.length() > 15
+            ? entry.playerName.substr(0, 12) + "..."
+            : entry.playerName;
+        row.score = std::to_string(entry.score);
+        row.date = FormatTimestamp(entry.timestamp);
+        displayRows_.push_back(std::move(row));
+    }
+    displayRowsVersion_ = leaderboard.GetTopVersion();
+    displayRowsCount_ = count;
+    displayRowsValid_ = true;
+    return displayRows_;
+}
 
 bool HighScoreManager::IsNewHighestScore(int score) const {
-    if (scores_.empty()) {
+    const ScoreEntry* highest = active_->leaderboard.GetHighest();
+    if (highest == nullptr) {
         return true; // First score ever is always the highest
     }
 
     // Check if this score is higher than the current highest score
-    return score > scores_.front().score;
+    return score > highest->score;
 }
 
 std::size_t HighScoreManager::GetScoreCount() const {
-    return scores_.size();
+    return static_cast<std::size_t>(active_->leaderboard.GetTotalCount());
 }
 
-void HighScoreManager::ClearScores() {
-    scores_.clear();
-    CreateEmptyFile();
+uint64_t HighScoreManager::GetRank(int score) const {
+    return active_->leaderboard.GetRank(score);
 }
 
-std::string HighScoreManager::GetCurrentTimestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
+bool HighScoreManager::GetPlayerBest(const std::string& name, ScoreEntry& best) const {
+    const ScoreEntry* entry = active_->leaderboard.GetPlayerBest(SanitizePlayerName(name));
+    if (entry == nullptr) {
+        return false;
+    }
+    best = *entry;
+    return true;
+}
 
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d_%H:%M:%S");
-    return ss.str();
+void HighScoreManager::ClearScores() {
+    active_->writer->Flush();
+    active_->leaderboard.Clear();
+    active_->indexedRecords = 0;
+    active_->log->Clear(); // Other instances notice the new generation and clear too
 }
 
-void HighScoreManager::SortScores() {
-    std::sort(scores_.begin(), scores_.end(),
-              [](const ScoreEntry& a, const ScoreEntry& b) {
-                  return a.score > b.score;
-              });
+// Call with the writer idle
+void HighScoreManager::FlushIndex(Partition& partition) {
+    ScoreLog& log = *partition.log;
+    if (!log.IsOpen()) {
+        return;
+    }
+    // The index must cover every record in the log, including other
+    // instances' appends
+    ScoreLog::Lock lock(log);
+    MergeExternalChanges(partition);
+    if (partition.indexedRecords == log.GetRecordCount()) {
+        return;
+    }
+    ScoreIndex index;
+    partition.leaderboard.Snapshot(index);
+    index.covered_records = log.GetRecordCount();
+    if (log.WriteIndex(index)) {
+        partition.indexedRecords = log.GetRecordCount();
+    }
 }
 
-void HighScoreManager::TrimScores() {
-    if (scores_.size() > kMaxScores) {
-        scores_.resize(kMaxScores);
+std::size_t HighScoreManager::ImportLegacyScores(Partition& partition) {
+    // The file is renamed before its rows are appended, so it is imported
+    // once: a later start (or a ClearScores) never brings its scores back
+    const std::string imported = legacyFilename_ + ".imported";
+    if (std::rename(legacyFilename_.c_str(), imported.c_str()) != 0) {
+        std::cerr << "Warning: Could not rename " << legacyFilename_ << " to " << imported
+                  << "; its scores were not imported" << std::endl;
+        return 0;
+    }
+
+    // Rows go straight from the mapped text file into log records
+    ScoreLog& log = *partition.log;
+    ScoreCsv::ParseStats stats;
+    bool appended = true;
+    uint64_t appended_rows = 0;
+    bool parsed = ScoreCsv::ParseFile(imported,
+        [&log, &appended, &appended_rows](const ScoreView* entries, std::size_t count) {
+            appended = appended && log.AppendBatch(entries, count);
+            appended_rows += appended ? count : 0;
+        }, stats);
+
+    if (!parsed || !appended || !log.Sync()) {
+        if (appended_rows == 0) {
+            std::rename(imported.c_str(), legacyFilename_.c_str()); // Try again next time
+        } else {
+            std::cerr << "Warning: Only part of " << imported << " was imported" << std::endl;
+        }
+        return 0;
     }
+    if (stats.parsed > 0) {
+        std::cout << "Imported " << stats.parsed << " score(s) from " << legacyFilename_
+                  << " into " << partition.filename << " (kept as " << imported << ")" << std::endl;
+    }
+    return static_cast<std::size_t>(stats.parsed);
 }
 
 bool HighScoreManager::FileExists(const std::string& filename) const {
@@ -146,37 +303,44 @@ bool HighScoreManager::FileExists(const std::string& filename) const {
     return file.good();
 }
 
-std::string HighScoreManager::FormatTimestamp(const std::string& timestamp) const {
-    if (timestamp.empty()) return "Unknown";
-
-    // Convert from "2025-09-28_02:12:53" to "Sep 28, 2025 02:12"
-    if (timestamp.length() >= 19) {
-        std::string year = timestamp.substr(0, 4);
-        std::string month = timestamp.substr(5, 2);
-        std::string day = timestamp.substr(8, 2);
-        std::string time = timestamp.substr(11, 5); // HH:MM
-
-        // Convert month number to name
-        const std::vector<std::string> months = {
-            "Jan", "Feb", "Mar", "Apr", "May", "Jun",
-            "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
-        };
+std::string HighScoreManager::FormatTimestamp(int64_t timestamp) const {
+    return TimestampFormat::FormatDisplay(timestamp);
+}
 
-        int monthNum = std::stoi(month) - 1;
-        if (monthNum >= 0 && monthNum < 12) {
-            return months[monthNum] + " " + day + ", " + year + " " + time;
-        }
+bool HighScoreManager::ExportScores(const std::string& path) const {
+    const ScoreLog& log = *active_->log;
+    if (!log.IsOpen()) {
+        return false;
     }
+    active_->writer->Flush();
 
-    return timestamp; // Fallback to original if parsing fails
-}
+    std::string temp_path = path + ".tmp";
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Warning: Could not open export file: " << temp_path << std::endl;
+        return false;
+    }
 
+    // Format into a buffer and write it out in large pieces
+    constexpr std::size_t kFlushThreshold = 1 << 20;
+    std::string buffer(ScoreCsv::kHeaderLine);
+    buffer.reserve(kFlushThreshold + 256);
+    log.ReadRecords(0, [&](const ScoreView& entry) {
+        ScoreCsv::AppendLine(entry, buffer);
+        if (buffer.size() >= kFlushThreshold) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    });
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.close();
 
-void HighScoreManager::CreateEmptyFile() const {
-    std::ofstream file(filename_);
-    if (file.is_open()) {
-        file << "PlayerName,Score,Timestamp\n";
+    if (file.fail() || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Warning: Could not write export file: " << path << std::endl;
+        std::remove(temp_path.c_str());
+        return false;
     }
+    return true;
 }
 
 bool HighScoreManager::IsValidPlayerName(const std::string& name) {
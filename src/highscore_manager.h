@@ -1,14 +1,35 @@
 #ifndef HIGHSCORE_MANAGER_H
 #define HIGHSCORE_MANAGER_H
 
+#include "board_config.h"
 #include "score_entry.h"
+#include "leaderboard.h"
+#include "score_log.h"
+#include "score_writer.h"
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
 class HighScoreManager {
 public:
-    explicit HighScoreManager(const std::string& filename = "scores.txt");
+    // Scores are kept in a binary log; if the legacy CSV file exists, its
+    // entries are imported once and the file is renamed to
+    // "<legacyFilename>.imported" (an empty name disables the import).
+    // Saves update the leaderboard immediately and are written by a
+    // background thread; the destructor waits for outstanding writes. Several game instances may
+    // share one log: appends lock the file and never overwrite each other,
+    // and RefreshScores merges what the other instances saved.
+    //
+    // Each board configuration has its own leaderboard, log and index. The
+    // default board uses `filename` itself (and imports the legacy file);
+    // other boards use `filename` with their fingerprint inserted before the
+    // extension. Boards are loaded on first use, so startup only pays for
+    // the selected one.
+    explicit HighScoreManager(const std::string& filename = "scores.bin",
+                              const std::string& legacyFilename = "scores.txt",
+                              const BoardConfig& board = BoardConfig());
     ~HighScoreManager();
 
     HighScoreManager(const HighScoreManager& other) = delete;
@@ -16,28 +37,70 @@ public:
     HighScoreManager(HighScoreManager&& other) noexcept;
     HighScoreManager& operator=(HighScoreManager&& other) noexcept;
 
+    // Every other method acts on the selected board
+    void SelectBoard(const BoardConfig& board);
+    const BoardConfig& GetBoard() const;
+    std::string GetBoardFilename(const BoardConfig& board) const;
+    std::size_t GetLoadedBoardCount() const { return partitions_.size(); }
+
     void LoadScores();
     void SaveScore(const std::string& name, int score);
+
+    // Merges scores saved (or a clear made) by other instances sharing the
+    // log. Costs one fstat and a header read when nothing changed; returns
+    // true if the leaderboard changed.
+    bool RefreshScores();
+
     std::vector<ScoreEntry> GetTopScores(std::size_t count = 10) const;
+
+    // Formatted once per leaderboard change, so drawing the scores screen
+    // does no formatting or parsing
+    const std::vector<ScoreDisplayRow>& GetTopScoreRows(std::size_t count = 10) const;
     bool IsNewHighestScore(int score) const;
-    std::size_t GetScoreCount() const;
+    std::size_t GetScoreCount() const; // Every score ever recorded
+    uint64_t GetRank(int score) const; // 1-based, ties share a rank
+    bool GetPlayerBest(const std::string& name, ScoreEntry& best) const;
     void ClearScores();
 
-    std::string FormatTimestamp(const std::string& timestamp) const;
+    std::string FormatTimestamp(int64_t timestamp) const;
+
+    // Writes every recorded score to a text file (the format of scores.txt)
+    bool ExportScores(const std::string& path) const;
 
     static bool IsValidPlayerName(const std::string& name);
     static std::string SanitizePlayerName(const std::string& name);
 
 private:
+    // One board's scores
+    struct Partition {
+        BoardConfig board;
+        std::string filename;
+        std::unique_ptr<ScoreLog> log;
+        std::unique_ptr<ScoreWriter> writer; // Sole user of log while running
+        Leaderboard leaderboard;
+        uint64_t indexedRecords{0}; // Log records covered by the persisted index
+
+        Partition(const BoardConfig& config, const std::string& path);
+    };
+
     std::string filename_;
-    std::vector<ScoreEntry> scores_;
-    static constexpr std::size_t kMaxScores = 10;
+    std::string legacyFilename_;
+    std::unordered_map<uint64_t, std::unique_ptr<Partition>> partitions_; // By fingerprint
+    Partition* active_{nullptr};
+
+    // Display row cache, rebuilt when the leaderboard's top entries change
+    mutable std::vector<ScoreDisplayRow> displayRows_;
+    mutable uint64_t displayRowsVersion_{0};
+    mutable std::size_t displayRowsCount_{0};
+    mutable bool displayRowsValid_{false};
+    static constexpr std::size_t kTopScoresCached = 100;
 
-    std::string GetCurrentTimestamp() const;
-    void SortScores();
-    void TrimScores();
+    void LoadPartition(Partition& partition);
+    void ClosePartitions();
+    bool MergeExternalChanges(Partition& partition);
+    void FlushIndex(Partition& partition);
+    std::size_t ImportLegacyScores(Partition& partition);
     bool FileExists(const std::string& filename) const;
-    void CreateEmptyFile() const;
 };
 
-#endif
\ No newline at end of file
+#endif
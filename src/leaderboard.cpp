@@ -0,0 +1,149 @@
+#include "leaderboard.h"
+#include <algorithm>
+
+FenwickTree::FenwickTree(std::size_t size)
+    : tree_(size + 1, 0), counts_(size, 0) {}
+
+void FenwickTree::Add(std::size_t index, uint64_t amount) {
+    if (index >= counts_.size()) {
+        Grow(index + 1);
+    }
+    counts_[index] += amount;
+    for (std::size_t i = index + 1; i < tree_.size(); i += i & (~i + 1)) {
+        tree_[i] += amount;
+    }
+}
+
+uint64_t FenwickTree::PrefixSum(std::size_t index) const {
+    uint64_t sum = 0;
+    for (std::size_t i = std::min(index + 1, counts_.size()); i > 0; i -= i & (~i + 1)) {
+        sum += tree_[i];
+    }
+    return sum;
+}
+
+void FenwickTree::Clear() {
+    std::fill(tree_.begin(), tree_.end(), 0);
+    std::fill(counts_.begin(), counts_.end(), 0);
+}
+
+void FenwickTree::Grow(std::size_t min_size) {
+    std::size_t size = std::max<std::size_t>(counts_.size(), 1);
+    while (size < min_size) {
+        size *= 2;
+    }
+    counts_.resize(size, 0);
+
+    // Linear-time rebuild: seed each node with its count, then push it to
+    // the parent that also covers it
+    tree_.assign(size + 1, 0);
+    for (std::size_t i = 1; i <= size; ++i) {
+        tree_[i] += counts_[i - 1];
+        std::size_t parent = i + (i & (~i + 1));
+        if (parent <= size) {
+            tree_[parent] += tree_[i];
+        }
+    }
+}
+
+Leaderboard::Leaderboard(std::size_t top_capacity)
+    : top_capacity_(std::max<std::size_t>(top_capacity, 1)) {
+    top_.reserve(top_capacity_ + 1);
+}
+
+void Leaderboard::Add(const ScoreView& entry) {
+    score_counts_.Add(ScoreBucket(entry.score), 1);
+    ++total_count_;
+    InsertTop(entry);
+    UpdatePlayerBest(entry);
+}
+
+void Leaderboard::Clear() {
+    score_counts_.Clear();
+    total_count_ = 0;
+    top_.clear();
+    ++top_version_;
+    player_bests_.clear();
+    player_best_entries_.clear();
+}
+
+std::vector<ScoreEntry> Leaderboard::GetTop(std::size_t count) const {
+    std::size_t actualCount = std::min(count, top_.size());
+    return std::vector<ScoreEntry>(top_.begin(), top_.begin() + actualCount);
+}
+
+uint64_t Leaderboard::GetRank(int score) const {
+    // Everything in a higher bucket beats this score
+    return total_count_ - score_counts_.PrefixSum(ScoreBucket(score)) + 1;
+}
+
+const ScoreEntry* Leaderboard::GetPlayerBest(const std::string& name) const {
+    auto best = player_bests_.find(name);
+    return best == player_bests_.end() ? nullptr : best->second;
+}
+
+void Leaderboard::Restore(const ScoreIndex& index) {
+    Clear();
+    for (const auto& bucket : index.score_counts) {
+        score_counts_.Add(ScoreBucket(bucket.first), bucket.second);
+        total_count_ += bucket.second;
+    }
+    for (const auto& entry : index.top_entries) {
+        InsertTop(entry);
+    }
+    player_bests_.reserve(index.player_bests.size());
+    for (const auto& entry : index.player_bests) {
+        UpdatePlayerBest(entry);
+    }
+}
+
+void Leaderboard::Snapshot(ScoreIndex& index) const {
+    index.top_entries = top_;
+
+    index.player_bests.assign(player_best_entries_.begin(), player_best_entries_.end());
+
+    // Store only the non-empty buckets
+    index.score_counts.clear();
+    for (std::size_t bucket = 0; bucket < score_counts_.GetSize(); ++bucket) {
+        uint64_t count = score_counts_.GetCount(bucket);
+        if (count > 0) {
+            index.score_counts.emplace_back(static_cast<int32_t>(bucket), count);
+        }
+    }
+}
+
+std::size_t Leaderboard::ScoreBucket(int score) {
+    return static_cast<std::size_t>(std::clamp(score, 0, kMaxTrackedScore));
+}
+
+void Leaderboard::InsertTop(const ScoreView& entry) {
+    // Most scores do not make the cache; reject those without searching
+    if (top_.size() >= top_capacity_ && entry.score <= top_.back().score) {
+        return;
+    }
+    auto position = std::upper_bound(top_.begin(), top_.end(), entry.score,
+                                     [](int score, const ScoreEntry& existing) {
+                                         return score > existing.score;
+                                     });
+    if (static_cast<std::size_t>(position - top_.begin()) >= top_capacity_) {
+        return;
+    }
+    top_.insert(position, entry.ToEntry());
+    if (top_.size() > top_capacity_) {
+        top_.pop_back();
+    }
+    ++top_version_;
+}
+
+void Leaderboard::UpdatePlayerBest(const ScoreView& entry) {
+    auto best = player_bests_.find(entry.playerName);
+    if (best == player_bests_.end()) {
+        player_best_entries_.push_back(entry.ToEntry());
+        ScoreEntry* stored = &player_best_entries_.back();
+        player_bests_.emplace(stored->playerName, stored);
+    } else if (entry.score > best->second->score) {
+        // The name (and so the key) is unchanged
+        best->second->score = entry.score;
+        best->second->timestamp = entry.timestamp;
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "score_entry.h"
+#include "score_log.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Fenwick (binary indexed) tree of counts per score value: O(log n) point
+// updates and prefix sums. Grows by doubling when a larger score arrives.
+class FenwickTree {
+public:
+    explicit FenwickTree(std::size_t size = 1024);
+
+    void Add(std::size_t index, uint64_t amount);
+    uint64_t PrefixSum(std::size_t index) const; // Sum of [0, index]
+    uint64_t GetCount(std::size_t index) const { return index < counts_.size() ? counts_[index] : 0; }
+    std::size_t GetSize() const { return counts_.size(); }
+    void Clear();
+
+private:
+    std::vector<uint64_t> tree_;   // 1-based Fenwick array
+    std::vector<uint64_t> counts_; // Plain per-index counts, kept for growing and export
+
+    void Grow(std::size_t min_size);
+};
+
+// Aggregates over every score ever recorded. Individual entries stay in the
+// score log; in memory we keep a score histogram for rank queries, each
+// player's best entry and a small cache of the top entries.
+class Leaderboard {
+public:
+    explicit Leaderboard(std::size_t top_capacity = 100);
+
+    // Player lookups hold views into player_best_entries_, so copying would
+    // leave them pointing at the source; moving keeps the elements in place
+    Leaderboard(const Leaderboard& other) = delete;
+    Leaderboard& operator=(const Leaderboard& other) = delete;
+    Leaderboard(Leaderboard&& other) = default;
+    Leaderboard& operator=(Leaderboard&& other) = default;
+
+    // Only allocates when the score enters the top cache or is a player's
+    // first or new best
+    void Add(const ScoreView& entry);
+    void Clear();
+
+    // At most the top cache capacity is available
+    std::vector<ScoreEntry> GetTop(std::size_t count) const;
+    const ScoreEntry* GetHighest() const { return top_.empty() ? nullptr : &top_.front(); }
+    uint64_t GetTopVersion() const { return top_version_; } // Changes whenever the top cache does
+
+    // 1-based rank the score holds among all recorded scores (ties share a rank)
+    uint64_t GetRank(int score) const;
+    uint64_t GetTotalCount() const { return total_count_; }
+
+    const ScoreEntry* GetPlayerBest(const std::string& name) const;
+    std::size_t GetPlayerCount() const { return player_best_entries_.size(); }
+
+    // Persistence through the score index
+    void Restore(const ScoreIndex& index);
+    void Snapshot(ScoreIndex& index) const;
+
+    // Scores above this share the last histogram bucket
+    static constexpr int kMaxTrackedScore = (1 << 20) - 1;
+
+private:
+    std::size_t top_capacity_;
+    FenwickTree score_counts_;
+    uint64_t total_count_{0};
+    std::vector<ScoreEntry> top_; // Highest first, equal scores in arrival order
+    uint64_t top_version_{0};
+    std::deque<ScoreEntry> player_best_entries_; // Stable addresses
+    std::unordered_map<std::string_view, ScoreEntry*> player_bests_; // Keys view the entries' names
+
+    static std::size_t ScoreBucket(int score);
+    void InsertTop(const ScoreView& entry);
+    void UpdatePlayerBest(const ScoreView& entry);
+};
+
+#endif
@@ -1,22 +1,224 @@
 #include "controller.h"
 #include "game.h"
 #include "renderer.h"
+#include "frame_recorder.h"
+#include "frame_pacer.h"
+#include "highscore_manager.h"
+#include "board_config.h"
+#include "game_client.h"
+#include "game_server.h"
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <string>
+#include <thread>
 
-int main() {
+namespace {
+  bool ParsePort(const char *text, uint16_t &port) {
+    unsigned long value = 0;
+    char extra = 0;
+    if (std::sscanf(text, "%lu%c", &value, &extra) != 1 || value > 65535) {
+      return false;
+    }
+    port = static_cast<uint16_t>(value);
+    return true;
+  }
+
+  // Headless authoritative server; runs until killed
+  int RunServer(const BoardConfig &config, uint16_t port) {
+    GameServer::Options options;
+    options.port = port;
+    GameServer server(config, options);
+    if (!server.Start()) {
+      return 1;
+    }
+    std::cout << "Serving " << config.Describe() << " on 127.0.0.1:" << server.GetPort() << "\n";
+
+    const auto step = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / config.tickRate));
+    const uint64_t report_ticks = static_cast<uint64_t>(config.tickRate) * 5;
+    auto next_tick = std::chrono::steady_clock::now();
+    while (true) {
+      server.Tick();
+      if (server.GetTicks() >= report_ticks) {
+        std::cout << server.GetClientCount() << " client(s), tick "
+                  << server.GetAverageTickMicroseconds() << " us avg / "
+                  << server.GetMaxTickMicroseconds() << " us max, "
+                  << server.GetAverageStateBytes() << " bytes per client per tick\n";
+        server.ResetStats();
+      }
+      next_tick += step;
+      std::this_thread::sleep_until(next_tick);
+    }
+  }
+
+  // Plays the snake the server hands out; the board comes from the server
+  int RunClient(uint16_t port, std::size_t screen_width, std::size_t screen_height,
+                PacingMode pacingMode, int frames_per_second) {
+    GameClient client;
+    if (!client.Connect(port)) {
+      return 1;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!client.IsReady()) {
+      if (!client.Poll() || std::chrono::steady_clock::now() > deadline) {
+        std::cerr << "No game state from 127.0.0.1:" << port << "\n";
+        return 1;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const int width = static_cast<int>(client.GetFrame().width);
+    const int height = static_cast<int>(client.GetFrame().height);
+    Renderer renderer(screen_width, screen_height, width, height, pacingMode == PacingMode::VSYNC);
+    Controller controller;
+    FramePacer pacer(pacingMode, frames_per_second);
+    pacer.SetDisplayRefreshRate(renderer.GetDisplayRefreshRate());
+    Snake snake(width, height);
+    ObstacleManager obstacles(width, height);
+
+    Uint32 title_timestamp = SDL_GetTicks();
+    int frame_count = 0;
+    bool running = true;
+    while (running) {
+      // Turns start from the server's heading (BuildSnake); the server's
+      // DirectionInput still has the final say on reversing into the body
+      SDL_Event e;
+      Snake::Direction heading = snake.direction;
+      while (SDL_PollEvent(&e)) {
+        if (e.type == SDL_QUIT) {
+          running = false;
+        }
+        controller.HandleInput(e, snake);
+      }
+      if (snake.direction != heading) {
+        client.SendDirection(snake.direction);
+      }
+      if (!client.Poll()) {
+        std::cerr << "Disconnected from the server\n";
+        break;
+      }
+
+      client.BuildSnake(snake);
+      client.BuildObstacles(obstacles);
+      renderer.RenderPlayingWithObstacles(snake, client.GetFood(), obstacles);
+      pacer.EndFrame();
+      frame_count++;
+      Uint32 frame_end = SDL_GetTicks();
+      if (frame_end - title_timestamp >= 1000) {
+        renderer.UpdateWindowTitle(client.GetScore(), frame_count);
+        frame_count = 0;
+        title_timestamp = frame_end;
+      }
+    }
+    std::cout << "Score: " << client.GetScore() << "\n";
+    return 0;
+  }
+}
+
+int main(int argc, char *argv[]) {
   constexpr std::size_t kFramesPerSecond{60};
-  constexpr std::size_t kMsPerFrame{1000 / kFramesPerSecond};
   constexpr std::size_t kScreenWidth{640};
   constexpr std::size_t kScreenHeight{640};
-  constexpr std::size_t kGridWidth{32};
-  constexpr std::size_t kGridHeight{32};
+  constexpr std::size_t kMaxGridSize{16384};
+
+  std::size_t gridWidth{32};
+  std::size_t gridHeight{32};
+  std::string recordSpec;
+  std::string exportPath;
+  std::string savePath;
+  bool useAutopilot{false};
+  bool serve{false};
+  bool connect{false};
+  uint16_t port{0};
+  PacingMode pacingMode{PacingMode::SLEEP_SPIN};
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--record" && i + 1 < argc) {
+      recordSpec = argv[++i];
+    } else if (arg == "--autopilot") {
+      useAutopilot = true;
+    } else if (arg == "--save" && i + 1 < argc) {
+      savePath = argv[++i];
+    } else if ((arg == "--serve" || arg == "--connect") && i + 1 < argc) {
+      if (!ParsePort(argv[++i], port)) {
+        std::cerr << "Invalid " << arg << " value, expected a port number\n";
+        return 1;
+      }
+      serve = arg == "--serve";
+      connect = !serve;
+    } else if (arg == "--export-scores" && i + 1 < argc) {
+      exportPath = argv[++i];
+    } else if (arg == "--pacing" && i + 1 < argc) {
+      if (!FramePacer::ParseMode(argv[++i], pacingMode)) {
+        std::cerr << "Invalid --pacing value, expected vsync, sleep-spin or uncapped\n";
+        return 1;
+      }
+    } else if (arg == "--grid" && i + 1 < argc) {
+      unsigned long width = 0;
+      unsigned long height = 0;
+      if (std::sscanf(argv[++i], "%lux%lu", &width, &height) != 2 ||
+          width < 4 || height < 4 || width > kMaxGridSize || height > kMaxGridSize) {
+        std::cerr << "Invalid --grid value, expected <width>x<height> between 4 and "
+                  << kMaxGridSize << "\n";
+        return 1;
+      }
+      gridWidth = width;
+      gridHeight = height;
+    } else {
+      std::cerr << "Unknown argument: " << arg << "\n";
+      std::cerr << "Usage: SnakeGame [--grid <width>x<height>] [--pacing vsync|sleep-spin|uncapped] [--record png:<dir>|y4m:<file>] [--autopilot] [--save <file>]\n"
+                << "       SnakeGame --export-scores <file.csv>\n"
+                << "       SnakeGame [--grid <width>x<height>] --serve <port>\n"
+                << "       SnakeGame [--pacing vsync|sleep-spin|uncapped] --connect <port>\n";
+      return 1;
+    }
+  }
+
+  if (!exportPath.empty()) {
+    // Exports the leaderboard of the board selected by --grid
+    HighScoreManager scores("scores.bin", "scores.txt",
+                            BoardConfig(static_cast<uint32_t>(gridWidth), static_cast<uint32_t>(gridHeight)));
+    if (!scores.ExportScores(exportPath)) {
+      return 1;
+    }
+    std::cout << "Exported " << scores.GetScoreCount() << " score(s) to " << exportPath << "\n";
+    return 0;
+  }
+
+  if (serve) {
+    return RunServer(BoardConfig(static_cast<uint32_t>(gridWidth), static_cast<uint32_t>(gridHeight)), port);
+  }
+  if (connect) {
+    return RunClient(port, kScreenWidth, kScreenHeight, pacingMode, static_cast<int>(kFramesPerSecond));
+  }
+
+  Renderer renderer(kScreenWidth, kScreenHeight, gridWidth, gridHeight,
+                    pacingMode == PacingMode::VSYNC);
+
+  if (!recordSpec.empty()) {
+    CaptureFormat format;
+    std::string outputPath;
+    if (!FrameRecorder::ParseCaptureSpec(recordSpec, format, outputPath)) {
+      std::cerr << "Invalid --record value: " << recordSpec << "\n";
+      return 1;
+    }
+    renderer.StartRecording(format, outputPath, static_cast<int>(kFramesPerSecond));
+  }
 
-  Renderer renderer(kScreenWidth, kScreenHeight, kGridWidth, kGridHeight);
   Controller controller;
-  Game game(kGridWidth, kGridHeight);
-  game.Run(controller, renderer, kMsPerFrame);
+  Game game(gridWidth, gridHeight);
+  if (useAutopilot) {
+    game.EnableAutopilot();
+  }
+  if (!savePath.empty()) {
+    game.EnableAutosave(savePath);
+  }
+  FramePacer pacer(pacingMode, static_cast<int>(kFramesPerSecond));
+  pacer.SetDisplayRefreshRate(renderer.GetDisplayRefreshRate());
+  game.Run(controller, renderer, pacer);
   std::cout << "Game has terminated successfully!\n";
   std::cout << "Score: " << game.GetScore() << "\n";
   std::cout << "Size: " << game.GetSize() << "\n";
   return 0;
-}
\ No newline at end of file
+}
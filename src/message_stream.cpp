@@ -0,0 +1,211 @@
+#include "message_stream.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    constexpr std::size_t kHeaderSize = 5; // u32 length, u8 type
+    constexpr std::size_t kReadChunk = 16 * 1024;
+
+#ifdef MSG_NOSIGNAL
+    constexpr int kSendFlags = MSG_NOSIGNAL; // A closed peer is an error, not SIGPIPE
+#else
+    constexpr int kSendFlags = 0;
+#endif
+
+    bool Configure(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        int one = 1;
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 &&
+               setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) == 0;
+    }
+
+    sockaddr_in LoopbackAddress(uint16_t port) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+}
+
+namespace LoopbackSocket {
+
+int Listen(uint16_t port, int backlog) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Warning: Could not create a socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in address = LoopbackAddress(port);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, backlog) != 0 || !Configure(fd)) {
+        std::cerr << "Warning: Could not listen on 127.0.0.1:" << port << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+uint16_t GetPort(int fd) {
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+int Accept(int listen_fd) {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            std::cerr << "Warning: Could not accept a client: " << std::strerror(errno) << std::endl;
+        }
+        return -1;
+    }
+    if (!Configure(fd)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int Connect(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Warning: Could not create a socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    // Blocking connect (loopback answers at once), then non-blocking I/O
+    sockaddr_in address = LoopbackAddress(port);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || !Configure(fd)) {
+        std::cerr << "Warning: Could not connect to 127.0.0.1:" << port << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void Close(int fd) {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+}
+
+MessageStream::MessageStream(int fd) : fd_(fd) {}
+
+MessageStream::~MessageStream() {
+    CloseSocket();
+}
+
+void MessageStream::Frame(uint8_t type, const uint8_t* payload, std::size_t length, std::vector<uint8_t>& out) {
+    uint32_t size = static_cast<uint32_t>(length + 1);
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(size >> (8 * i)));
+    }
+    out.push_back(type);
+    out.insert(out.end(), payload, payload + length);
+}
+
+void MessageStream::Send(uint8_t type, const uint8_t* payload, std::size_t length) {
+    if (IsOpen()) {
+        Frame(type, payload, length, outgoing_);
+    }
+}
+
+void MessageStream::SendFramed(const std::vector<uint8_t>& framed) {
+    if (IsOpen()) {
+        outgoing_.insert(outgoing_.end(), framed.begin(), framed.end());
+    }
+}
+
+bool MessageStream::Flush() {
+    while (IsOpen() && sent_ < outgoing_.size()) {
+        ssize_t written = send(fd_, outgoing_.data() + sent_, outgoing_.size() - sent_, kSendFlags);
+        if (written > 0) {
+            sent_ += static_cast<std::size_t>(written);
+            bytes_sent_ += static_cast<uint64_t>(written);
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break; // Socket buffer full; the rest goes on a later Flush
+        } else {
+            CloseSocket();
+        }
+    }
+    if (sent_ == outgoing_.size()) {
+        outgoing_.clear();
+        sent_ = 0;
+    } else if (sent_ > outgoing_.size() / 2) {
+        outgoing_.erase(outgoing_.begin(), outgoing_.begin() + static_cast<std::ptrdiff_t>(sent_));
+        sent_ = 0;
+    }
+    return IsOpen();
+}
+
+bool MessageStream::Receive() {
+    // Drop what was handed out; earlier payload pointers end here
+    if (consumed_ > 0) {
+        incoming_.erase(incoming_.begin(), incoming_.begin() + static_cast<std::ptrdiff_t>(consumed_));
+        consumed_ = 0;
+    }
+    uint8_t chunk[kReadChunk];
+    while (IsOpen()) {
+        ssize_t received = recv(fd_, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            incoming_.insert(incoming_.end(), chunk, chunk + received);
+            bytes_received_ += static_cast<uint64_t>(received);
+        } else if (received < 0 && errno == EINTR) {
+            continue;
+        } else if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            CloseSocket(); // Peer closed (0) or failed
+        }
+    }
+    return IsOpen();
+}
+
+bool MessageStream::NextMessage(uint8_t& type, const uint8_t*& payload, std::size_t& length) {
+    std::size_t available = incoming_.size() - consumed_;
+    if (available < kHeaderSize) {
+        return false;
+    }
+    const uint8_t* header = incoming_.data() + consumed_;
+    uint32_t size = static_cast<uint32_t>(header[0]) | static_cast<uint32_t>(header[1]) << 8 |
+                    static_cast<uint32_t>(header[2]) << 16 | static_cast<uint32_t>(header[3]) << 24;
+    if (size == 0 || size > kMaxMessageSize) {
+        std::cerr << "Warning: Closing a connection that sent a " << size << "-byte message" << std::endl;
+        CloseSocket();
+        incoming_.clear();
+        consumed_ = 0;
+        return false;
+    }
+    if (available < 4 + static_cast<std::size_t>(size)) {
+        return false;
+    }
+    type = header[4];
+    payload = header + kHeaderSize;
+    length = size - 1;
+    consumed_ += 4 + size;
+    return true;
+}
+
+void MessageStream::CloseSocket() {
+    LoopbackSocket::Close(fd_);
+    fd_ = -1;
+}
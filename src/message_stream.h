@@ -0,0 +1,71 @@
+#ifndef MESSAGE_STREAM_H
+#define MESSAGE_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Loopback TCP sockets for GameServer and GameClient (POSIX). Descriptors
+// are returned non-blocking with Nagle's algorithm off, so a tick's state
+// goes out at once; -1 means failure (reported on std::cerr).
+namespace LoopbackSocket {
+    // Listens on 127.0.0.1:port; port 0 picks a free one (see GetPort)
+    int Listen(uint16_t port, int backlog = 256);
+    uint16_t GetPort(int fd);
+    int Accept(int listen_fd); // -1 with nothing pending too
+    int Connect(uint16_t port);
+    void Close(int fd);
+}
+
+// Length-prefixed messages over one non-blocking socket: u32 length (of
+// what follows), u8 type, payload. Sends are queued and written by Flush
+// as far as the socket takes them; Receive reads what has arrived and
+// NextMessage hands out complete messages without copying them.
+class MessageStream {
+public:
+    static constexpr uint32_t kMaxMessageSize = 16u << 20;
+
+    explicit MessageStream(int fd); // Takes ownership
+    ~MessageStream();
+
+    // Rule of Five - owns a descriptor, neither copyable nor movable
+    MessageStream(const MessageStream& other) = delete;
+    MessageStream& operator=(const MessageStream& other) = delete;
+    MessageStream(MessageStream&& other) = delete;
+    MessageStream& operator=(MessageStream&& other) = delete;
+
+    // Appends a whole message (header included) to `out`, for sending the
+    // same bytes to many streams with SendFramed
+    static void Frame(uint8_t type, const uint8_t* payload, std::size_t length, std::vector<uint8_t>& out);
+
+    void Send(uint8_t type, const uint8_t* payload, std::size_t length);
+    void SendFramed(const std::vector<uint8_t>& framed);
+    bool Flush(); // False once the connection failed
+
+    // Reads everything available; false once the peer closed or the
+    // connection failed (messages already read can still be taken)
+    bool Receive();
+
+    // The next complete message; `payload` stays valid until the next
+    // Receive. False when none is complete (or one is oversized, which
+    // also closes the stream).
+    bool NextMessage(uint8_t& type, const uint8_t*& payload, std::size_t& length);
+
+    bool IsOpen() const { return fd_ >= 0; }
+    std::size_t GetPendingBytes() const { return outgoing_.size() - sent_; }
+    uint64_t GetBytesSent() const { return bytes_sent_; }
+    uint64_t GetBytesReceived() const { return bytes_received_; }
+
+private:
+    int fd_;
+    std::vector<uint8_t> outgoing_;
+    std::size_t sent_{0};      // Bytes of outgoing_ already written
+    std::vector<uint8_t> incoming_;
+    std::size_t consumed_{0};  // Bytes of incoming_ already handed out
+    uint64_t bytes_sent_{0};
+    uint64_t bytes_received_{0};
+
+    void CloseSocket();
+};
+
+#endif
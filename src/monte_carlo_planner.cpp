@@ -0,0 +1,177 @@
+#include "monte_carlo_planner.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+  constexpr Snake::Direction kDirections[] = {Snake::Direction::kUp, Snake::Direction::kRight,
+                                              Snake::Direction::kDown, Snake::Direction::kLeft};
+  constexpr int kDirectionDx[] = {0, 1, 0, -1};
+  constexpr int kDirectionDy[] = {-1, 0, 1, 0};
+
+  uint64_t Mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+  }
+
+  int WrappedDelta(int from, int to, int size) {
+    int delta = to - from;
+    if (delta > size / 2) delta -= size;
+    if (delta < -size / 2) delta += size;
+    return delta;
+  }
+}
+
+MonteCarloPlanner::MonteCarloPlanner(const Options &options) : options(options) {
+  this->options.rolloutsPerDirection = std::max(this->options.rolloutsPerDirection, 1);
+  this->options.rolloutTicks = std::max(this->options.rolloutTicks, 1);
+  thread_count = options.threadCount != 0 ? options.threadCount
+                                          : std::max(1u, std::thread::hardware_concurrency());
+  totals.resize(thread_count);
+  for (unsigned i = 1; i < thread_count; ++i) {
+    workers.emplace_back(&MonteCarloPlanner::WorkerLoop, this, i);
+  }
+}
+
+MonteCarloPlanner::~MonteCarloPlanner() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  job_ready.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+Snake::Direction MonteCarloPlanner::Plan(const SimState &state) {
+  auto start = std::chrono::steady_clock::now();
+  Snake::Direction best = state.GetDirection();
+  if (state.IsOver()) {
+    return best;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    root = state;
+    candidate_count = 0;
+    for (Snake::Direction direction : kDirections) {
+      if (!state.IsReverse(direction)) {
+        candidates[candidate_count++] = direction;
+      }
+    }
+    job_rollouts = candidate_count * options.rolloutsPerDirection;
+    job_seed = Mix(plan_count + 1) ^ state.GetTicks();
+    next_rollout.store(0);
+    for (auto &worker_totals : totals) {
+      worker_totals = WorkerTotals{};
+    }
+    workers_finished = 0;
+    ++job_generation;
+  }
+  job_ready.notify_all();
+
+  RunRollouts(totals[0]);
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    job_done.wait(lock, [this] { return workers_finished == workers.size(); });
+  }
+
+  double best_value = 0;
+  for (int c = 0; c < candidate_count; ++c) {
+    double value = 0;
+    uint32_t count = 0;
+    for (const auto &worker_totals : totals) {
+      value += worker_totals.value[c];
+      count += worker_totals.count[c];
+    }
+    double average = count ? value / count : 0;
+    if (c == 0 || average > best_value) {
+      best_value = average;
+      best = candidates[c];
+    }
+  }
+
+  rollout_count += static_cast<uint64_t>(job_rollouts);
+  ++plan_count;
+  total_plan_time += std::chrono::steady_clock::now() - start;
+  return best;
+}
+
+void MonteCarloPlanner::WorkerLoop(unsigned index) {
+  uint64_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      job_ready.wait(lock, [this, seen_generation] { return stopping || job_generation != seen_generation; });
+      if (stopping) {
+        return;
+      }
+      seen_generation = job_generation;
+    }
+    RunRollouts(totals[index]);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++workers_finished;
+    }
+    job_done.notify_one();
+  }
+}
+
+void MonteCarloPlanner::RunRollouts(WorkerTotals &worker_totals) {
+  int rollout;
+  while ((rollout = next_rollout.fetch_add(1, std::memory_order_relaxed)) < job_rollouts) {
+    int candidate = rollout % candidate_count;
+    worker_totals.value[candidate] += Rollout(rollout);
+    worker_totals.count[candidate]++;
+  }
+}
+
+// Plays one future: the candidate direction now, then a random policy that
+// leans toward the food and avoids cells that are blocked one step ahead
+float MonteCarloPlanner::Rollout(int rollout) const {
+  SimState state = root;
+  uint64_t random = Mix(job_seed + static_cast<uint64_t>(rollout) * 0x9E3779B97F4A7C15ULL);
+  state.Reseed(random);
+  state.Steer(candidates[rollout % candidate_count]);
+
+  const int width = state.GetWidth();
+  const int height = state.GetHeight();
+  SDL_Point last_head = state.GetHead();
+  for (int tick = 0; tick < options.rolloutTicks && !state.IsOver(); ++tick) {
+    state.Step();
+    SDL_Point head = state.GetHead();
+    if (head.x == last_head.x && head.y == last_head.y) {
+      continue;
+    }
+    last_head = head;
+
+    random = Mix(random + 0x9E3779B97F4A7C15ULL);
+    SDL_Point food = state.GetFood();
+    int dx = WrappedDelta(head.x, food.x, width);
+    int dy = WrappedDelta(head.y, food.y, height);
+    int choice;
+    if (random & 1) {
+      // Toward the food along the longer axis
+      choice = std::abs(dx) >= std::abs(dy) ? (dx > 0 ? 1 : 3) : (dy > 0 ? 2 : 0);
+    } else {
+      choice = static_cast<int>((random >> 1) % 4);
+    }
+    for (int turn = 0; turn < 4; ++turn) {
+      int i = (choice + turn) % 4;
+      if (state.IsReverse(kDirections[i])) continue;
+      int x = (head.x + kDirectionDx[i] + width) % width;
+      int y = (head.y + kDirectionDy[i] + height) % height;
+      if (!state.IsBodyCell(x, y) && !state.IsObstacleCell(x, y)) {
+        state.Steer(kDirections[i]);
+        break;
+      }
+    }
+  }
+
+  float value = static_cast<float>(state.GetScore() - root.GetScore());
+  if (state.IsOver()) {
+    value -= options.deathPenalty;
+  }
+  return value;
+}
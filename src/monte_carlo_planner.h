@@ -0,0 +1,82 @@
+#ifndef MONTE_CARLO_PLANNER_H
+#define MONTE_CARLO_PLANNER_H
+
+#include "sim_state.h"
+#include "snake.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Picks the snake's next direction by playing many short random futures
+// from each legal direction on cloned SimStates and keeping the direction
+// with the best average outcome (food eaten, minus a penalty for dying).
+//
+// Rollouts run on a pool of worker threads started once, plus the calling
+// thread. Each rollout clones the root state (one memcpy), reseeds it and
+// plays on its own copy; workers only share an atomic rollout counter and
+// write their totals to their own cache line.
+class MonteCarloPlanner {
+public:
+  struct Options {
+    int rolloutsPerDirection{128};
+    int rolloutTicks{240};    // Simulated ticks per rollout
+    float deathPenalty{5.0f}; // In food
+    unsigned threadCount{0};  // 0 uses every hardware thread
+  };
+
+  explicit MonteCarloPlanner(const Options &options);
+  MonteCarloPlanner() : MonteCarloPlanner(Options()) {}
+  ~MonteCarloPlanner();
+
+  MonteCarloPlanner(const MonteCarloPlanner &) = delete;
+  MonteCarloPlanner &operator=(const MonteCarloPlanner &) = delete;
+
+  Snake::Direction Plan(const SimState &state);
+
+  // Statistics
+  unsigned GetThreadCount() const { return thread_count; }
+  uint64_t GetRolloutCount() const { return rollout_count; }
+  uint64_t GetPlanCount() const { return plan_count; }
+  std::chrono::nanoseconds GetTotalPlanTime() const { return total_plan_time; }
+
+private:
+  // One worker's sums, on its own cache line
+  struct alignas(64) WorkerTotals {
+    double value[4];
+    uint32_t count[4];
+  };
+
+  Options options;
+  unsigned thread_count;
+  std::vector<std::thread> workers;
+  std::vector<WorkerTotals> totals; // [0] is the calling thread
+
+  // The current job; written under `mutex` before the generation changes
+  SimState root;
+  Snake::Direction candidates[4];
+  int candidate_count{0};
+  int job_rollouts{0};
+  uint64_t job_seed{0};
+  std::atomic<int> next_rollout{0};
+
+  std::mutex mutex;
+  std::condition_variable job_ready;
+  std::condition_variable job_done;
+  uint64_t job_generation{0};
+  unsigned workers_finished{0};
+  bool stopping{false};
+
+  uint64_t rollout_count{0};
+  uint64_t plan_count{0};
+  std::chrono::nanoseconds total_plan_time{0};
+
+  void WorkerLoop(unsigned index);
+  void RunRollouts(WorkerTotals &worker_totals);
+  float Rollout(int rollout) const;
+};
+
+#endif
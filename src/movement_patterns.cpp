@@ -1,9 +1,7 @@
 #include "movement_patterns.h"
+#include "pathfinding_engine.h"
 #include <random>
 #include <algorithm>
-#include <queue>
-#include <unordered_set>
-#include <functional>
 
 namespace MovementPatterns {
 
@@ -47,27 +45,53 @@ SDL_Point CalculateCircularMovement(const SDL_Point& center, float radius, float
     return new_pos;
 }
 
-std::vector<SDL_Point> CalculateZigzagPath(const SDL_Point& start, int amplitude, int wavelength, int grid_width) {
-    std::vector<SDL_Point> path;
+namespace {
 
-    for (int x = start.x; x < grid_width; x += wavelength / 4) {
-        for (int phase = 0; phase < 4; ++phase) {
-            SDL_Point point;
-            point.x = x + (wavelength / 4) * phase;
-
-            // Calculate zigzag y position
-            float cycle_pos = static_cast<float>(phase) / 4.0f;
-            if (cycle_pos < 0.5f) {
-                point.y = start.y + static_cast<int>(amplitude * (cycle_pos * 4.0f - 1.0f));
-            } else {
-                point.y = start.y + static_cast<int>(amplitude * (3.0f - cycle_pos * 4.0f));
-            }
+// Zigzag points come in groups of four, one group per quarter wavelength
+// step in x; phase selects the point within a group
+SDL_Point ZigzagPoint(const SDL_Point& start, int amplitude, int x, int step, int phase) {
+    SDL_Point point;
+    point.x = x + step * phase;
 
-            if (point.x >= grid_width) break;
-            path.push_back(point);
+    // Calculate zigzag y position
+    float cycle_pos = static_cast<float>(phase) / 4.0f;
+    if (cycle_pos < 0.5f) {
+        point.y = start.y + static_cast<int>(amplitude * (cycle_pos * 4.0f - 1.0f));
+    } else {
+        point.y = start.y + static_cast<int>(amplitude * (3.0f - cycle_pos * 4.0f));
+    }
+    return point;
+}
+
+// Visits the points of CalculateZigzagPath in order without storing them;
+// stops early when the visitor returns false
+template<typename Visitor>
+void ForEachZigzagPoint(const SDL_Point& start, int amplitude, int wavelength, int grid_width,
+                        Visitor&& visitor) {
+    int step = wavelength / 4;
+    for (int x = start.x; x < grid_width; x += step) {
+        for (int phase = 0; phase < 4; ++phase) {
+            if (x + step * phase >= grid_width) break;
+            if (!visitor(ZigzagPoint(start, amplitude, x, step, phase))) return;
         }
     }
+}
+
+// Generator behind RANDOM_WALK; one per thread so batch simulations on
+// several threads neither race nor contend on it
+std::mt19937& RandomWalkEngine() {
+    thread_local std::mt19937 engine{std::random_device{}()};
+    return engine;
+}
+
+} // namespace
 
+std::vector<SDL_Point> CalculateZigzagPath(const SDL_Point& start, int amplitude, int wavelength, int grid_width) {
+    std::vector<SDL_Point> path;
+    ForEachZigzagPoint(start, amplitude, wavelength, grid_width, [&path](const SDL_Point& point) {
+        path.push_back(point);
+        return true;
+    });
     return path;
 }
 
@@ -98,6 +122,18 @@ SDL_Point CalculatePerlinNoiseMovement(const SDL_Point& current, float time, flo
     return new_pos;
 }
 
+void MovementCalculator::SeedRandomWalk(uint32_t seed) {
+    RandomWalkEngine().seed(seed);
+}
+
+const std::mt19937& MovementCalculator::GetRandomWalkEngine() {
+    return RandomWalkEngine();
+}
+
+void MovementCalculator::SetRandomWalkEngine(const std::mt19937& state) {
+    RandomWalkEngine() = state;
+}
+
 SDL_Point MovementCalculator::ProcessMovement(const SDL_Point& current, MovementPattern pattern,
                                              float speed, float& counter, int direction,
                                              int grid_width, int grid_height) {
@@ -121,22 +157,37 @@ SDL_Point MovementCalculator::HandlePatternSwitch(MovementPattern pattern, const
         }
 
         case MovementPattern::ZIGZAG: {
-            auto path = CalculateZigzagPath(current, 3, 8, grid_width);
-            if (!path.empty()) {
-                int index = static_cast<int>(counter) % path.size();
-                return path[index];
+            // Same point as CalculateZigzagPath(...)[counter % size], found
+            // without building the path every update
+            constexpr int kAmplitude = 3;
+            constexpr int kWavelength = 8;
+            std::size_t count = 0;
+            ForEachZigzagPoint(current, kAmplitude, kWavelength, grid_width,
+                               [&count](const SDL_Point&) { ++count; return true; });
+            if (count == 0) {
+                return current;
             }
-            return current;
+            std::size_t index = static_cast<std::size_t>(static_cast<int>(counter) % count);
+            SDL_Point target = current;
+            ForEachZigzagPoint(current, kAmplitude, kWavelength, grid_width,
+                               [&index, &target](const SDL_Point& point) {
+                                   if (index-- != 0) return true;
+                                   target = point;
+                                   return false;
+                               });
+            return target;
         }
 
         case MovementPattern::RANDOM_WALK: {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_int_distribution<> dist(0, 3);
-
-            return CalculateLinearMovement(current, dist(gen), speed);
+            std::uniform_int_distribution<int> dist(0, 3);
+            return CalculateLinearMovement(current, dist(RandomWalkEngine()), speed);
         }
 
+        case MovementPattern::FLOCKING:
+        case MovementPattern::NOISE_DRIFT:
+            // Moved in fractions of a cell by MovingObstacle, not from here
+            return current;
+
         default:
             return current;
     }
@@ -145,95 +196,20 @@ SDL_Point MovementCalculator::HandlePatternSwitch(MovementPattern pattern, const
 std::vector<SDL_Point> MovementCalculator::CalculateAStarPath(const SDL_Point& start, const SDL_Point& goal,
                                                              const std::vector<SDL_Point>& obstacles,
                                                              int grid_width, int grid_height) {
-    // A* pathfinding implementation
-    struct Node {
-        SDL_Point pos;
-        float g_cost;
-        float h_cost;
-        SDL_Point parent;
-
-        float f_cost() const { return g_cost + h_cost; }
-    };
-
-    auto heuristic = [](const SDL_Point& a, const SDL_Point& b) -> float {
-        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
-    };
-
-    std::priority_queue<Node, std::vector<Node>, std::function<bool(const Node&, const Node&)>>
-        open_set([](const Node& a, const Node& b) { return a.f_cost() > b.f_cost(); });
-
-    std::unordered_set<int> closed_set;
-    std::unordered_set<int> obstacle_set;
-
-    // Convert obstacles to hash set for O(1) lookup
-    for (const auto& obs : obstacles) {
-        obstacle_set.insert(obs.y * grid_width + obs.x);
+    // One search engine per thread, reused across calls (see PathfindingEngine)
+    thread_local PathfindingEngine engine(grid_width, grid_height);
+    if (engine.GetWidth() != grid_width || engine.GetHeight() != grid_height) {
+        engine.Resize(grid_width, grid_height);
     }
 
-    Node start_node = {start, 0.0f, heuristic(start, goal), {-1, -1}};
-    open_set.push(start_node);
-
-    std::vector<Node> all_nodes;
-    all_nodes.push_back(start_node);
-
-    while (!open_set.empty()) {
-        Node current = open_set.top();
-        open_set.pop();
-
-        if (current.pos.x == goal.x && current.pos.y == goal.y) {
-            // Reconstruct path
-            std::vector<SDL_Point> path;
-            SDL_Point current_pos = current.pos;
-
-            while (current_pos.x != -1 && current_pos.y != -1) {
-                path.push_back(current_pos);
-                // Find parent node
-                bool found = false;
-                for (const auto& node : all_nodes) {
-                    if (node.pos.x == current.parent.x && node.pos.y == current.parent.y) {
-                        current_pos = node.parent;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) break;
-            }
-
-            std::reverse(path.begin(), path.end());
-            return path;
-        }
-
-        closed_set.insert(current.pos.y * grid_width + current.pos.x);
-
-        // Check all neighbors
-        const int dx[] = {0, 1, 0, -1};
-        const int dy[] = {-1, 0, 1, 0};
-
-        for (int i = 0; i < 4; ++i) {
-            SDL_Point neighbor = {current.pos.x + dx[i], current.pos.y + dy[i]};
-
-            // Check bounds
-            if (neighbor.x < 0 || neighbor.x >= grid_width ||
-                neighbor.y < 0 || neighbor.y >= grid_height) {
-                continue;
-            }
-
-            int neighbor_hash = neighbor.y * grid_width + neighbor.x;
-
-            // Skip if obstacle or already processed
-            if (obstacle_set.count(neighbor_hash) || closed_set.count(neighbor_hash)) {
-                continue;
-            }
-
-            float tentative_g = current.g_cost + 1.0f;
-
-            Node neighbor_node = {neighbor, tentative_g, heuristic(neighbor, goal), current.pos};
-            all_nodes.push_back(neighbor_node);
-            open_set.push(neighbor_node);
-        }
+    engine.ClearBlocked();
+    for (const auto& obs : obstacles) {
+        engine.SetBlocked(obs.x, obs.y);
     }
 
-    return {}; // No path found
+    std::vector<SDL_Point> path;
+    engine.FindPath(start, goal, path);
+    return path; // Empty if no path found
 }
 
 SDL_Point MovementCalculator::CalculateFlockingMovement(const SDL_Point& current,
@@ -3,8 +3,10 @@
 
 #include "SDL.h"
 #include "moving_obstacle.h"
+#include <cstdint>
 #include <vector>
 #include <functional>
+#include <random>
 #include <cmath>
 
 namespace MovementPatterns {
@@ -36,6 +38,15 @@ namespace MovementPatterns {
                                         float speed, float& counter, int direction,
                                         int grid_width, int grid_height);
 
+        // RANDOM_WALK draws from a per-thread generator; seeding it makes the
+        // calling thread's obstacle walks reproducible (headless simulations)
+        static void SeedRandomWalk(uint32_t seed);
+
+        // The calling thread's RANDOM_WALK generator, for saving and
+        // restoring games
+        static const std::mt19937& GetRandomWalkEngine();
+        static void SetRandomWalkEngine(const std::mt19937& state);
+
         // Advanced pathfinding algorithms
         static std::vector<SDL_Point> CalculateAStarPath(const SDL_Point& start, const SDL_Point& goal,
                                                         const std::vector<SDL_Point>& obstacles,
@@ -1,14 +1,23 @@
 #include "moving_obstacle.h"
 #include "movement_patterns.h"
+#include "noise_field.h"
+#include <algorithm>
+#include <cstdint>
 #include <random>
 
 MovingObstacle::MovingObstacle(int x, int y, int grid_width, int grid_height,
                                MovementPattern pattern, float lifetime_seconds)
     : Obstacle(x, y, grid_width, grid_height, lifetime_seconds),
       pattern(pattern) {
+    ResetExactState();
 }
 
 void MovingObstacle::Update() {
+    if (pattern == MovementPattern::FLOCKING || pattern == MovementPattern::NOISE_DRIFT) {
+        AdvanceExactPosition();
+        return;
+    }
+
     // Use advanced movement pattern calculation with optimization
     SDL_Point new_pos = MovementPatterns::MovementCalculator::ProcessMovement(
         position, pattern, speed, movement_counter, direction, grid_width, grid_height);
@@ -39,6 +48,53 @@ void MovingObstacle::Render(SDL_Renderer* renderer, std::size_t screen_width,
 void MovingObstacle::SetPattern(MovementPattern pattern) {
     this->pattern = pattern;
     movement_counter = 0.0f; // Reset counter when pattern changes
+    ResetExactState();
+}
+
+void MovingObstacle::SetVelocity(float velocity_x, float velocity_y) {
+    this->velocity_x = velocity_x;
+    this->velocity_y = velocity_y;
+}
+
+void MovingObstacle::SetExactState(float x, float y, float velocity_x, float velocity_y) {
+    exact_x = x;
+    exact_y = y;
+    SetVelocity(velocity_x, velocity_y);
+}
+
+void MovingObstacle::ResetExactState() {
+    exact_x = position.x + 0.5f;
+    exact_y = position.y + 0.5f;
+    StartingVelocity(position.x, position.y, speed, velocity_x, velocity_y);
+}
+
+void MovingObstacle::StartingVelocity(int x, int y, float speed, float& velocity_x, float& velocity_y) {
+    uint32_t hash = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u;
+    float angle = (hash % 360u) * static_cast<float>(M_PI) / 180.0f;
+    velocity_x = speed * std::cos(angle);
+    velocity_y = speed * std::sin(angle);
+}
+
+void MovingObstacle::AdvanceExactPosition() {
+    // Coasts on the current velocity; wraps like the other patterns
+    exact_x = std::fmod(exact_x + velocity_x + grid_width, static_cast<float>(grid_width));
+    exact_y = std::fmod(exact_y + velocity_y + grid_height, static_cast<float>(grid_height));
+    position.x = std::min(static_cast<int>(exact_x), grid_width - 1);
+    position.y = std::min(static_cast<int>(exact_y), grid_height - 1);
+    movement_counter += speed;
+}
+
+void MovingObstacle::FollowNoise(const NoiseField& field) {
+    // One table lookup; the counter doubles as time, so obstacles spawned
+    // at different moments drift through different phases of the field
+    float direction_x, direction_y;
+    field.Sample(exact_x, exact_y, movement_counter, direction_x, direction_y);
+    SetVelocity(direction_x * speed, direction_y * speed);
+}
+
+void MovingObstacle::SetMovementState(int direction, float movement_counter) {
+    this->direction = direction;
+    this->movement_counter = movement_counter;
 }
 
 void MovingObstacle::UpdateLinearHorizontal() {
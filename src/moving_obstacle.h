@@ -2,16 +2,24 @@
 #define MOVING_OBSTACLE_H
 
 #include "obstacle.h"
+#include <algorithm>
 #include <cmath>
 
+class NoiseField;
+
 enum class MovementPattern {
     LINEAR_HORIZONTAL,
     LINEAR_VERTICAL,
     CIRCULAR,
     ZIGZAG,
-    RANDOM_WALK
+    RANDOM_WALK,
+    FLOCKING,    // Steered with nearby FLOCKING obstacles by ObstacleManager (see Flock)
+    NOISE_DRIFT  // Follows the level's precomputed noise flow field (see NoiseField)
 };
 
+// Number of MovementPattern values; keep in sync with the enum above
+constexpr int kMovementPatternCount = 7;
+
 class MovingObstacle : public Obstacle {
 public:
     explicit MovingObstacle(int x, int y, int grid_width, int grid_height,
@@ -29,12 +37,50 @@ public:
     void SetSpeed(float speed) { this->speed = speed; }
     void SetPattern(MovementPattern pattern);
     MovementPattern GetPattern() const { return pattern; }
+    float GetSpeed() const { return speed; }
+    int GetDirection() const { return direction; }
+    float GetMovementCounter() const { return movement_counter; }
+    void SetMovementState(int direction, float movement_counter); // Loading a saved game
+
+    // FLOCKING and NOISE_DRIFT: position within the board in fractional
+    // cells, and velocity in cells per update (set each update by
+    // ObstacleManager's Flock, or from the noise field); Update coasts on it
+    float GetExactX() const { return exact_x; }
+    float GetExactY() const { return exact_y; }
+    float GetVelocityX() const { return velocity_x; }
+    float GetVelocityY() const { return velocity_y; }
+    void SetVelocity(float velocity_x, float velocity_y);
+    void SetExactState(float x, float y, float velocity_x, float velocity_y); // Loading a saved game
+
+    // Velocity a FLOCKING or NOISE_DRIFT obstacle starts with in cell (x, y):
+    // derived from the cell, so spawning draws from no generator
+    static void StartingVelocity(int x, int y, float speed, float& velocity_x, float& velocity_y);
+
+    // NOISE_DRIFT: heads along `field` at the current position and time
+    // (the movement counter); called by ObstacleManager before Update
+    void FollowNoise(const NoiseField& field);
+
+    // FLOCKING: one update's move, done by ObstacleManager for the whole
+    // flock at once in place of Update
+    void ApplyFlockStep(float x, float y, float velocity_x, float velocity_y) {
+        exact_x = x;
+        exact_y = y;
+        this->velocity_x = velocity_x;
+        this->velocity_y = velocity_y;
+        position.x = std::min(static_cast<int>(x), grid_width - 1);
+        position.y = std::min(static_cast<int>(y), grid_height - 1);
+        movement_counter += speed;
+    }
 
 private:
     MovementPattern pattern;
     float speed{0.05f};
     int direction{1}; // 1 or -1 for direction changes
     float movement_counter{0.0f}; // For circular and complex patterns
+    float exact_x;
+    float exact_y;
+    float velocity_x{0.0f};
+    float velocity_y{0.0f};
 
     static constexpr SDL_Color kMovingObstacleColor{255, 165, 0, 255}; // Orange
     static constexpr float kDefaultLifetime = 7.0f; // 7 seconds default
@@ -45,6 +91,8 @@ private:
     void UpdateCircular();
     void UpdateZigzag();
     void UpdateRandomWalk();
+    void AdvanceExactPosition();
+    void ResetExactState();
 
     // Template method for movement bounds checking
     template<typename T>
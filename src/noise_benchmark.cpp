@@ -0,0 +1,142 @@
+// Noise field benchmark: builds the NOISE_DRIFT flow field on one thread and
+// on every core, checks the table against the noise it was built from, and
+// compares a table lookup with evaluating the noise per call (both the
+// field's own noise and MovementPatterns' per-call Perlin movement). Then
+// times what a level start costs an ObstacleManager (setting the seed
+// against building the field) and the movement update for a board full of
+// drifting obstacles.
+//
+// Usage: NoiseBenchmark [obstacles] [updates] [seed]
+
+#include "movement_patterns.h"
+#include "noise_field.h"
+#include "obstacle_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr double kFrameBudgetMs = 1000.0 / 60.0;
+    constexpr int kQueries = 1 << 20;
+
+    double NanosecondsPer(Clock::time_point start, int count) {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50000;
+    int updates = argc > 2 ? std::max(1, std::atoi(argv[2])) : 120;
+    uint32_t seed = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Noise field benchmark: " << NoiseField::kTileSize << "x" << NoiseField::kTileSize
+              << " tile, " << NoiseField::kSlices << " slices" << std::endl;
+    NoiseField single(seed, 1);
+    NoiseField parallel(seed, cores);
+    std::cout << std::fixed << std::setprecision(2) << "build: " << single.GetBuildMilliseconds()
+              << " ms on 1 thread, " << parallel.GetBuildMilliseconds() << " ms on " << cores
+              << " threads" << std::endl;
+
+    // The table against the noise, at cell centres well outside the tile
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> random_cell(0, 8191);
+    std::uniform_int_distribution<int> random_slice(0, 4 * NoiseField::kSlices);
+    int mismatches = 0;
+    for (int i = 0; i < 10000; ++i) {
+        int x = random_cell(rng), y = random_cell(rng), slice = random_slice(rng);
+        float sample_x, sample_y, expected_x, expected_y;
+        parallel.Sample(x + 0.5f, y + 0.5f, static_cast<float>(slice), sample_x, sample_y);
+        NoiseField::Evaluate(seed, x & (NoiseField::kTileSize - 1), y & (NoiseField::kTileSize - 1),
+                             slice & (NoiseField::kSlices - 1), expected_x, expected_y);
+        if (sample_x != expected_x || sample_y != expected_y ||
+            std::abs(std::hypot(sample_x, sample_y) - 1.0f) > 1e-4f) {
+            ++mismatches;
+        }
+    }
+    std::cout << "table check: " << (mismatches == 0 ? "matches the noise" : "MISMATCH") << std::endl;
+
+    // Per-query cost over the same positions
+    std::uniform_real_distribution<float> random_position(0.0f, 1024.0f);
+    std::vector<float> xs(kQueries), ys(kQueries), times(kQueries);
+    for (int i = 0; i < kQueries; ++i) {
+        xs[i] = random_position(rng);
+        ys[i] = random_position(rng);
+        times[i] = random_position(rng) / 8.0f;
+    }
+    float sink = 0.0f;
+    auto start = Clock::now();
+    for (int i = 0; i < kQueries; ++i) {
+        float dx, dy;
+        parallel.Sample(xs[i], ys[i], times[i], dx, dy);
+        sink += dx + dy;
+    }
+    double lookup_ns = NanosecondsPer(start, kQueries);
+    start = Clock::now();
+    for (int i = 0; i < kQueries; ++i) {
+        float dx, dy;
+        NoiseField::Evaluate(seed, static_cast<int>(xs[i]), static_cast<int>(ys[i]), static_cast<int>(times[i]), dx, dy);
+        sink += dx + dy;
+    }
+    double evaluate_ns = NanosecondsPer(start, kQueries);
+    start = Clock::now();
+    for (int i = 0; i < kQueries; ++i) {
+        SDL_Point next = MovementPatterns::CalculatePerlinNoiseMovement(
+            SDL_Point{static_cast<int>(xs[i]), static_cast<int>(ys[i])}, times[i], 0.1f);
+        sink += static_cast<float>(next.x + next.y);
+    }
+    double perlin_ns = NanosecondsPer(start, kQueries);
+    std::cout << "per query: lookup " << lookup_ns << " ns, noise " << evaluate_ns
+              << " ns, Perlin movement " << perlin_ns << " ns" << std::endl;
+    volatile float keep = sink; // So the loops are not optimized away
+    (void)keep;
+
+    // A board full of drifting obstacles
+    constexpr int kGrid = 1024;
+    std::vector<ObstacleManager::ObstacleState> states(count);
+    std::uniform_real_distribution<float> random_phase(0.0f, static_cast<float>(NoiseField::kSlices));
+    for (auto& state : states) {
+        state.exact_x = random_position(rng);
+        state.exact_y = random_position(rng);
+        state.x = std::min(static_cast<int>(state.exact_x), kGrid - 1);
+        state.y = std::min(static_cast<int>(state.exact_y), kGrid - 1);
+        state.type = ObstacleType::MOVING;
+        state.pattern = MovementPattern::NOISE_DRIFT;
+        state.direction = 1;
+        state.movement_counter = random_phase(rng);
+        state.speed = 0.2f;
+        state.velocity_x = 0.0f;
+        state.velocity_y = 0.0f;
+        state.lifetime = 1e6f;
+    }
+    start = Clock::now();
+    ObstacleManager manager(kGrid, kGrid);
+    manager.SetNoiseSeed(seed);
+    double seed_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    start = Clock::now();
+    manager.BuildNoiseField(0);
+    double field_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout << "level start: manager and seed " << seed_us << " us, field " << field_ms << " ms on "
+              << cores << " threads" << std::endl;
+    manager.RestoreObstacles(states);
+    double update_ms = 0.0;
+    for (int i = 0; i < updates; ++i) {
+        start = Clock::now();
+        manager.UpdateObstacleMovement();
+        update_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+    update_ms /= updates;
+    std::cout << count << " drifting obstacles on " << kGrid << "x" << kGrid << ": movement update "
+              << update_ms << " ms (" << std::setprecision(0) << 100.0 * update_ms / kFrameBudgetMs
+              << "% of a frame, " << std::setprecision(1) << update_ms * 1e6 / count << " ns per obstacle)"
+              << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
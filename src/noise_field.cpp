@@ -0,0 +1,114 @@
+#include "noise_field.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <thread>
+
+namespace {
+    // Value noise octaves. Lattice spacings divide the tile and the loop, so
+    // the noise (and the table) repeats without a seam.
+    struct Octave {
+        int cell_spacing;
+        int slice_spacing;
+        float amplitude;
+    };
+    constexpr Octave kOctaves[] = {{16, 8, 0.7f}, {8, 4, 0.3f}};
+    static_assert(NoiseField::kTileSize % 16 == 0 && NoiseField::kSlices % 8 == 0,
+                  "octave lattices must divide the tile and the loop");
+
+    // Full turns of heading across the noise range; above one, neighboring
+    // regions swirl instead of all drifting one way
+    constexpr float kTurns = 2.0f;
+
+    // Pseudo-random value in [0, 1) for one lattice point
+    float LatticeValue(uint32_t seed, int octave, int x, int y, int t) {
+        uint32_t hash = seed ^ static_cast<uint32_t>(octave) * 0x9E3779B9u;
+        hash ^= static_cast<uint32_t>(x) * 0x85EBCA6Bu;
+        hash = (hash ^ (hash >> 15)) * 0x2C1B3C6Du;
+        hash ^= static_cast<uint32_t>(y) * 0xC2B2AE35u;
+        hash = (hash ^ (hash >> 13)) * 0x297A2D39u;
+        hash ^= static_cast<uint32_t>(t) * 0x27D4EB2Fu;
+        hash = (hash ^ (hash >> 16)) * 0x85EBCA6Bu;
+        hash ^= hash >> 16;
+        return (hash >> 8) * (1.0f / 16777216.0f);
+    }
+
+    float Fade(float t) { return t * t * t * (t * (t * 6 - 15) + 10); } // As in PerlinNoise
+    float Lerp(float a, float b, float t) { return a + t * (b - a); }
+
+    // One octave at the centre of cell (x, y) in `slice`, in [0, 1)
+    float OctaveValue(uint32_t seed, int index, int x, int y, int slice) {
+        const Octave& octave = kOctaves[index];
+        const int period_x = NoiseField::kTileSize / octave.cell_spacing;
+        const int period_t = NoiseField::kSlices / octave.slice_spacing;
+
+        float fx = (x + 0.5f) / octave.cell_spacing;
+        float fy = (y + 0.5f) / octave.cell_spacing;
+        float ft = static_cast<float>(slice) / octave.slice_spacing;
+        int x0 = static_cast<int>(std::floor(fx));
+        int y0 = static_cast<int>(std::floor(fy));
+        int t0 = static_cast<int>(std::floor(ft));
+        float u = Fade(fx - x0);
+        float v = Fade(fy - y0);
+        float w = Fade(ft - t0);
+
+        auto wrap = [](int value, int period) { return ((value % period) + period) % period; };
+        int xa = wrap(x0, period_x), xb = wrap(x0 + 1, period_x);
+        int ya = wrap(y0, period_x), yb = wrap(y0 + 1, period_x);
+        int ta = wrap(t0, period_t), tb = wrap(t0 + 1, period_t);
+
+        auto plane = [&](int t) {
+            float top = Lerp(LatticeValue(seed, index, xa, ya, t), LatticeValue(seed, index, xb, ya, t), u);
+            float bottom = Lerp(LatticeValue(seed, index, xa, yb, t), LatticeValue(seed, index, xb, yb, t), u);
+            return Lerp(top, bottom, v);
+        };
+        return Lerp(plane(ta), plane(tb), w);
+    }
+}
+
+NoiseField::NoiseField(uint32_t seed, unsigned thread_count) : seed_(seed) {
+    auto start = std::chrono::steady_clock::now();
+    directions_x_.resize(kCellsPerSlice * kSlices);
+    directions_y_.resize(kCellsPerSlice * kSlices);
+
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    thread_count = std::min<unsigned>(thread_count, kSlices);
+
+    // Whole slices per thread; the calling thread fills the first share
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (unsigned t = 1; t < thread_count; ++t) {
+        int first = static_cast<int>(kSlices * t / thread_count);
+        int last = static_cast<int>(kSlices * (t + 1) / thread_count);
+        threads.emplace_back(&NoiseField::FillSlices, this, first, last);
+    }
+    FillSlices(0, static_cast<int>(kSlices / thread_count));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    build_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void NoiseField::Evaluate(uint32_t seed, int x, int y, int slice, float& direction_x, float& direction_y) {
+    float value = 0.0f;
+    for (int octave = 0; octave < static_cast<int>(std::size(kOctaves)); ++octave) {
+        value += kOctaves[octave].amplitude * OctaveValue(seed, octave, x, y, slice);
+    }
+    float angle = value * kTurns * 2.0f * static_cast<float>(M_PI);
+    direction_x = std::cos(angle);
+    direction_y = std::sin(angle);
+}
+
+void NoiseField::FillSlices(int first, int last) {
+    for (int slice = first; slice < last; ++slice) {
+        for (int y = 0; y < kTileSize; ++y) {
+            for (int x = 0; x < kTileSize; ++x) {
+                std::size_t index = slice * kCellsPerSlice + static_cast<std::size_t>(y) * kTileSize + x;
+                Evaluate(seed_, x, y, slice, directions_x_[index], directions_y_[index]);
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef NOISE_FIELD_H
+#define NOISE_FIELD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A precomputed flow field behind the NOISE_DRIFT movement pattern: unit
+// headings from smooth, periodic noise over a kTileSize x kTileSize tile of
+// cells and kSlices steps of time. The tile repeats across the board and
+// the slices loop, so one table serves every board size.
+//
+// Evaluating the noise costs two octaves of trilinear interpolation and a
+// sine and cosine; the table is filled once (split over worker threads) and
+// Sample is then an index computation, two reads per slice and a blend.
+class NoiseField {
+public:
+    static constexpr int kTileSize = 64; // Cells; a power of two
+    static constexpr int kSlices = 32;   // Time steps per loop; a power of two
+
+    // Fills the table on `thread_count` threads (0: one per core)
+    explicit NoiseField(uint32_t seed, unsigned thread_count = 0);
+
+    // Heading at board position (x, y) at `time` (one unit per slice): a
+    // unit vector at whole times, blended linearly (so slightly shorter) in
+    // between. All three are non-negative; positions beyond the tile wrap.
+    void Sample(float x, float y, float time, float& direction_x, float& direction_y) const {
+        const int slice = static_cast<int>(time);
+        const float blend = time - slice;
+        const std::size_t cell = static_cast<std::size_t>((static_cast<int>(y) & (kTileSize - 1)) * kTileSize +
+                                                          (static_cast<int>(x) & (kTileSize - 1)));
+        const std::size_t first = static_cast<std::size_t>(slice & (kSlices - 1)) * kCellsPerSlice + cell;
+        const std::size_t second = static_cast<std::size_t>((slice + 1) & (kSlices - 1)) * kCellsPerSlice + cell;
+        direction_x = directions_x_[first] + blend * (directions_x_[second] - directions_x_[first]);
+        direction_y = directions_y_[first] + blend * (directions_y_[second] - directions_y_[first]);
+    }
+
+    // What the table holds for one cell and slice, computed from scratch
+    static void Evaluate(uint32_t seed, int x, int y, int slice, float& direction_x, float& direction_y);
+
+    uint32_t GetSeed() const { return seed_; }
+    double GetBuildMilliseconds() const { return build_ms_; }
+
+private:
+    static constexpr std::size_t kCellsPerSlice = static_cast<std::size_t>(kTileSize) * kTileSize;
+
+    uint32_t seed_;
+    double build_ms_{0.0};
+    std::vector<float> directions_x_; // [slice][y][x]
+    std::vector<float> directions_y_;
+
+    void FillSlices(int first, int last);
+};
+
+#endif
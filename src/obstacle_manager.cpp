@@ -1,13 +1,17 @@
 #include "obstacle_manager.h"
+#include "noise_field.h"
 #include <algorithm>
+#include <cmath>
 #include <random>
 
 ObstacleManager::ObstacleManager(int grid_width, int grid_height)
     : grid_width(grid_width),
       grid_height(grid_height),
+      spatial_index(grid_width, grid_height),
       engine(dev()),
       random_x(0, grid_width - 1),
-      random_y(0, grid_height - 1) {
+      random_y(0, grid_height - 1),
+      flock(grid_width, grid_height) {
 }
 
 ObstacleManager::~ObstacleManager() = default;
@@ -15,6 +19,10 @@ ObstacleManager::~ObstacleManager() = default;
 void ObstacleManager::AddFixedObstacle(int x, int y, float lifetime) {
     if (x >= 0 && x < grid_width && y >= 0 && y < grid_height && IsPositionFree(x, y)) {
         obstacles.emplace_back(std::make_unique<FixedObstacle>(x, y, grid_width, grid_height, lifetime));
+        spatial_index.Insert(obstacles.back().get(), x, y);
+        if (fixed_listener) {
+            fixed_listener->OnFixedObstacleAdded(x, y);
+        }
     }
 }
 
@@ -23,6 +31,7 @@ void ObstacleManager::AddMovingObstacle(int x, int y, MovementPattern pattern, f
         auto moving_obstacle = std::make_unique<MovingObstacle>(x, y, grid_width, grid_height, pattern, lifetime);
         moving_obstacle->SetSpeed(moving_obstacle_speed);
         obstacles.emplace_back(std::move(moving_obstacle));
+        spatial_index.Insert(obstacles.back().get(), x, y);
     }
 }
 
@@ -32,37 +41,134 @@ void ObstacleManager::SpawnRandomObstacle() {
         return; // Skip if position is occupied
     }
 
-    // 60% chance for fixed obstacle, 40% for moving
+    // 60% chance for fixed obstacle, 35% for moving, 5% for a flocking
+    // swarm; from kNoiseDriftLevel on, a seventh of the moving ones drift
     std::uniform_real_distribution<float> type_dist(0.0f, 1.0f);
+    float type_roll = type_dist(engine);
 
-    if (type_dist(engine) < 0.6f) {
+    if (type_roll < 0.6f) {
         AddFixedObstacle(pos.x, pos.y);
-    } else {
+    } else if (type_roll < 0.9f || (type_roll < 0.95f && difficulty_level < kNoiseDriftLevel)) {
         MovementPattern pattern = GetRandomMovementPattern();
         AddMovingObstacle(pos.x, pos.y, pattern);
+    } else if (type_roll < 0.95f) {
+        BuildNoiseField();
+        AddMovingObstacle(pos.x, pos.y, MovementPattern::NOISE_DRIFT);
+    } else {
+        SpawnFlockingSwarm(pos.x, pos.y, kSwarmSize);
+    }
+}
+
+void ObstacleManager::SpawnFlockingSwarm(int x, int y, int count, float lifetime) {
+    std::uniform_real_distribution<float> angle_dist(0.0f, 2.0f * static_cast<float>(M_PI));
+    std::uniform_int_distribution<int> offset_dist(-2, 2);
+    float angle = angle_dist(engine);
+    float velocity_x = moving_obstacle_speed * std::cos(angle);
+    float velocity_y = moving_obstacle_speed * std::sin(angle);
+
+    int placed = 0;
+    for (int attempt = 0; attempt < count * 4 && placed < count; ++attempt) {
+        int member_x = attempt == 0 ? x : (x + offset_dist(engine) + grid_width) % grid_width;
+        int member_y = attempt == 0 ? y : (y + offset_dist(engine) + grid_height) % grid_height;
+        std::size_t before = obstacles.size();
+        AddMovingObstacle(member_x, member_y, MovementPattern::FLOCKING, lifetime);
+        if (obstacles.size() > before) {
+            static_cast<MovingObstacle*>(obstacles.back().get())->SetVelocity(velocity_x, velocity_y);
+            ++placed;
+        }
     }
 }
 
 void ObstacleManager::ClearExpiredObstacles() {
-    obstacles.erase(
-        std::remove_if(obstacles.begin(), obstacles.end(),
-                      [](const std::unique_ptr<Obstacle>& obstacle) {
-                          return obstacle->IsExpired();
-                      }),
-        obstacles.end()
-    );
+    EraseExpiredObstacles();
 }
 
 void ObstacleManager::ClearAllObstacles() {
+    if (fixed_listener) {
+        for (const auto& obstacle : obstacles) {
+            if (obstacle->GetType() == ObstacleType::FIXED) {
+                fixed_listener->OnFixedObstacleRemoved(obstacle->GetX(), obstacle->GetY());
+            }
+        }
+    }
     obstacles.clear();
+    spatial_index.Clear();
 }
 
 void ObstacleManager::UpdateObstacleMovement() {
+    MoveObstacles();
+}
+
+void ObstacleManager::UpdateObstacleTracked(Obstacle& obstacle) {
+    SDL_Point old_position = obstacle.GetPosition();
+    obstacle.Update();
+    const SDL_Point& new_position = obstacle.GetPosition();
+    spatial_index.Move(&obstacle, old_position.x, old_position.y, new_position.x, new_position.y);
+}
+
+void ObstacleManager::MoveObstacles() {
+    flock.Clear();
+    flock_members.clear();
+    pattern_movers.clear();
     for (auto& obstacle : obstacles) {
-        obstacle->Update();
+        if (obstacle->GetType() != ObstacleType::MOVING) {
+            continue; // Fixed obstacles never move
+        }
+        auto* moving_obstacle = static_cast<MovingObstacle*>(obstacle.get());
+        if (moving_obstacle->GetPattern() == MovementPattern::NOISE_DRIFT) {
+            if (!noise_field) {
+                BuildNoiseField(); // Added directly, or the seed changed under them
+            }
+            moving_obstacle->FollowNoise(*noise_field);
+        }
+        if (moving_obstacle->GetPattern() == MovementPattern::FLOCKING) {
+            flock.Add(moving_obstacle->GetExactX(), moving_obstacle->GetExactY(),
+                      moving_obstacle->GetVelocityX(), moving_obstacle->GetVelocityY(),
+                      moving_obstacle->GetSpeed());
+            flock_members.push_back(moving_obstacle);
+        } else {
+            pattern_movers.push_back(moving_obstacle);
+        }
+    }
+
+    if (!flock_members.empty()) {
+        flock.Steer(flock_weights);
+        flock.Integrate();
+        for (std::size_t i = 0; i < flock_members.size(); ++i) {
+            MovingObstacle* member = flock_members[i];
+            SDL_Point old_position = member->GetPosition();
+            member->ApplyFlockStep(flock.GetX(i), flock.GetY(i), flock.GetVelocityX(i), flock.GetVelocityY(i));
+            const SDL_Point& new_position = member->GetPosition();
+            if (new_position.x != old_position.x || new_position.y != old_position.y) {
+                spatial_index.Move(member, old_position.x, old_position.y, new_position.x, new_position.y);
+            }
+        }
+    }
+
+    for (MovingObstacle* obstacle : pattern_movers) {
+        UpdateObstacleTracked(*obstacle);
     }
 }
 
+std::size_t ObstacleManager::EraseExpiredObstacles() {
+    std::size_t initial_count = obstacles.size();
+    obstacles.erase(
+        std::remove_if(obstacles.begin(), obstacles.end(),
+                      [this](const std::unique_ptr<Obstacle>& obstacle) {
+                          if (!obstacle->IsExpired()) {
+                              return false;
+                          }
+                          spatial_index.Remove(obstacle.get(), obstacle->GetX(), obstacle->GetY());
+                          if (fixed_listener && obstacle->GetType() == ObstacleType::FIXED) {
+                              fixed_listener->OnFixedObstacleRemoved(obstacle->GetX(), obstacle->GetY());
+                          }
+                          return true;
+                      }),
+        obstacles.end()
+    );
+    return initial_count - obstacles.size();
+}
+
 void ObstacleManager::UpdateObstacleLifetimes(float delta_time) {
     for (auto& obstacle : obstacles) {
         obstacle->DecrementLifetime(delta_time);
@@ -78,10 +184,9 @@ void ObstacleManager::RenderObstacles(SDL_Renderer* renderer, std::size_t screen
 }
 
 bool ObstacleManager::CheckCollisionWithPoint(int x, int y) const {
-    return std::any_of(obstacles.begin(), obstacles.end(),
-                      [x, y](const std::unique_ptr<Obstacle>& obstacle) {
-                          return obstacle->CollidesWithPoint(x, y);
-                      });
+    return spatial_index.AnyInBucket(x, y, [x, y](const Obstacle* obstacle) {
+        return obstacle->CollidesWithPoint(x, y);
+    });
 }
 
 bool ObstacleManager::CheckCollisionWithSnake(const Snake& snake) const {
@@ -95,6 +200,24 @@ bool ObstacleManager::IsValidFoodPosition(int x, int y) const {
     return !CheckCollisionWithPoint(x, y);
 }
 
+void ObstacleManager::QueryObstaclesInRect(const SDL_Rect& cells,
+                                           std::vector<const Obstacle*>& out) const {
+    spatial_index.Query(cells, [&cells, &out](const Obstacle* obstacle) {
+        if (obstacle->CollidesWithRect(cells)) {
+            out.push_back(obstacle);
+        }
+    });
+}
+
+void ObstacleManager::ForEachObstacleInRect(const SDL_Rect& cells,
+                                            const std::function<void(const Obstacle&)>& visit) const {
+    spatial_index.Query(cells, [&cells, &visit](const Obstacle* obstacle) {
+        if (obstacle->CollidesWithRect(cells)) {
+            visit(*obstacle);
+        }
+    });
+}
+
 std::size_t ObstacleManager::GetFixedObstacleCount() const {
     return std::count_if(obstacles.begin(), obstacles.end(),
                         [](const std::unique_ptr<Obstacle>& obstacle) {
@@ -143,6 +266,88 @@ bool ObstacleManager::ShouldSpawnObstacle(float delta_time) {
     return false;
 }
 
+void ObstacleManager::SeedRandom(unsigned int seed) {
+    engine.seed(seed);
+    spawn_timer = 0.0f;
+}
+
+void ObstacleManager::SetNoiseSeed(uint32_t seed) {
+    if (seed != noise_seed) {
+        noise_seed = seed;
+        noise_field.reset();
+    }
+}
+
+void ObstacleManager::SetNoiseField(std::shared_ptr<const NoiseField> field) {
+    noise_seed = field->GetSeed();
+    noise_field = std::move(field);
+}
+
+void ObstacleManager::BuildNoiseField(unsigned thread_count) {
+    if (!noise_field) {
+        noise_field = std::make_shared<const NoiseField>(noise_seed, thread_count);
+    }
+}
+
+void ObstacleManager::CaptureObstacles(std::vector<ObstacleState>& out) const {
+    out.clear();
+    for (const auto& obstacle : obstacles) {
+        ObstacleState state{obstacle->GetX(), obstacle->GetY(), obstacle->GetType(),
+                            MovementPattern::LINEAR_HORIZONTAL, 1, 0.0f, 0.0f,
+                            obstacle->GetX() + 0.5f, obstacle->GetY() + 0.5f, 0.0f, 0.0f,
+                            obstacle->GetRemainingLifetime()};
+        if (state.type == ObstacleType::MOVING) {
+            const auto* moving_obstacle = static_cast<const MovingObstacle*>(obstacle.get());
+            state.pattern = moving_obstacle->GetPattern();
+            state.direction = moving_obstacle->GetDirection();
+            state.movement_counter = moving_obstacle->GetMovementCounter();
+            state.speed = moving_obstacle->GetSpeed();
+            state.exact_x = moving_obstacle->GetExactX();
+            state.exact_y = moving_obstacle->GetExactY();
+            state.velocity_x = moving_obstacle->GetVelocityX();
+            state.velocity_y = moving_obstacle->GetVelocityY();
+        }
+        out.push_back(state);
+    }
+}
+
+void ObstacleManager::RestoreObstacles(const std::vector<ObstacleState>& states) {
+    ClearAllObstacles();
+    for (const ObstacleState& state : states) {
+        if (state.type == ObstacleType::MOVING && state.pattern == MovementPattern::NOISE_DRIFT) {
+            BuildNoiseField();
+        }
+        // Moving obstacles may share a cell, so this skips AddFixedObstacle's
+        // free-cell check
+        if (state.x < 0 || state.x >= grid_width || state.y < 0 || state.y >= grid_height) {
+            continue;
+        }
+        if (state.type == ObstacleType::MOVING) {
+            auto moving_obstacle = std::make_unique<MovingObstacle>(state.x, state.y, grid_width, grid_height,
+                                                                    state.pattern, state.lifetime);
+            moving_obstacle->SetSpeed(state.speed);
+            moving_obstacle->SetMovementState(state.direction, state.movement_counter);
+            moving_obstacle->SetExactState(state.exact_x, state.exact_y, state.velocity_x, state.velocity_y);
+            obstacles.emplace_back(std::move(moving_obstacle));
+        } else {
+            obstacles.emplace_back(std::make_unique<FixedObstacle>(state.x, state.y, grid_width, grid_height,
+                                                                   state.lifetime));
+            if (fixed_listener) {
+                fixed_listener->OnFixedObstacleAdded(state.x, state.y);
+            }
+        }
+        spatial_index.Insert(obstacles.back().get(), state.x, state.y);
+    }
+}
+
+void ObstacleManager::RestoreSpawnState(int difficulty_level, float moving_obstacle_speed,
+                                        float spawn_rate, float spawn_timer) {
+    this->difficulty_level = difficulty_level;
+    this->moving_obstacle_speed = moving_obstacle_speed;
+    this->spawn_rate = spawn_rate;
+    this->spawn_timer = spawn_timer;
+}
+
 bool ObstacleManager::IsPositionFree(int x, int y) const {
     return !CheckCollisionWithPoint(x, y);
 }
@@ -152,6 +357,9 @@ SDL_Point ObstacleManager::GenerateRandomPosition() const {
 }
 
 MovementPattern ObstacleManager::GetRandomMovementPattern() const {
+    // FLOCKING and NOISE_DRIFT are left out: a lone flocking obstacle has
+    // nothing to flock with, so they spawn as swarms (SpawnFlockingSwarm),
+    // and drifters only come at higher difficulty (SpawnRandomObstacle)
     std::uniform_int_distribution<int> pattern_dist(0, 4);
     int pattern_int = pattern_dist(engine);
 
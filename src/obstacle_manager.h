@@ -5,13 +5,44 @@
 #include "fixed_obstacle.h"
 #include "moving_obstacle.h"
 #include "snake.h"
+#include "spatial_grid.h"
+#include "flock.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <random>
 #include <algorithm>
+#include <functional>
+
+class NoiseField;
+
+// Told when fixed obstacles appear and disappear (they never move), so
+// structures that mirror them, such as FlowField, can be repaired in place
+class FixedObstacleListener {
+public:
+    virtual ~FixedObstacleListener() = default;
+    virtual void OnFixedObstacleAdded(int x, int y) = 0;
+    virtual void OnFixedObstacleRemoved(int x, int y) = 0;
+};
 
 class ObstacleManager {
 public:
+    // One obstacle as saved in a game snapshot
+    struct ObstacleState {
+        int x;
+        int y;
+        ObstacleType type;
+        MovementPattern pattern; // Moving obstacles only, as are the fields below
+        int direction;
+        float movement_counter;
+        float speed;
+        float exact_x;           // FLOCKING and NOISE_DRIFT only (see MovingObstacle)
+        float exact_y;
+        float velocity_x;
+        float velocity_y;
+        float lifetime;          // Seconds left
+    };
+
     explicit ObstacleManager(int grid_width, int grid_height);
     virtual ~ObstacleManager(); // Virtual destructor for inheritance
 
@@ -24,7 +55,10 @@ public:
     // Obstacle management
     void AddFixedObstacle(int x, int y, float lifetime = 12.0f);
     void AddMovingObstacle(int x, int y, MovementPattern pattern, float lifetime = 7.0f);
-    void SpawnRandomObstacle(); // Single obstacle spawning
+    void SpawnRandomObstacle(); // Single obstacle spawning, or now and then a swarm
+    // FLOCKING obstacles only come in groups: up to `count` of them on free
+    // cells within two of (x, y), all setting off the same way
+    void SpawnFlockingSwarm(int x, int y, int count, float lifetime = 7.0f);
     void ClearExpiredObstacles(); // Remove expired obstacles only
     void ClearAllObstacles();
 
@@ -40,16 +74,63 @@ public:
     virtual bool CheckCollisionWithSnake(const Snake& snake) const;
     virtual bool IsValidFoodPosition(int x, int y) const;
 
+    // At most one listener; it is not told about obstacles that already
+    // exist (pass nullptr to detach)
+    void SetFixedObstacleListener(FixedObstacleListener* listener) { fixed_listener = listener; }
+
+    // Spatial query: appends obstacles whose cell lies inside `cells`. The
+    // pointers are only good until obstacles next expire, so callers that
+    // share the manager with its lifetime thread use ForEachObstacleInRect
+    virtual void QueryObstaclesInRect(const SDL_Rect& cells,
+                                      std::vector<const Obstacle*>& out) const;
+
+    // Calls `visit` for each obstacle whose cell lies inside `cells`; the
+    // threaded manager holds its lock until the last call returns
+    virtual void ForEachObstacleInRect(const SDL_Rect& cells,
+                                       const std::function<void(const Obstacle&)>& visit) const;
+
     // Getters for game logic
     std::size_t GetObstacleCount() const { return obstacles.size(); }
     std::size_t GetFixedObstacleCount() const;
     std::size_t GetMovingObstacleCount() const;
+    int GetGridWidth() const { return grid_width; }
+    int GetGridHeight() const { return grid_height; }
 
     // Spawning configuration
     void SetSpawnRate(float obstacles_per_second);
     void SetDifficultyLevel(int level);
     void SetMovingObstacleSpeed(float speed);
     bool ShouldSpawnObstacle(float delta_time); // Check if spawn timer elapsed
+    float GetSpawnRate() const { return spawn_rate; }
+    float GetSpawnTimer() const { return spawn_timer; }
+    float GetMovingObstacleSpeed() const { return moving_obstacle_speed; }
+
+    // Makes placement reproducible (headless simulations); seeded from
+    // std::random_device otherwise
+    void SeedRandom(unsigned int seed);
+
+    // The NOISE_DRIFT flow field. The windowed game sets a new seed per
+    // game, which is cheap and drops the previous field (unless the seed is
+    // the same), then builds it with BuildNoiseField; headless games share
+    // one built field instead (SetNoiseField). Failing both, the field is
+    // built on one thread when this manager first spawns, restores or
+    // moves a drifting obstacle, so a manager that never has drifters (or
+    // only draws them, as GameClient's) never builds one.
+    void SetNoiseSeed(uint32_t seed);
+    void SetNoiseField(std::shared_ptr<const NoiseField> field); // Built; takes its seed
+    uint32_t GetNoiseSeed() const { return noise_seed; }
+    void BuildNoiseField(unsigned thread_count = 1); // 0: one thread per core
+    const NoiseField* GetNoiseField() const { return noise_field.get(); } // Null until built
+
+    // Saving and restoring games: every obstacle in update order, and the
+    // spawning state and generator behind new ones
+    virtual void CaptureObstacles(std::vector<ObstacleState>& out) const;
+    virtual void RestoreObstacles(const std::vector<ObstacleState>& states); // Replaces every obstacle
+    int GetDifficultyLevel() const { return difficulty_level; }
+    void RestoreSpawnState(int difficulty_level, float moving_obstacle_speed,
+                           float spawn_rate, float spawn_timer);
+    const std::mt19937& GetRandomEngine() const { return engine; }
+    void SetRandomEngine(const std::mt19937& state) { engine = state; }
 
 protected:
     const int grid_width;
@@ -58,6 +139,20 @@ protected:
     // Basic obstacle container (base class)
     std::vector<std::unique_ptr<Obstacle>> obstacles;
 
+    // Bucket index over `obstacles`; every insertion, move and removal must
+    // go through the helpers below to keep it in sync
+    SpatialGrid<Obstacle*> spatial_index;
+    FixedObstacleListener* fixed_listener{nullptr};
+
+    void UpdateObstacleTracked(Obstacle& obstacle);
+    std::size_t EraseExpiredObstacles();
+
+    // One movement update for every moving obstacle. FLOCKING obstacles
+    // are steered and moved together in the flock's arrays, then written
+    // back and reindexed only when they change cell; the others move one
+    // by one through Update, NOISE_DRIFT ones after sampling the field.
+    void MoveObstacles();
+
 private:
 
     // Random number generation for obstacle placement
@@ -66,6 +161,19 @@ private:
     mutable std::uniform_int_distribution<int> random_x;
     mutable std::uniform_int_distribution<int> random_y;
 
+    // Moving obstacles sorted each update: FLOCKING ones (also copied into
+    // the flock's arrays) and the rest
+    Flock flock;
+    Flock::Weights flock_weights;
+    std::vector<MovingObstacle*> flock_members;
+    std::vector<MovingObstacle*> pattern_movers;
+
+    static constexpr int kSwarmSize = 6;
+    static constexpr int kNoiseDriftLevel = 3; // First difficulty level with drifters
+
+    uint32_t noise_seed{0};
+    std::shared_ptr<const NoiseField> noise_field;
+
     // Configuration
     int difficulty_level{1};
     float moving_obstacle_speed{0.05f};
@@ -0,0 +1,30 @@
+#include "occupancy_grid.h"
+#include <algorithm>
+
+OccupancyGrid::OccupancyGrid(int width, int height)
+    : width(width),
+      height(height),
+      counts(static_cast<std::size_t>(width) * height, 0) {
+}
+
+void OccupancyGrid::Add(int x, int y) {
+    if (InBounds(x, y)) {
+        uint8_t& count = counts[Index(x, y)];
+        if (count < UINT8_MAX) {
+            ++count;
+        }
+    }
+}
+
+void OccupancyGrid::Remove(int x, int y) {
+    if (InBounds(x, y)) {
+        uint8_t& count = counts[Index(x, y)];
+        if (count > 0) {
+            --count;
+        }
+    }
+}
+
+void OccupancyGrid::Clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+}
@@ -0,0 +1,43 @@
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include <cstdint>
+#include <vector>
+
+// Per-cell occupancy counts for O(1) "is anything here" queries. Counts
+// rather than flags so that overlapping entries can be removed one at a time.
+class OccupancyGrid {
+public:
+    OccupancyGrid(int width, int height);
+
+    void Add(int x, int y);
+    void Remove(int x, int y);
+    void Clear();
+
+    bool IsOccupied(int x, int y) const {
+        return InBounds(x, y) && counts[Index(x, y)] != 0;
+    }
+    uint8_t GetCount(int x, int y) const {
+        return InBounds(x, y) ? counts[Index(x, y)] : 0;
+    }
+
+    // Row-major counts, one byte per cell
+    const uint8_t* GetData() const { return counts.data(); }
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+private:
+    int width;
+    int height;
+    std::vector<uint8_t> counts;
+
+    bool InBounds(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+    std::size_t Index(int x, int y) const {
+        return static_cast<std::size_t>(y) * width + x;
+    }
+};
+
+#endif
@@ -0,0 +1,112 @@
+// Pathfinding benchmark: times PathfindingEngine queries between random
+// cells on boards from 64x64 to 1024x1024 with 20% of cells blocked, and
+// counts heap allocations made by the timed queries (expected: none).
+//
+// Usage: PathfindingBenchmark [queries per board] [seed]
+
+#include "pathfinding_engine.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+    std::atomic<uint64_t> allocation_count{0};
+}
+
+// Count every allocation in the process
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    SDL_Point RandomOpenCell(const PathfindingEngine& engine, std::mt19937& rng) {
+        std::uniform_int_distribution<int> random_x(0, engine.GetWidth() - 1);
+        std::uniform_int_distribution<int> random_y(0, engine.GetHeight() - 1);
+        while (true) {
+            SDL_Point cell{random_x(rng), random_y(rng)};
+            if (!engine.IsBlocked(cell.x, cell.y)) {
+                return cell;
+            }
+        }
+    }
+
+    void BenchmarkBoard(int size, std::size_t queries, uint32_t seed) {
+        std::mt19937 rng(seed);
+        PathfindingEngine engine(size, size);
+        std::bernoulli_distribution blocked(0.2);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (blocked(rng)) {
+                    engine.SetBlocked(x, y);
+                }
+            }
+        }
+
+        std::vector<std::pair<SDL_Point, SDL_Point>> pairs;
+        pairs.reserve(queries);
+        for (std::size_t i = 0; i < queries; ++i) {
+            pairs.emplace_back(RandomOpenCell(engine, rng), RandomOpenCell(engine, rng));
+        }
+
+        // Warm up: the path vector grows to the longest path once
+        std::vector<SDL_Point> path;
+        path.reserve(static_cast<std::size_t>(size) * size);
+        engine.FindPath(pairs[0].first, pairs[0].second, path);
+
+        uint64_t expanded = 0;
+        uint64_t path_cells = 0;
+        std::size_t found = 0;
+        uint64_t allocations_before = allocation_count;
+        auto start = Clock::now();
+        for (const auto& pair : pairs) {
+            if (engine.FindPath(pair.first, pair.second, path)) {
+                ++found;
+                path_cells += path.size();
+            }
+            expanded += engine.GetExpandedCount();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        uint64_t allocations = allocation_count - allocations_before;
+
+        std::cout << std::setw(4) << size << "x" << std::left << std::setw(5) << size << std::right
+                  << std::fixed << std::setprecision(2)
+                  << " query avg " << std::setw(9) << seconds * 1e6 / queries << " us"
+                  << "  expanded avg " << std::setw(8) << expanded / queries
+                  << "  " << std::setw(6) << std::setprecision(1) << expanded / seconds / 1e6 << " M nodes/s"
+                  << "  found " << found << "/" << queries
+                  << " (avg length " << (found ? path_cells / found : 0) << ")"
+                  << "  allocations " << allocations << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t queries = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1;
+    queries = queries == 0 ? 1 : queries;
+
+    std::cout << "Pathfinding benchmark: " << queries << " random queries per board, 20% blocked" << std::endl;
+    for (int size : {64, 128, 256, 512, 1024}) {
+        BenchmarkBoard(size, queries, seed);
+    }
+    return 0;
+}
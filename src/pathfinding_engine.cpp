@@ -0,0 +1,174 @@
+#include "pathfinding_engine.h"
+#include <algorithm>
+#include <cstdlib>
+
+PathfindingEngine::PathfindingEngine(int grid_width, int grid_height) {
+    Resize(grid_width, grid_height);
+}
+
+void PathfindingEngine::Resize(int grid_width, int grid_height) {
+    width = std::max(grid_width, 1);
+    height = std::max(grid_height, 1);
+    std::size_t count = static_cast<std::size_t>(width) * height;
+    if (cells.size() < count) {
+        cells.resize(count);
+        blocked.resize(count);
+    }
+    // Stale stamps from the old size would be misread with new indices
+    std::fill(cells.begin(), cells.end(), CellState{0, 0, -1, -1});
+    std::fill(blocked.begin(), blocked.end(), 0u);
+    generation = 0;
+    blocked_generation = 1;
+    if (heap.capacity() < count) {
+        heap.reserve(count);
+    }
+}
+
+void PathfindingEngine::ClearBlocked() {
+    if (++blocked_generation == 0) {
+        std::fill(blocked.begin(), blocked.end(), 0u);
+        blocked_generation = 1;
+    }
+}
+
+void PathfindingEngine::SetBlocked(int x, int y) {
+    if (x >= 0 && x < width && y >= 0 && y < height) {
+        blocked[static_cast<std::size_t>(y) * width + x] = blocked_generation;
+    }
+}
+
+bool PathfindingEngine::IsBlocked(int x, int y) const {
+    return x >= 0 && x < width && y >= 0 && y < height &&
+           blocked[static_cast<std::size_t>(y) * width + x] == blocked_generation;
+}
+
+void PathfindingEngine::StartQuery() {
+    if (++generation == 0) {
+        // Wrapped after 2^32 queries: old stamps could now look current
+        for (auto& cell : cells) cell.stamp = 0;
+        generation = 1;
+    }
+    heap.clear();
+    expanded = 0;
+}
+
+uint32_t PathfindingEngine::Heuristic(int x, int y, int goal_x, int goal_y) const {
+    int dx = std::abs(x - goal_x);
+    int dy = std::abs(y - goal_y);
+    if (wrapping) {
+        dx = std::min(dx, width - dx);
+        dy = std::min(dy, height - dy);
+    }
+    return static_cast<uint32_t>(dx + dy);
+}
+
+bool PathfindingEngine::FindPath(const SDL_Point& start, const SDL_Point& goal,
+                                 std::vector<SDL_Point>& path) {
+    path.clear();
+    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height ||
+        goal.x < 0 || goal.x >= width || goal.y < 0 || goal.y >= height ||
+        IsBlocked(goal.x, goal.y)) {
+        return false;
+    }
+
+    StartQuery();
+    const int32_t start_cell = start.y * width + start.x;
+    const int32_t goal_cell = goal.y * width + goal.x;
+    cells[start_cell] = CellState{generation, 0, -1, -1};
+    HeapPush(HeapNode{Heuristic(start.x, start.y, goal.x, goal.y), 0, start_cell});
+
+    const int dx[] = {0, 1, 0, -1};
+    const int dy[] = {-1, 0, 1, 0};
+
+    while (!heap.empty()) {
+        HeapNode current = HeapPop();
+        cells[current.cell].heap_pos = -1; // Closed
+        ++expanded;
+
+        if (current.cell == goal_cell) {
+            for (int32_t cell = goal_cell; cell != -1; cell = cells[cell].parent) {
+                path.push_back(SDL_Point{cell % width, cell / width});
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        int x = current.cell % width;
+        int y = current.cell / width;
+        uint32_t next_g = current.g + 1;
+        for (int i = 0; i < 4; ++i) {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) {
+                if (!wrapping) continue;
+                nx = (nx + width) % width;
+                ny = (ny + height) % height;
+            }
+            int32_t neighbor = ny * width + nx;
+            if (blocked[neighbor] == blocked_generation) continue;
+
+            CellState& state = cells[neighbor];
+            if (state.stamp != generation) {
+                state = CellState{generation, next_g, current.cell, -1};
+                HeapPush(HeapNode{next_g + Heuristic(nx, ny, goal.x, goal.y), next_g, neighbor});
+            } else if (state.heap_pos >= 0 && next_g < state.g) {
+                // Decrease-key: the heuristic part of f is unchanged
+                HeapNode& node = heap[state.heap_pos];
+                node.f -= state.g - next_g;
+                node.g = next_g;
+                state.g = next_g;
+                state.parent = current.cell;
+                SiftUp(static_cast<std::size_t>(state.heap_pos));
+            }
+            // Closed cells are final: the heuristic is consistent
+        }
+    }
+    return false;
+}
+
+void PathfindingEngine::Place(std::size_t pos, const HeapNode& node) {
+    heap[pos] = node;
+    cells[node.cell].heap_pos = static_cast<int32_t>(pos);
+}
+
+void PathfindingEngine::HeapPush(const HeapNode& node) {
+    heap.push_back(node);
+    cells[node.cell].heap_pos = static_cast<int32_t>(heap.size() - 1);
+    SiftUp(heap.size() - 1);
+}
+
+PathfindingEngine::HeapNode PathfindingEngine::HeapPop() {
+    HeapNode top = heap.front();
+    HeapNode last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        Place(0, last);
+        SiftDown(0);
+    }
+    return top;
+}
+
+void PathfindingEngine::SiftUp(std::size_t pos) {
+    HeapNode node = heap[pos];
+    while (pos > 0) {
+        std::size_t parent = (pos - 1) / 2;
+        if (!Before(node, heap[parent])) break;
+        Place(pos, heap[parent]);
+        pos = parent;
+    }
+    Place(pos, node);
+}
+
+void PathfindingEngine::SiftDown(std::size_t pos) {
+    HeapNode node = heap[pos];
+    std::size_t size = heap.size();
+    while (true) {
+        std::size_t child = 2 * pos + 1;
+        if (child >= size) break;
+        if (child + 1 < size && Before(heap[child + 1], heap[child])) ++child;
+        if (!Before(heap[child], node)) break;
+        Place(pos, heap[child]);
+        pos = child;
+    }
+    Place(pos, node);
+}
@@ -0,0 +1,83 @@
+#ifndef PATHFINDING_ENGINE_H
+#define PATHFINDING_ENGINE_H
+
+#include "SDL.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Reusable A* search on a 4-connected grid with unit step costs.
+//
+// Per-cell search state (g-cost, parent, heap position) lives in one flat
+// array indexed by cell. Each entry carries the generation of the query
+// that last touched it, so an entry from an older query reads as
+// "unvisited" and starting a query is O(1) instead of clearing the grid.
+// Blocked cells use the same trick. The open set is an indexed binary heap
+// of POD nodes with a real decrease-key, so each cell is queued at most
+// once. After the first query at a given grid size nothing is allocated
+// (the caller's path vector is reused too).
+class PathfindingEngine {
+public:
+    PathfindingEngine(int grid_width, int grid_height);
+
+    // Reallocates only when the grid grows
+    void Resize(int grid_width, int grid_height);
+
+    // When set, paths may leave one edge and enter at the opposite one, as
+    // the snake does
+    void SetWrapping(bool wrap) { wrapping = wrap; }
+
+    // Blocked cells apply to every query until ClearBlocked (O(1))
+    void ClearBlocked();
+    void SetBlocked(int x, int y);
+    bool IsBlocked(int x, int y) const;
+
+    // Fills `path` with the cells from `start` to `goal` inclusive; returns
+    // false (and leaves `path` empty) if the goal cannot be reached
+    bool FindPath(const SDL_Point& start, const SDL_Point& goal, std::vector<SDL_Point>& path);
+
+    // Statistics for the last FindPath
+    std::size_t GetExpandedCount() const { return expanded; }
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+private:
+    struct CellState {
+        uint32_t stamp;   // Generation of the query that set the fields below
+        uint32_t g;       // Steps from the start
+        int32_t parent;   // Cell index, -1 for the start
+        int32_t heap_pos; // Position in `heap`, -1 once expanded
+    };
+
+    struct HeapNode {
+        uint32_t f;
+        uint32_t g;
+        int32_t cell;
+    };
+
+    int width{0};
+    int height{0};
+    bool wrapping{false};
+    std::vector<CellState> cells;
+    std::vector<uint32_t> blocked; // Equal to blocked_generation when blocked
+    std::vector<HeapNode> heap;
+    uint32_t generation{0};
+    uint32_t blocked_generation{1};
+    std::size_t expanded{0};
+
+    uint32_t Heuristic(int x, int y, int goal_x, int goal_y) const;
+    void StartQuery();
+
+    // Binary min-heap on f, ties broken toward larger g (deeper nodes)
+    static bool Before(const HeapNode& a, const HeapNode& b) {
+        return a.f < b.f || (a.f == b.f && a.g > b.g);
+    }
+    void HeapPush(const HeapNode& node);
+    HeapNode HeapPop();
+    void SiftUp(std::size_t pos);
+    void SiftDown(std::size_t pos);
+    void Place(std::size_t pos, const HeapNode& node);
+};
+
+#endif
@@ -0,0 +1,112 @@
+// Monte Carlo planner benchmark: measures cloning a SimState, capturing one
+// from a Simulation, and full games played by MonteCarloPlanner, reporting
+// rollouts and decisions per second and the average score.
+//
+// Usage: PlannerBenchmark [games] [rollouts per direction] [rollout ticks] [threads] [seed]
+
+#include "monte_carlo_planner.h"
+#include "sim_state.h"
+#include "simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  int games = argc > 1 ? std::atoi(argv[1]) : 5;
+  MonteCarloPlanner::Options options;
+  options.rolloutsPerDirection = argc > 2 ? std::atoi(argv[2]) : 64;
+  options.rolloutTicks = argc > 3 ? std::atoi(argv[3]) : 180;
+  options.threadCount = argc > 4 ? static_cast<unsigned>(std::strtoul(argv[4], nullptr, 10)) : 0;
+  uint32_t seed = argc > 5 ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 1;
+  games = std::max(games, 1);
+  const uint64_t max_ticks = 60 * 60 * 5; // Five simulated minutes per game
+
+  BoardConfig config;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "SimState: " << sizeof(SimState) << " bytes" << std::endl;
+
+  // Clone cost: copies into a ring of states so the copies are not elided
+  {
+    std::vector<SimState> copies(64);
+    SimState state;
+    state.Reset(config, seed);
+    const int clone_count = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < clone_count; ++i) {
+      copies[i & 63] = state;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    volatile uint32_t sink = copies[clone_count & 63].GetTicks();
+    (void)sink;
+    std::cout << "Clone: " << seconds * 1e9 / clone_count << " ns" << std::endl;
+  }
+
+  // Capture cost from a game with some obstacles on the board
+  {
+    Simulation simulation(config, seed);
+    for (int i = 0; i < 600 && !simulation.IsOver(); ++i) {
+      simulation.Step();
+    }
+    SimState state;
+    const int capture_count = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < capture_count; ++i) {
+      SimState::Capture(simulation, seed + i, state);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Capture: " << seconds * 1e6 / capture_count << " us ("
+              << state.GetObstacleCount() << " obstacles)" << std::endl;
+  }
+
+  MonteCarloPlanner planner(options);
+  std::cout << "Planning with " << planner.GetThreadCount() << " threads, "
+            << options.rolloutsPerDirection << " rollouts per direction of "
+            << options.rolloutTicks << " ticks" << std::endl;
+
+  int score_sum = 0;
+  int best_score = 0;
+  uint64_t unfit = 0; // Decisions left to the current direction
+  auto start = std::chrono::steady_clock::now();
+  for (int game = 0; game < games; ++game) {
+    Simulation simulation(config, seed + game);
+    SimState state;
+    SDL_Point last_head{-1, -1};
+    while (!simulation.IsOver() && simulation.GetTicks() < max_ticks) {
+      // Decide once per cell, as the autopilot does
+      Snake &snake = simulation.GetSnake();
+      SDL_Point head{static_cast<int>(snake.head_x), static_cast<int>(snake.head_y)};
+      if (head.x != last_head.x || head.y != last_head.y) {
+        last_head = head;
+        if (SimState::Capture(simulation, seed ^ simulation.GetTicks(), state)) {
+          Snake::Direction direction = planner.Plan(state);
+          if (!snake.IsReverse(direction)) {
+            snake.direction = direction;
+          }
+        } else {
+          ++unfit;
+        }
+      }
+      simulation.Step();
+    }
+    score_sum += simulation.GetScore();
+    best_score = std::max(best_score, simulation.GetScore());
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  double plan_seconds = std::chrono::duration<double>(planner.GetTotalPlanTime()).count();
+  std::cout << "Games: " << games << " in " << std::setprecision(2) << seconds << " s" << std::endl;
+  std::cout << "Average score: " << std::setprecision(1) << static_cast<double>(score_sum) / games
+            << " (best " << best_score << ")" << std::endl;
+  std::cout << "Decisions: " << planner.GetPlanCount() << " ("
+            << planner.GetPlanCount() / std::max(plan_seconds, 1e-9) << "/s, "
+            << plan_seconds * 1e3 / std::max<uint64_t>(planner.GetPlanCount(), 1) << " ms each, " << unfit << " skipped as too large for a SimState)" << std::endl;
+  std::cout << "Rollouts: " << planner.GetRolloutCount() << " ("
+            << std::setprecision(0) << planner.GetRolloutCount() / std::max(plan_seconds, 1e-9) << "/s)"
+            << std::endl;
+  return 0;
+}
@@ -8,9 +8,11 @@
 
 Renderer::Renderer(const std::size_t screen_width,
                    const std::size_t screen_height,
-                   const std::size_t grid_width, const std::size_t grid_height)
+                   const std::size_t grid_width, const std::size_t grid_height,
+                   bool vsync)
     : screen_width(screen_width), screen_height(screen_height),
-      grid_width(grid_width), grid_height(grid_height), font(nullptr), large_font(nullptr) {
+      grid_width(grid_width), grid_height(grid_height), font(nullptr), large_font(nullptr),
+      camera(screen_width, screen_height, grid_width, grid_height) {
   // Initialize SDL
   if (SDL_Init(SDL_INIT_VIDEO) < 0) {
     std::cerr << "SDL could not initialize.\n";
@@ -34,7 +36,11 @@ Renderer::Renderer(const std::size_t screen_width,
   }
 
   // Create renderer
-  sdl_renderer = SDL_CreateRenderer(sdl_window, -1, SDL_RENDERER_ACCELERATED);
+  Uint32 renderer_flags = SDL_RENDERER_ACCELERATED;
+  if (vsync) {
+    renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+  }
+  sdl_renderer = SDL_CreateRenderer(sdl_window, -1, renderer_flags);
   if (nullptr == sdl_renderer) {
     std::cerr << "Renderer could not be created.\n";
     std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
@@ -42,9 +48,16 @@ Renderer::Renderer(const std::size_t screen_width,
 
   // Load fonts
   LoadFonts();
+
+  // Generate playfield sprites once; falls back to solid cells on failure
+  if (sdl_renderer != nullptr) {
+    sprite_atlas = std::make_unique<SpriteAtlas>(sdl_renderer);
+  }
 }
 
 Renderer::~Renderer() {
+  StopRecording();
+  sprite_atlas.reset(); // Texture must go before its renderer
   CleanupFonts();
   SDL_DestroyRenderer(sdl_renderer);
   SDL_DestroyWindow(sdl_window);
@@ -52,7 +65,7 @@ Renderer::~Renderer() {
   SDL_Quit();
 }
 
-void Renderer::RenderPlaying(Snake const snake, SDL_Point const &food) {
+void Renderer::RenderPlaying(const Snake& snake, SDL_Point const &food) {
   SDL_Rect block;
   block.w = screen_width / grid_width;
   block.h = screen_height / grid_height;
@@ -86,7 +99,7 @@ void Renderer::RenderPlaying(Snake const snake, SDL_Point const &food) {
   SDL_RenderFillRect(sdl_renderer, &block);
 
   // Update Screen
-  SDL_RenderPresent(sdl_renderer);
+  PresentScreen();
 }
 
 
@@ -97,6 +110,14 @@ void Renderer::UpdateWindowTitle(int score, int fps) {
 }
 
 
+int Renderer::GetDisplayRefreshRate() const {
+  SDL_DisplayMode mode;
+  if (sdl_window == nullptr || SDL_GetWindowDisplayMode(sdl_window, &mode) != 0) {
+    return 0;
+  }
+  return mode.refresh_rate;
+}
+
 void Renderer::RenderNameInput(const std::string& currentInput) {
   RenderNameInputWithValidation(currentInput, "");
 }
@@ -141,8 +162,8 @@ void Renderer::RenderNameInputWithValidation(const std::string& currentInput, co
 }
 
 
-void Renderer::RenderEnhancedHighScores(const std::vector<ScoreEntry>& scores,
-                                        std::function<std::string(const std::string&)> formatTimestamp) {
+void Renderer::RenderEnhancedHighScores(const std::vector<ScoreDisplayRow>& rows,
+                                        const std::string& boardName) {
   ClearScreen();
 
   SDL_Color white = GetColor(255, 255, 255);
@@ -156,12 +177,12 @@ void Renderer::RenderEnhancedHighScores(const std::vector<ScoreEntry>& scores,
 
   RenderTextTTF("HIGH SCORES", centerX - 80, 20, gold, true);
 
-  if (scores.empty()) {
+  if (rows.empty()) {
     RenderTextTTF("No scores yet!", centerX - 60, startY + 50, white);
   } else {
     RenderTextTTF("Rank  Player               Score    Date", centerX - 180, startY, lightGray);
 
-    for (std::size_t i = 0; i < scores.size() && i < 10; ++i) {
+    for (std::size_t i = 0; i < rows.size() && i < 10; ++i) {
       SDL_Color rankColor = white;
       if (i == 0) rankColor = gold;
       else if (i == 1) rankColor = silver;
@@ -169,22 +190,18 @@ void Renderer::RenderEnhancedHighScores(const std::vector<ScoreEntry>& scores,
 
       int lineY = startY + 40 + i * 25;
 
-      std::string rank = std::to_string(i + 1) + ".";
-      std::string playerName = scores[i].playerName;
-      std::string scoreStr = std::to_string(scores[i].score);
-      std::string formattedTime = formatTimestamp(scores[i].timestamp);
-
-      if (playerName.length() > 15) {
-        playerName = playerName.substr(0, 12) + "...";
-      }
-
-      RenderTextTTF(rank, centerX - 180, lineY, rankColor);
-      RenderTextTTF(playerName, centerX - 150, lineY, white);
-      RenderTextTTF(scoreStr, centerX - 30, lineY, rankColor);
-      RenderTextTTF(formattedTime, centerX + 20, lineY, lightGray);
+      // Rows arrive preformatted (and cached) from HighScoreManager
+      const ScoreDisplayRow& row = rows[i];
+      RenderTextTTF(row.rank, centerX - 180, lineY, rankColor);
+      RenderTextTTF(row.playerName, centerX - 150, lineY, white);
+      RenderTextTTF(row.score, centerX - 30, lineY, rankColor);
+      RenderTextTTF(row.date, centerX + 20, lineY, lightGray);
     }
   }
 
+  // Scores are per board configuration; say which one is shown
+  RenderTextTTF("Board: " + boardName, centerX - 180, startY + 290, lightGray);
+
   RenderTextTTF("Press R to restart", centerX - 80, startY + 320, GetColor(128, 128, 128));
   RenderTextTTF("Press ESC to go back", centerX - 90, startY + 350, GetColor(128, 128, 128));
 
@@ -255,9 +272,60 @@ void Renderer::ClearScreen() {
 }
 
 void Renderer::PresentScreen() {
+  // Read back before presenting; the back buffer is undefined afterwards
+  CaptureFrame();
   SDL_RenderPresent(sdl_renderer);
 }
 
+bool Renderer::StartRecording(CaptureFormat format, const std::string& outputPath, int framesPerSecond) {
+  StopRecording();
+  frame_recorder = std::make_unique<FrameRecorder>(format, outputPath, framesPerSecond);
+  frame_recorder->Start();
+  if (!frame_recorder->IsRecording()) {
+    frame_recorder.reset();
+    return false;
+  }
+  std::cout << "Recording session to: " << outputPath << "\n";
+  return true;
+}
+
+void Renderer::StopRecording() {
+  if (frame_recorder) {
+    frame_recorder->Stop(); // Flushes frames still queued for encoding
+    frame_recorder->LogRecordingReport();
+    frame_recorder.reset();
+  }
+}
+
+void Renderer::CaptureFrame() {
+  if (!frame_recorder) {
+    return;
+  }
+
+  int width = 0;
+  int height = 0;
+  if (SDL_GetRendererOutputSize(sdl_renderer, &width, &height) != 0) {
+    return;
+  }
+
+  // Null when the encoder is behind; the frame is dropped, never waited on.
+  // Also null once a Y4M capture has stopped because the output was resized
+  CapturedFrame* frame = frame_recorder->AcquireFrame(width, height);
+  if (frame == nullptr) {
+    if (!frame_recorder->IsRecording()) {
+      StopRecording();
+    }
+    return;
+  }
+
+  if (SDL_RenderReadPixels(sdl_renderer, nullptr, SDL_PIXELFORMAT_RGBA32,
+                           frame->pixels.data(), width * 4) != 0) {
+    frame_recorder->ReleaseFrame(frame);
+    return;
+  }
+  frame_recorder->SubmitFrame(frame);
+}
+
 SDL_Color Renderer::GetColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
   SDL_Color color;
   color.r = r;
@@ -303,46 +371,114 @@ void Renderer::CleanupFonts() {
 
 void Renderer::RenderPlayingWithObstacles(const Snake& snake, const SDL_Point& food,
                                          const ObstacleManager& obstacleManager) {
-  SDL_Rect block;
-  block.w = screen_width / grid_width;
-  block.h = screen_height / grid_height;
+  camera.Follow(snake.head_x, snake.head_y);
+  const SDL_Rect visible = camera.GetVisibleCells();
 
   // Clear screen
   ClearScreen();
 
+  if (sprite_atlas && sprite_atlas->IsReady()) {
+    RenderPlayfieldSprites(snake, food, obstacleManager, visible);
+    PresentScreen();
+    return;
+  }
+
   // Render food
-  SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xCC, 0x00, 0xFF);
-  block.x = food.x * block.w;
-  block.y = food.y * block.h;
-  SDL_RenderFillRect(sdl_renderer, &block);
+  if (camera.IsCellVisible(food.x, food.y)) {
+    SDL_Rect block = camera.CellToScreen(food.x, food.y);
+    SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xCC, 0x00, 0xFF);
+    SDL_RenderFillRect(sdl_renderer, &block);
+  }
 
   // Render obstacles
   RenderObstacles(obstacleManager);
 
+  // Render snake
+  RenderSnake(snake, visible);
+
+  // Update screen
+  PresentScreen();
+}
+
+void Renderer::RenderPlayfieldSprites(const Snake& snake, const SDL_Point& food,
+                                      const ObstacleManager& obstacleManager, const SDL_Rect& visible) {
+  // Queue order is draw order: food, obstacles, body, head
+  sprite_atlas->Begin();
+
+  if (camera.IsCellVisible(food.x, food.y)) {
+    sprite_atlas->Queue(SpriteId::FOOD, camera.CellToScreen(food.x, food.y));
+  }
+
+  obstacleManager.ForEachObstacleInRect(visible, [this](const Obstacle& obstacle) {
+    SpriteId sprite = SpriteId::FIXED_OBSTACLE;
+    if (obstacle.GetType() == ObstacleType::MOVING) {
+      const auto& moving_obstacle = static_cast<const MovingObstacle&>(obstacle);
+      sprite = SpriteAtlas::GetMovingObstacleSprite(moving_obstacle.GetPattern());
+    }
+    sprite_atlas->Queue(sprite, camera.CellToScreen(obstacle.GetX(), obstacle.GetY()));
+  });
+
+  CollectVisibleBody(snake, visible);
+  for (const SDL_Point& point : visible_body) {
+    sprite_atlas->Queue(SpriteId::SNAKE_BODY, camera.CellToScreen(point.x, point.y));
+  }
+
+  sprite_atlas->Queue(snake.alive ? SpriteId::SNAKE_HEAD : SpriteId::SNAKE_HEAD_DEAD,
+                      camera.CellToScreen(static_cast<int>(snake.head_x), static_cast<int>(snake.head_y)));
+
+  sprite_atlas->Flush();
+}
+
+void Renderer::CollectVisibleBody(const Snake& snake, const SDL_Rect& visible) {
+  // Walk whichever is smaller: the body, or the visible cells through the
+  // snake's occupancy grid. Either way the cost is bounded by the view.
+  visible_body.clear();
+  const std::size_t visible_cells = static_cast<std::size_t>(visible.w) * visible.h;
+  if (snake.body.size() <= visible_cells) {
+    for (SDL_Point const &point : snake.body) {
+      if (camera.IsCellVisible(point.x, point.y)) {
+        visible_body.push_back(point);
+      }
+    }
+  } else {
+    for (int y = visible.y; y < visible.y + visible.h; ++y) {
+      for (int x = visible.x; x < visible.x + visible.w; ++x) {
+        if (snake.BodyCell(x, y)) {
+          visible_body.push_back({x, y});
+        }
+      }
+    }
+  }
+}
+
+void Renderer::RenderSnake(const Snake& snake, const SDL_Rect& visible) {
+  CollectVisibleBody(snake, visible);
+  body_rects.clear();
+  for (const SDL_Point& point : visible_body) {
+    body_rects.push_back(camera.CellToScreen(point.x, point.y));
+  }
+
   // Render snake's body
   SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xFF, 0xFF, 0xFF);
-  for (SDL_Point const &point : snake.body) {
-    block.x = point.x * block.w;
-    block.y = point.y * block.h;
-    SDL_RenderFillRect(sdl_renderer, &block);
+  if (!body_rects.empty()) {
+    SDL_RenderFillRects(sdl_renderer, body_rects.data(), static_cast<int>(body_rects.size()));
   }
 
   // Render snake's head
-  block.x = static_cast<int>(snake.head_x) * block.w;
-  block.y = static_cast<int>(snake.head_y) * block.h;
+  SDL_Rect block = camera.CellToScreen(static_cast<int>(snake.head_x), static_cast<int>(snake.head_y));
   if (snake.alive) {
     SDL_SetRenderDrawColor(sdl_renderer, 0x00, 0x7A, 0xCC, 0xFF);
   } else {
     SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0x00, 0x00, 0xFF);
   }
   SDL_RenderFillRect(sdl_renderer, &block);
-
-  // Update screen
-  PresentScreen();
 }
 
 void Renderer::RenderObstacles(const ObstacleManager& obstacleManager) const {
-  obstacleManager.RenderObstacles(sdl_renderer, screen_width, screen_height, grid_width, grid_height);
+  // Only obstacles inside the camera view are fetched from the spatial index
+  obstacleManager.ForEachObstacleInRect(camera.GetVisibleCells(), [this](const Obstacle& obstacle) {
+    RenderObstacle(obstacle);
+  });
 }
 
 void Renderer::RenderObstacle(const Obstacle& obstacle) const {
@@ -368,22 +504,19 @@ void Renderer::RenderMovingObstacle(int x, int y, MovementPattern pattern) const
 }
 
 void Renderer::DrawObstacleCell(int x, int y, const SDL_Color& color) const {
-  SDL_Rect block;
-  block.w = screen_width / grid_width;
-  block.h = screen_height / grid_height;
-  block.x = x * block.w;
-  block.y = y * block.h;
+  SDL_Rect block = camera.CellToScreen(x, y);
 
   SDL_SetRenderDrawColor(sdl_renderer, color.r, color.g, color.b, color.a);
   SDL_RenderFillRect(sdl_renderer, &block);
 }
 
 void Renderer::DrawMovingObstacleWithPattern(int x, int y, MovementPattern pattern) const {
-  SDL_Rect block;
-  block.w = screen_width / grid_width;
-  block.h = screen_height / grid_height;
-  block.x = x * block.w;
-  block.y = y * block.h;
+  SDL_Rect block = camera.CellToScreen(x, y);
+
+  // Accents are unreadable at far zoom levels; skip the extra draw calls
+  if (block.w < kMinAccentCellSize) {
+    return;
+  }
 
   SDL_Color accent_color = GetMovingObstacleAccentColor();
   SDL_SetRenderDrawColor(sdl_renderer, accent_color.r, accent_color.g, accent_color.b, accent_color.a);
@@ -451,6 +584,26 @@ void Renderer::DrawMovingObstacleWithPattern(int x, int y, MovementPattern patte
       SDL_RenderDrawLine(sdl_renderer, block.x + block.w/2, block.y + block.h/2 - 1,
                         block.x + block.w/2, block.y + block.h/2 + 1);
       break;
+
+    case MovementPattern::FLOCKING:
+      // Draw three small chevrons in formation
+      for (int i = 0; i < 3; ++i) {
+        int cx = block.x + (i + 1) * block.w / 4;
+        int cy = block.y + (i == 1 ? block.h/3 : 2*block.h/3);
+        SDL_RenderDrawLine(sdl_renderer, cx - 2, cy + 2, cx, cy);
+        SDL_RenderDrawLine(sdl_renderer, cx, cy, cx + 2, cy + 2);
+      }
+      break;
+
+    case MovementPattern::NOISE_DRIFT:
+      // Draw two wavy lines
+      for (int row = 1; row <= 2; ++row) {
+        int wave_y = block.y + row * block.h/3;
+        SDL_RenderDrawLine(sdl_renderer, block.x + 2, wave_y, block.x + block.w/3, wave_y - 2);
+        SDL_RenderDrawLine(sdl_renderer, block.x + block.w/3, wave_y - 2, block.x + 2*block.w/3, wave_y + 2);
+        SDL_RenderDrawLine(sdl_renderer, block.x + 2*block.w/3, wave_y + 2, block.x + block.w - 2, wave_y);
+      }
+      break;
   }
 }
 
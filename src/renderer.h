@@ -7,10 +7,12 @@
 #include "score_entry.h"
 #include "obstacle_manager.h"
 #include "obstacle.h"
+#include "frame_recorder.h"
+#include "camera.h"
+#include "sprite_atlas.h"
 #include <vector>
 #include <string>
 #include <memory>
-#include <functional>
 
 enum class GameState;
 
@@ -29,13 +31,15 @@ using TTFFontPtr = std::unique_ptr<TTF_Font, TTFFontDeleter>;
 class Renderer {
 public:
   Renderer(const std::size_t screen_width, const std::size_t screen_height,
-           const std::size_t grid_width, const std::size_t grid_height);
+           const std::size_t grid_width, const std::size_t grid_height,
+           bool vsync = false);
   ~Renderer();
 
-  void RenderPlaying(Snake const snake, SDL_Point const &food);
+  void RenderPlaying(const Snake& snake, SDL_Point const &food);
   void RenderPlayingWithObstacles(const Snake& snake, const SDL_Point& food,
                                  const ObstacleManager& obstacleManager);
   void UpdateWindowTitle(int score, int fps);
+  int GetDisplayRefreshRate() const; // Of the display showing the window; 0 if unknown
 
   // New obstacle rendering methods
   void RenderObstacles(const ObstacleManager& obstacleManager) const;
@@ -45,32 +49,51 @@ public:
 
   void RenderNameInput(const std::string& currentInput);
   void RenderNameInputWithValidation(const std::string& currentInput, const std::string& validationMessage);
-  void RenderEnhancedHighScores(const std::vector<ScoreEntry>& scores,
-                                std::function<std::string(const std::string&)> formatTimestamp);
+  void RenderEnhancedHighScores(const std::vector<ScoreDisplayRow>& rows, const std::string& boardName);
   void RenderGameOverScreen(int score, bool isHighScore);
 
+  // Session capture (see FrameRecorder)
+  bool StartRecording(CaptureFormat format, const std::string& outputPath, int framesPerSecond);
+  void StopRecording();
+
+  Camera& GetCamera() { return camera; }
+
 private:
   SDL_Window *sdl_window;
   SDL_Renderer *sdl_renderer;
   TTFFontPtr font;
   TTFFontPtr large_font;
+  std::unique_ptr<FrameRecorder> frame_recorder;
+  std::unique_ptr<SpriteAtlas> sprite_atlas;
 
   const std::size_t screen_width;
   const std::size_t screen_height;
   const std::size_t grid_width;
   const std::size_t grid_height;
 
+  Camera camera;
+
+  // Per-frame scratch buffers, reused to avoid allocating while drawing
+  std::vector<SDL_Point> visible_body;
+  std::vector<SDL_Rect> body_rects;
+
   static constexpr int kFontSize = 18;
   static constexpr int kLargeFontSize = 28;
+  static constexpr int kMinAccentCellSize = 8;
 
   void RenderTextTTF(const std::string& text, int x, int y, SDL_Color color, bool large = false);
   void ClearScreen();
   void PresentScreen();
+  void CaptureFrame();
   SDL_Color GetColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);
   void LoadFonts();
   void CleanupFonts();
 
   // New rendering helper methods
+  void RenderSnake(const Snake& snake, const SDL_Rect& visible);
+  void RenderPlayfieldSprites(const Snake& snake, const SDL_Point& food,
+                              const ObstacleManager& obstacleManager, const SDL_Rect& visible);
+  void CollectVisibleBody(const Snake& snake, const SDL_Rect& visible);
   void DrawObstacleCell(int x, int y, const SDL_Color& color) const;
   void DrawMovingObstacleWithPattern(int x, int y, MovementPattern pattern) const;
   SDL_Color GetObstacleColor(ObstacleType type) const;
@@ -0,0 +1,345 @@
+// Score persistence benchmark: compares one fsync per save against the
+// grouped commits done by ScoreWriter, checks that the log survives a
+// process being killed mid-write and that several processes can save to one
+// log at once, and times loading a large text score file and per-board
+// leaderboards.
+//
+// Usage: ScoreBenchmark [saves] [directory] [csv rows]
+
+#include "highscore_manager.h"
+#include "score_csv.h"
+#include "score_log.h"
+#include "score_writer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double ToMicroseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    void RemoveLog(const std::string& path) {
+        std::remove(path.c_str());
+        std::remove((path + ".idx").c_str());
+    }
+
+    ScoreEntry MakeEntry(std::size_t i) {
+        return ScoreEntry("Player" + std::to_string(i % 64), static_cast<int>(i % 500),
+                          int64_t{1735689600});
+    }
+
+    void PrintLatencies(const char* label, std::vector<double>& samples) {
+        std::sort(samples.begin(), samples.end());
+        double total = 0.0;
+        for (double sample : samples) total += sample;
+        std::cout << std::left << std::setw(28) << label << std::right << std::fixed
+                  << std::setprecision(1)
+                  << " avg " << std::setw(9) << total / samples.size() << " us"
+                  << "  p50 " << std::setw(9) << samples[samples.size() / 2] << " us"
+                  << "  p99 " << std::setw(9) << samples[samples.size() * 99 / 100] << " us"
+                  << "  max " << std::setw(9) << samples.back() << " us" << std::endl;
+    }
+
+    // Baseline: every save is its own append + fsync
+    void BenchmarkSyncPerSave(const std::string& path, std::size_t saves) {
+        RemoveLog(path);
+        ScoreLog log(path);
+        std::vector<double> latencies;
+        latencies.reserve(saves);
+
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < saves; ++i) {
+            auto begin = Clock::now();
+            log.Append(MakeEntry(i));
+            log.Sync();
+            latencies.push_back(ToMicroseconds(Clock::now() - begin));
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << "\n-- fsync per save --" << std::endl;
+        PrintLatencies("save (caller blocked)", latencies);
+        std::cout << "throughput: " << std::setprecision(0) << saves / seconds << " saves/s, "
+                  << saves << " fsyncs" << std::endl;
+    }
+
+    // Grouped: saves arrive in bursts and are committed by the writer thread
+    void BenchmarkGroupCommit(const std::string& path, std::size_t saves, std::size_t burst) {
+        RemoveLog(path);
+        ScoreLog log(path);
+        std::vector<double> latencies;
+        latencies.reserve(saves);
+
+        auto start = Clock::now();
+        {
+            ScoreWriter writer(log);
+            writer.Start();
+            for (std::size_t i = 0; i < saves; ++i) {
+                auto begin = Clock::now();
+                writer.Enqueue(MakeEntry(i));
+                latencies.push_back(ToMicroseconds(Clock::now() - begin));
+                if ((i + 1) % burst == 0) {
+                    writer.Flush();
+                }
+            }
+            writer.Stop();
+
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            std::cout << "\n-- grouped commit, bursts of " << burst << " --" << std::endl;
+            PrintLatencies("save (caller blocked)", latencies);
+            std::cout << std::setprecision(1)
+                      << "enqueue -> durable: avg " << ToMicroseconds(writer.GetAverageCommitLatency())
+                      << " us, max " << ToMicroseconds(writer.GetMaxCommitLatency()) << " us" << std::endl;
+            std::cout << "fsync: " << writer.GetBatchCount() << " for " << writer.GetWrittenCount()
+                      << " saves, avg " << ToMicroseconds(writer.GetAverageSyncTime()) << " us" << std::endl;
+            std::cout << "throughput: " << std::setprecision(0) << saves / seconds << " saves/s" << std::endl;
+        }
+    }
+
+    // End to end through HighScoreManager (leaderboard update + enqueue)
+    void BenchmarkSaveScore(const std::string& path, std::size_t saves) {
+        RemoveLog(path);
+        std::vector<double> latencies;
+        latencies.reserve(saves);
+        {
+            HighScoreManager manager(path, "");
+            for (std::size_t i = 0; i < saves; ++i) {
+                auto begin = Clock::now();
+                manager.SaveScore("Player" + std::to_string(i % 64), static_cast<int>(i % 500));
+                latencies.push_back(ToMicroseconds(Clock::now() - begin));
+            }
+        }
+        std::cout << "\n-- HighScoreManager::SaveScore --" << std::endl;
+        PrintLatencies("save (caller blocked)", latencies);
+    }
+
+    // Kill a writer process mid-stream and check nothing it reported durable
+    // was lost and the log reopens cleanly
+    void CheckCrashRecovery(const std::string& path) {
+        RemoveLog(path);
+        int report[2];
+        if (::pipe(report) != 0) {
+            std::perror("pipe");
+            return;
+        }
+
+        pid_t child = ::fork();
+        if (child == 0) {
+            ::close(report[0]);
+            ScoreLog log(path);
+            std::vector<ScoreEntry> batch;
+            for (uint64_t committed = 0;; ) {
+                batch.clear();
+                for (std::size_t i = 0; i < 16; ++i) batch.push_back(MakeEntry(committed + i));
+                if (!log.AppendBatch(batch) || !log.Sync()) ::_exit(1);
+                committed += batch.size();
+                if (::write(report[1], &committed, sizeof(committed)) != sizeof(committed)) ::_exit(1);
+            }
+        }
+
+        ::close(report[1]);
+        ::usleep(200000);
+        ::kill(child, SIGKILL);
+        ::waitpid(child, nullptr, 0);
+
+        uint64_t reported = 0;
+        uint64_t value = 0;
+        while (::read(report[0], &value, sizeof(value)) == sizeof(value)) {
+            reported = value;
+        }
+        ::close(report[0]);
+
+        ScoreLog log(path);
+        std::size_t valid = 0;
+        std::size_t corrupt = log.ReadRecords(0, [&valid](const ScoreView&) { ++valid; });
+
+        std::cout << "\n-- crash recovery (SIGKILL during writes) --" << std::endl;
+        std::cout << "reported durable: " << reported << ", recovered: " << valid
+                  << ", corrupt: " << corrupt << " -> "
+                  << (valid >= reported && corrupt == 0 ? "OK" : "FAILED") << std::endl;
+    }
+
+    // Several processes save to one log at the same time; none may lose
+    // another's records, and an instance that was open throughout picks all
+    // of them up with RefreshScores
+    void CheckSharedLog(const std::string& path, std::size_t processes, std::size_t saves) {
+        RemoveLog(path);
+        HighScoreManager observer(path, "");
+
+        std::cout << "\n-- " << processes << " processes sharing one log, " << saves
+                  << " saves each --" << std::endl;
+        std::vector<pid_t> children;
+        for (std::size_t p = 0; p < processes; ++p) {
+            pid_t child = ::fork();
+            if (child == 0) {
+                ScoreLog log(path);
+                {
+                    ScoreWriter writer(log);
+                    writer.Start();
+                    for (std::size_t i = 0; i < saves; ++i) {
+                        writer.Enqueue(MakeEntry(p * saves + i));
+                        if (i % 8 == 7) {
+                            writer.Flush();
+                        }
+                    }
+                    writer.Stop();
+                }
+                ScoreLog::LockStats stats = log.GetLockStats();
+                std::cout << std::fixed << std::setprecision(1) << "process " << p << ": "
+                          << stats.acquisitions << " locks, hold avg "
+                          << ToMicroseconds(stats.average_hold) << " us, max "
+                          << ToMicroseconds(stats.max_hold) << " us, wait avg "
+                          << ToMicroseconds(stats.average_wait) << " us" << std::endl;
+                ::_exit(0);
+            }
+            children.push_back(child);
+        }
+        for (pid_t child : children) {
+            ::waitpid(child, nullptr, 0);
+        }
+
+        std::size_t expected = processes * saves;
+        bool changed = observer.RefreshScores();
+        ScoreLog log(path);
+        std::cout << "records in log: " << log.GetRecordCount() << ", merged by open instance: "
+                  << observer.GetScoreCount() << " -> "
+                  << (changed && log.GetRecordCount() == expected && observer.GetScoreCount() == expected
+                      ? "OK" : "FAILED") << std::endl;
+
+        auto begin = Clock::now();
+        bool unchanged = !observer.RefreshScores();
+        std::cout << std::setprecision(2) << "change check with nothing new: "
+                  << ToMicroseconds(Clock::now() - begin) << " us" << (unchanged ? "" : " (FAILED)")
+                  << std::endl;
+    }
+
+    // Many board configurations with their own logs; startup must only load
+    // the selected board, and each other board loads on first selection
+    void BenchmarkBoards(const std::string& path, std::size_t boards, std::size_t saves) {
+        std::vector<BoardConfig> configs;
+        for (std::size_t b = 0; b < boards; ++b) {
+            configs.emplace_back(static_cast<uint32_t>(16 + b), static_cast<uint32_t>(16 + b));
+        }
+        {
+            HighScoreManager manager(path, "");
+            for (const auto& config : configs) {
+                manager.SelectBoard(config);
+                manager.ClearScores();
+                for (std::size_t i = 0; i < saves; ++i) {
+                    manager.SaveScore("Player" + std::to_string(i % 64), static_cast<int>(i % 500));
+                }
+            }
+        }
+
+        std::cout << "\n-- " << boards << " boards, " << saves << " scores each --" << std::endl;
+        auto begin = Clock::now();
+        HighScoreManager manager(path, "", configs.front());
+        double startup_us = ToMicroseconds(Clock::now() - begin);
+
+        begin = Clock::now();
+        manager.SelectBoard(configs.back());
+        double first_us = ToMicroseconds(Clock::now() - begin);
+        std::size_t count = manager.GetScoreCount();
+
+        begin = Clock::now();
+        manager.SelectBoard(configs.front());
+        manager.SelectBoard(configs.back());
+        double switch_us = ToMicroseconds(Clock::now() - begin) / 2;
+
+        std::cout << std::setprecision(1) << "startup: " << startup_us << " us ("
+                  << manager.GetLoadedBoardCount() << " boards loaded after two selections), "
+                  << "first selection of another board: " << first_us << " us, "
+                  << "switch to a loaded board: " << switch_us << " us" << std::endl;
+        std::cout << "scores on last board: " << count << " -> " << (count == saves ? "OK" : "FAILED")
+                  << std::endl;
+
+        for (const auto& config : configs) {
+            RemoveLog(manager.GetBoardFilename(config));
+        }
+    }
+
+    // Parse and import a generated text score file with some malformed rows
+    void BenchmarkCsvLoad(const std::string& directory, std::size_t rows) {
+        std::string csv_path = directory + "/score_benchmark.csv";
+        std::string log_path = directory + "/score_benchmark_import.bin";
+        {
+            std::ofstream csv(csv_path);
+            csv << "PlayerName,Score,Timestamp\n";
+            for (std::size_t i = 0; i < rows; ++i) {
+                if (i % 100000 == 99999) {
+                    csv << "Broken row without fields\n";
+                    continue;
+                }
+                csv << "Player" << (i % 5000) << ',' << (i * 7919) % 100000 << ",2025-01-01_00:00:00\n";
+            }
+        }
+
+        std::cout << "\n-- text score file, " << rows << " rows --" << std::endl;
+        ScoreCsv::ParseStats stats;
+        uint64_t checksum = 0;
+        auto begin = Clock::now();
+        ScoreCsv::ParseFile(csv_path, [&checksum](const ScoreView* entries, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) checksum += static_cast<uint64_t>(entries[i].score);
+        }, stats);
+        double parse_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        std::cout << std::setprecision(1) << "parse: " << parse_ms << " ms (" << stats.parsed
+                  << " parsed, " << stats.malformed << " malformed)" << std::endl;
+
+        RemoveLog(log_path);
+        begin = Clock::now();
+        {
+            HighScoreManager manager(log_path, csv_path);
+            double import_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+            std::cout << "import into log + build leaderboard: " << import_ms << " ms ("
+                      << manager.GetScoreCount() << " scores)" << std::endl;
+        }
+        begin = Clock::now();
+        {
+            HighScoreManager manager(log_path, csv_path);
+            double load_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+            std::cout << "startup from index: " << std::setprecision(3) << load_ms << " ms" << std::endl;
+            manager.ClearScores();
+        }
+        {
+            // The text file was renamed on import, so cleared scores stay cleared
+            HighScoreManager manager(log_path, csv_path);
+            std::cout << "after clearing and restarting: " << manager.GetScoreCount() << " scores" << std::endl;
+        }
+        RemoveLog(log_path);
+        std::remove(csv_path.c_str());
+        std::remove((csv_path + ".imported").c_str());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t saves = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    std::string directory = argc > 2 ? argv[2] : ".";
+    std::string path = directory + "/score_benchmark.bin";
+    std::size_t csv_rows = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000000;
+    saves = std::max<std::size_t>(saves, 100);
+
+    std::cout << "Score persistence benchmark: " << saves << " saves in " << directory << std::endl;
+
+    BenchmarkSyncPerSave(path, saves);
+    BenchmarkGroupCommit(path, saves, 1);
+    BenchmarkGroupCommit(path, saves, 32);
+    BenchmarkSaveScore(path, saves);
+    CheckCrashRecovery(path);
+    CheckSharedLog(path, 4, saves / 4);
+    BenchmarkBoards(path, 50, saves / 10);
+    BenchmarkCsvLoad(directory, csv_rows);
+
+    RemoveLog(path);
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "score_csv.h"
+#include "timestamp_format.h"
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr uint64_t kMaxReportedLines = 10;
+    constexpr std::size_t kBatchSize = 4096;
+    constexpr std::string_view kHeaderPrefix = "PlayerName,";
+
+    // Read-only mapping of a whole file, unmapped on destruction
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* mapping = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ,
+                                       MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED) {
+                    data_ = static_cast<const char*>(mapping);
+                    size_ = static_cast<std::size_t>(st.st_size);
+                    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+                }
+            }
+            opened_ = true;
+            ::close(fd); // The mapping stays valid after close
+        }
+
+        ~MappedFile() {
+            if (data_ != nullptr) {
+                ::munmap(const_cast<char*>(data_), size_);
+            }
+        }
+
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        bool IsOpen() const { return opened_; }
+        std::string_view GetContents() const { return std::string_view(data_, size_); }
+
+    private:
+        const char* data_{nullptr};
+        std::size_t size_{0};
+        bool opened_{false};
+    };
+}
+
+namespace ScoreCsv {
+
+bool ParseLine(std::string_view line, ScoreView& entry) {
+    std::size_t first_comma = line.find(',');
+    if (first_comma == std::string_view::npos || first_comma == 0) {
+        return false;
+    }
+    std::size_t second_comma = line.find(',', first_comma + 1);
+    if (second_comma == std::string_view::npos) {
+        return false;
+    }
+
+    const char* score_begin = line.data() + first_comma + 1;
+    const char* score_end = line.data() + second_comma;
+    int score = 0;
+    auto result = std::from_chars(score_begin, score_end, score);
+    if (result.ec != std::errc() || result.ptr != score_end) {
+        return false;
+    }
+
+    std::string_view time_text = line.substr(second_comma + 1);
+    int64_t timestamp = 0;
+    if (!time_text.empty() && !TimestampFormat::ParseText(time_text, timestamp)) {
+        return false;
+    }
+
+    entry.playerName = line.substr(0, first_comma);
+    entry.score = score;
+    entry.timestamp = timestamp;
+    return true;
+}
+
+void AppendLine(const ScoreView& entry, std::string& out) {
+    char number[16];
+    auto result = std::to_chars(number, number + sizeof(number), entry.score);
+
+    out.append(entry.playerName.data(), entry.playerName.size());
+    out.push_back(',');
+    out.append(number, result.ptr);
+    out.push_back(',');
+    if (entry.timestamp != 0) {
+        char time_text[TimestampFormat::kTextLength];
+        TimestampFormat::FormatText(entry.timestamp, time_text);
+        out.append(time_text, sizeof(time_text));
+    }
+    out.push_back('\n');
+}
+
+bool ParseFile(const std::string& path,
+               const std::function<void(const ScoreView* entries, std::size_t count)>& visitor,
+               ParseStats& stats) {
+    MappedFile file(path);
+    if (!file.IsOpen()) {
+        std::cerr << "Warning: Could not open scores file: " << path << std::endl;
+        return false;
+    }
+
+    std::string_view remaining = file.GetContents();
+    uint64_t line_number = 0;
+    std::vector<ScoreView> batch(kBatchSize);
+    std::size_t batched = 0;
+
+    while (!remaining.empty()) {
+        const void* newline = std::memchr(remaining.data(), '\n', remaining.size());
+        std::size_t length = newline
+            ? static_cast<std::size_t>(static_cast<const char*>(newline) - remaining.data())
+            : remaining.size();
+        std::string_view line = remaining.substr(0, length);
+        remaining.remove_prefix(newline ? length + 1 : length);
+        ++line_number;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (line.empty() || (line_number == 1 && line.substr(0, kHeaderPrefix.size()) == kHeaderPrefix)) {
+            continue;
+        }
+
+        ++stats.lines;
+        if (ParseLine(line, batch[batched])) {
+            ++stats.parsed;
+            if (++batched == kBatchSize) {
+                visitor(batch.data(), batched);
+                batched = 0;
+            }
+        } else {
+            if (++stats.malformed <= kMaxReportedLines) {
+                std::cerr << "Warning: Invalid score entry at " << path << ":" << line_number
+                          << ": " << line << std::endl;
+            }
+        }
+    }
+
+    if (batched > 0) {
+        visitor(batch.data(), batched);
+    }
+
+    if (stats.malformed > kMaxReportedLines) {
+        std::cerr << "Warning: " << stats.malformed << " invalid score entries in " << path
+                  << " (first " << kMaxReportedLines << " shown)" << std::endl;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,37 @@
+#ifndef SCORE_CSV_H
+#define SCORE_CSV_H
+
+#include "score_entry.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Reader for the text score format ("PlayerName,Score,Timestamp" lines).
+// The file is memory mapped and tokenised in place: the visitor receives
+// batches of views into the mapping, valid only during the call, so nothing
+// is allocated for rows the caller does not keep.
+namespace ScoreCsv {
+    struct ParseStats {
+        uint64_t lines{0};     // Non-empty lines, excluding the header
+        uint64_t parsed{0};
+        uint64_t malformed{0};
+    };
+
+    // Returns false if the file cannot be opened or mapped. Malformed lines
+    // are skipped, counted and (the first few) reported on stderr with
+    // their line numbers.
+    bool ParseFile(const std::string& path,
+                   const std::function<void(const ScoreView* entries, std::size_t count)>& visitor,
+                   ParseStats& stats);
+
+    // Parses one line without its terminator. An empty timestamp field is
+    // accepted as unknown (0).
+    bool ParseLine(std::string_view line, ScoreView& entry);
+
+    // Export side: header line and one formatted row, both with "\n"
+    constexpr std::string_view kHeaderLine = "PlayerName,Score,Timestamp\n";
+    void AppendLine(const ScoreView& entry, std::string& out);
+}
+
+#endif
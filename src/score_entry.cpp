@@ -1,4 +1,4 @@
 #include "score_entry.h"
 
-ScoreEntry::ScoreEntry(const std::string& name, int s, const std::string& time)
+ScoreEntry::ScoreEntry(const std::string& name, int s, int64_t time)
     : playerName(name), score(s), timestamp(time) {}
\ No newline at end of file
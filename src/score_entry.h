@@ -1,22 +1,24 @@
 #ifndef SCORE_ENTRY_H
 #define SCORE_ENTRY_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 
 struct ScoreEntry {
 public:
     std::string playerName;
-    int score;
-    std::string timestamp;
+    int score{0};
+    int64_t timestamp{0}; // Seconds since the Unix epoch, 0 if unknown
 
     ScoreEntry() = default;
-    ScoreEntry(const std::string& name, int s, const std::string& time);
+    ScoreEntry(const std::string& name, int s, int64_t time);
 
     // Perfect forwarding constructor for efficient construction
-    template<typename Name, typename Time>
-    ScoreEntry(Name&& name, int s, Time&& time)
-        : playerName(std::forward<Name>(name)), score(s), timestamp(std::forward<Time>(time)) {}
+    template<typename Name>
+    ScoreEntry(Name&& name, int s, int64_t time)
+        : playerName(std::forward<Name>(name)), score(s), timestamp(time) {}
 
     ScoreEntry(const ScoreEntry& other) = default;
     ScoreEntry& operator=(const ScoreEntry& other) = default;
@@ -26,4 +28,28 @@ public:
     ~ScoreEntry() = default;
 };
 
+// Non-owning view of a score, used while streaming records out of files so
+// that only the entries that are kept get allocated
+struct ScoreView {
+    std::string_view playerName;
+    int score{0};
+    int64_t timestamp{0};
+
+    ScoreView() = default;
+    ScoreView(std::string_view name, int s, int64_t time)
+        : playerName(name), score(s), timestamp(time) {}
+    ScoreView(const ScoreEntry& entry) // Implicit: an entry can always be viewed
+        : playerName(entry.playerName), score(entry.score), timestamp(entry.timestamp) {}
+
+    ScoreEntry ToEntry() const { return ScoreEntry(std::string(playerName), score, timestamp); }
+};
+
+// Leaderboard line with every field already formatted for display
+struct ScoreDisplayRow {
+    std::string rank;
+    std::string playerName;
+    std::string score;
+    std::string date;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,692 @@
+#include "score_log.h"
+#include "checksum.h"
+#include "atomic_file.h"
+#include "timestamp_format.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const char kLogMagic[4] = {'S', 'N', 'K', 'L'};
+    const char kIndexMagic[4] = {'S', 'N', 'K', 'I'};
+    constexpr std::size_t kIndexHeaderSize = 32;
+    constexpr std::size_t kIndexBucketSize = 12; // i32 score, u64 count
+    constexpr std::size_t kReadChunkRecords = 4096;
+    constexpr int kMaxOpenAttempts = 8; // Other instances may replace the file while we open it
+
+    // Version 1 record: name[20], i32 score, char timestamp[20], u32 CRC-32
+    constexpr std::size_t kV1RecordSize = 48;
+    constexpr std::size_t kV1TimestampSize = 20;
+
+    void PutU16(uint8_t* out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    void PutU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void PutU64(uint8_t* out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    uint16_t GetU16(const uint8_t* in) {
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    uint32_t GetU32(const uint8_t* in) {
+        uint32_t value = 0;
+        for (int i = 3; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    uint64_t GetU64(const uint8_t* in) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    // pread/pwrite may transfer less than requested; loop until done
+    bool WriteFully(int fd, const uint8_t* data, std::size_t length, off_t offset) {
+        while (length > 0) {
+            ssize_t written = ::pwrite(fd, data, length, offset);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            length -= static_cast<std::size_t>(written);
+            offset += written;
+        }
+        return true;
+    }
+
+    bool ReadFully(int fd, uint8_t* data, std::size_t length, off_t offset) {
+        while (length > 0) {
+            ssize_t got = ::pread(fd, data, length, offset);
+            if (got < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (got == 0) {
+                return false; // Unexpected end of file
+            }
+            data += got;
+            length -= static_cast<std::size_t>(got);
+            offset += got;
+        }
+        return true;
+    }
+
+    void CopyPadded(std::string_view text, uint8_t* out, std::size_t size) {
+        std::size_t length = std::min(text.size(), size);
+        std::memcpy(out, text.data(), length);
+        std::memset(out + length, 0, size - length);
+    }
+
+    std::string_view ReadPadded(const uint8_t* in, std::size_t size) {
+        const void* end = std::memchr(in, 0, size);
+        std::size_t length = end ? static_cast<std::size_t>(static_cast<const uint8_t*>(end) - in) : size;
+        return std::string_view(reinterpret_cast<const char*>(in), length);
+    }
+}
+
+ScoreLog::Lock::Lock(ScoreLog& log) : log_(log) {
+    if (log_.lock_depth_++ > 0 || log_.fd_ < 0) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    int result;
+    while ((result = ::flock(log_.fd_, LOCK_EX)) != 0 && errno == EINTR) {
+    }
+    acquired_ = std::chrono::steady_clock::now();
+    if (result != 0) {
+        // Carry on unlocked (e.g. a filesystem without flock support)
+        std::cerr << "Warning: Could not lock score log " << log_.path_ << ": "
+                  << std::strerror(errno) << std::endl;
+        return;
+    }
+    locked_ = true;
+    ++log_.lock_acquisitions_;
+    log_.lock_wait_ns_ += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(acquired_ - start).count());
+}
+
+ScoreLog::Lock::~Lock() {
+    --log_.lock_depth_;
+    if (!locked_) {
+        return;
+    }
+    uint64_t held = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - acquired_).count());
+    ::flock(log_.fd_, LOCK_UN);
+    log_.lock_hold_ns_ += held;
+    if (held > log_.lock_max_hold_ns_) {
+        log_.lock_max_hold_ns_ = held;
+    }
+}
+
+ScoreLog::ScoreLog(const std::string& path)
+    : path_(path), index_path_(path + ".idx") {
+    OpenLog();
+}
+
+ScoreLog::~ScoreLog() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool ScoreLog::Append(const ScoreEntry& entry) {
+    return AppendBatch(std::vector<ScoreEntry>{entry});
+}
+
+bool ScoreLog::AppendBatch(const std::vector<ScoreEntry>& entries) {
+    std::vector<ScoreView> views(entries.begin(), entries.end());
+    return AppendBatch(views.data(), views.size());
+}
+
+bool ScoreLog::AppendBatch(const ScoreView* views, std::size_t count) {
+    if (fd_ < 0) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    std::vector<uint8_t> records(count * kRecordSize);
+    for (std::size_t i = 0; i < count; ++i) {
+        EncodeRecord(views[i], records.data() + i * kRecordSize);
+    }
+
+    // Only the write itself is under the lock. Always write at the
+    // record-aligned end of the file as it is now, so an append after a torn
+    // write cleanly replaces the partial record and never overwrites records
+    // another process appended.
+    Lock lock(*this);
+    CatchUp();
+    uint64_t first = record_count_;
+    off_t offset = static_cast<off_t>(kHeaderSize + first * kRecordSize);
+    if (!WriteFully(fd_, records.data(), records.size(), offset)) {
+        std::cerr << "Warning: Could not append to score log " << path_ << ": "
+                  << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!own_ranges_.empty() && own_ranges_.back().second == first) {
+        own_ranges_.back().second += count;
+    } else {
+        own_ranges_.emplace_back(first, first + count);
+    }
+    record_count_ = first + count;
+    return true;
+}
+
+std::size_t ScoreLog::ReadRecords(uint64_t first,
+                                  const std::function<void(const ScoreView&)>& visitor) const {
+    return ReadRange(first, record_count_, visitor);
+}
+
+std::size_t ScoreLog::ReadRange(uint64_t first, uint64_t last,
+                                const std::function<void(const ScoreView&)>& visitor) const {
+    std::size_t corrupt = 0;
+    if (fd_ < 0) {
+        return corrupt;
+    }
+
+    std::vector<uint8_t> chunk(kReadChunkRecords * kRecordSize);
+    uint64_t index = first;
+    while (index < last) {
+        std::size_t batch = static_cast<std::size_t>(
+            std::min<uint64_t>(kReadChunkRecords, last - index));
+        off_t offset = static_cast<off_t>(kHeaderSize + index * kRecordSize);
+        if (!ReadFully(fd_, chunk.data(), batch * kRecordSize, offset)) {
+            std::cerr << "Warning: Could not read score log " << path_ << std::endl;
+            break;
+        }
+
+        for (std::size_t i = 0; i < batch; ++i) {
+            ScoreView entry;
+            if (DecodeRecord(chunk.data() + i * kRecordSize, entry)) {
+                visitor(entry);
+            } else {
+                ++corrupt;
+            }
+        }
+        index += batch;
+    }
+
+    if (corrupt > 0) {
+        std::cerr << "Warning: Skipped " << corrupt << " corrupt record(s) in " << path_ << std::endl;
+    }
+    return corrupt;
+}
+
+bool ScoreLog::Clear() {
+    if (fd_ < 0) {
+        std::remove(index_path_.c_str());
+        return false;
+    }
+
+    // A new generation tells other instances to drop what they have read
+    Lock lock(*this);
+    CatchUp();
+    std::remove(index_path_.c_str());
+    uint32_t generation = generation_ + 1;
+    uint8_t header[kHeaderSize];
+    EncodeHeader(header, generation);
+    if (::ftruncate(fd_, static_cast<off_t>(kHeaderSize)) != 0 ||
+        !WriteFully(fd_, header, kHeaderSize, 0)) {
+        std::cerr << "Warning: Could not clear score log " << path_ << std::endl;
+        return false;
+    }
+    generation_ = generation;
+    record_count_ = 0;
+    MarkRead();
+    reset_pending_ = false;
+    return Sync();
+}
+
+bool ScoreLog::HasExternalChanges() const {
+    if (fd_ < 0) {
+        return false;
+    }
+    if (external_pending_ || reset_pending_) {
+        return true;
+    }
+    uint64_t record_count = 0;
+    uint32_t generation = 0;
+    return ReadFileState(record_count, generation) &&
+           (record_count != record_count_ || generation != generation_);
+}
+
+void ScoreLog::CatchUp() {
+    uint64_t record_count = 0;
+    uint32_t generation = 0;
+    if (!ReadFileState(record_count, generation)) {
+        return;
+    }
+    if (generation != generation_ || record_count < record_count_) {
+        // Cleared by another process; our earlier appends are gone with it
+        own_ranges_.clear();
+        generation_ = generation;
+        reset_pending_ = true;
+        external_pending_ = record_count > 0;
+    } else if (record_count > record_count_) {
+        external_pending_ = true;
+    }
+    record_count_ = record_count;
+}
+
+bool ScoreLog::TakeReset() {
+    if (!reset_pending_.exchange(false)) {
+        return false;
+    }
+    read_position_ = 0;
+    own_ranges_.clear();
+    return true;
+}
+
+std::size_t ScoreLog::ReadExternalRecords(const std::function<void(const ScoreView&)>& visitor) {
+    external_pending_ = false;
+    uint64_t end = record_count_;
+    uint64_t position = read_position_;
+    std::size_t corrupt = 0;
+
+    // Own appends are sorted and disjoint; read the gaps between them
+    for (const auto& range : own_ranges_) {
+        if (range.second <= position) {
+            continue;
+        }
+        if (range.first > position) {
+            corrupt += ReadRange(position, std::min(range.first, end), visitor);
+        }
+        position = range.second;
+    }
+    if (position < end) {
+        corrupt += ReadRange(position, end, visitor);
+    }
+
+    own_ranges_.clear();
+    read_position_ = end;
+    return corrupt;
+}
+
+void ScoreLog::MarkRead() {
+    external_pending_ = false;
+    own_ranges_.clear();
+    read_position_ = record_count_;
+}
+
+ScoreLog::LockStats ScoreLog::GetLockStats() const {
+    LockStats stats;
+    stats.acquisitions = lock_acquisitions_;
+    if (stats.acquisitions > 0) {
+        stats.average_wait = std::chrono::nanoseconds(lock_wait_ns_ / stats.acquisitions);
+        stats.average_hold = std::chrono::nanoseconds(lock_hold_ns_ / stats.acquisitions);
+    }
+    stats.max_hold = std::chrono::nanoseconds(lock_max_hold_ns_);
+    return stats;
+}
+
+bool ScoreLog::ReadFileState(uint64_t& record_count, uint32_t& generation) const {
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        return false;
+    }
+    record_count = st.st_size >= static_cast<off_t>(kHeaderSize)
+        ? (static_cast<uint64_t>(st.st_size) - kHeaderSize) / kRecordSize
+        : 0;
+
+    // A header being rewritten by a concurrent Clear fails its checksum;
+    // the size change is then enough to notice it
+    uint8_t header[kHeaderSize];
+    generation = generation_;
+    if (ReadFully(fd_, header, kHeaderSize, 0) && ReadHeaderVersion(header) == kVersion) {
+        generation = GetU32(header + 8);
+    }
+    return true;
+}
+
+// Index layout: "SNKI", u16 index version, u16 record size, u64 covered
+// records, u32 top count, u32 player count, u32 bucket count, u32 CRC-32 of
+// the header's first 28 bytes and the body; then the top records, the player
+// records and the histogram buckets.
+bool ScoreLog::ReadIndex(ScoreIndex& index) const {
+    int index_fd = ::open(index_path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (index_fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    std::vector<uint8_t> data;
+    bool ok = ::fstat(index_fd, &st) == 0 && st.st_size >= static_cast<off_t>(kIndexHeaderSize);
+    if (ok) {
+        data.resize(static_cast<std::size_t>(st.st_size));
+        ok = ReadFully(index_fd, data.data(), data.size(), 0);
+    }
+    ::close(index_fd);
+
+    const uint8_t* header = data.data();
+    std::size_t top_count = 0;
+    std::size_t player_count = 0;
+    std::size_t bucket_count = 0;
+    if (ok) {
+        top_count = GetU32(header + 16);
+        player_count = GetU32(header + 20);
+        bucket_count = GetU32(header + 24);
+        ok = std::memcmp(header, kIndexMagic, 4) == 0 &&
+             GetU16(header + 4) == kIndexVersion &&
+             GetU16(header + 6) == kRecordSize &&
+             data.size() == kIndexHeaderSize + (top_count + player_count) * kRecordSize +
+                            bucket_count * kIndexBucketSize;
+    }
+    if (ok) {
+        uint32_t crc = Checksum::Crc32(header, 28);
+        crc = Checksum::Crc32(header + kIndexHeaderSize, data.size() - kIndexHeaderSize, crc);
+        ok = crc == GetU32(header + 28);
+    }
+    if (ok) {
+        index.covered_records = GetU64(header + 8);
+        const uint8_t* cursor = header + kIndexHeaderSize;
+        auto read_records = [&](std::vector<ScoreEntry>& entries, std::size_t count) {
+            entries.clear();
+            entries.reserve(count);
+            for (std::size_t i = 0; ok && i < count; ++i, cursor += kRecordSize) {
+                ScoreView entry;
+                ok = DecodeRecord(cursor, entry);
+                entries.push_back(entry.ToEntry());
+            }
+        };
+        read_records(index.top_entries, top_count);
+        read_records(index.player_bests, player_count);
+
+        index.score_counts.clear();
+        index.score_counts.reserve(bucket_count);
+        for (std::size_t i = 0; i < bucket_count; ++i, cursor += kIndexBucketSize) {
+            index.score_counts.emplace_back(static_cast<int32_t>(GetU32(cursor)), GetU64(cursor + 4));
+        }
+    }
+
+    if (!ok) {
+        std::cerr << "Warning: Rebuilding score index " << index_path_ << " from the log" << std::endl;
+        index = ScoreIndex();
+    }
+    return ok;
+}
+
+bool ScoreLog::WriteIndex(const ScoreIndex& index) const {
+    std::size_t record_count = index.top_entries.size() + index.player_bests.size();
+    std::vector<uint8_t> data(kIndexHeaderSize + record_count * kRecordSize +
+                              index.score_counts.size() * kIndexBucketSize);
+    uint8_t* header = data.data();
+    std::memcpy(header, kIndexMagic, 4);
+    PutU16(header + 4, kIndexVersion);
+    PutU16(header + 6, static_cast<uint16_t>(kRecordSize));
+    PutU64(header + 8, index.covered_records);
+    PutU32(header + 16, static_cast<uint32_t>(index.top_entries.size()));
+    PutU32(header + 20, static_cast<uint32_t>(index.player_bests.size()));
+    PutU32(header + 24, static_cast<uint32_t>(index.score_counts.size()));
+
+    uint8_t* cursor = header + kIndexHeaderSize;
+    for (const auto& entry : index.top_entries) {
+        EncodeRecord(entry, cursor);
+        cursor += kRecordSize;
+    }
+    for (const auto& entry : index.player_bests) {
+        EncodeRecord(entry, cursor);
+        cursor += kRecordSize;
+    }
+    for (const auto& bucket : index.score_counts) {
+        PutU32(cursor, static_cast<uint32_t>(bucket.first));
+        PutU64(cursor + 4, bucket.second);
+        cursor += kIndexBucketSize;
+    }
+
+    uint32_t crc = Checksum::Crc32(header, 28);
+    crc = Checksum::Crc32(header + kIndexHeaderSize, data.size() - kIndexHeaderSize, crc);
+    PutU32(header + 28, crc);
+
+    // Readers see either the old or the new index, never a partial one
+    return AtomicFile::WriteFile(index_path_, data.data(), data.size());
+}
+
+bool ScoreLog::OpenLog() {
+    for (int attempt = 0; attempt < kMaxOpenAttempts; ++attempt) {
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd_ < 0 && errno == ENOENT) {
+            // Create new logs with their header in place, so a crash can never
+            // leave a log that exists but has no header
+            if (!CreateLog()) {
+                return false;
+            }
+            fd_ = ::open(path_.c_str(), O_RDWR | O_CLOEXEC);
+        }
+        if (fd_ < 0) {
+            std::cerr << "Warning: Could not open score log " << path_ << ": "
+                      << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        bool retry = false;
+        bool ok;
+        {
+            Lock lock(*this);
+            ok = CheckOpenedLog(retry);
+        }
+        if (ok) {
+            return true;
+        }
+        ::close(fd_);
+        fd_ = -1;
+        if (!retry) {
+            return false;
+        }
+    }
+    std::cerr << "Warning: Could not open score log " << path_ << ", scores will not be saved" << std::endl;
+    return false;
+}
+
+// Runs under the lock, so a record another instance is still writing is
+// never mistaken for a torn one. Returns false with `retry` set when the
+// file was replaced (by us or by another instance) and must be reopened.
+bool ScoreLog::CheckOpenedLog(bool& retry) {
+    struct stat st;
+    struct stat path_st;
+    if (::fstat(fd_, &st) != 0 || ::stat(path_.c_str(), &path_st) != 0) {
+        retry = errno == ENOENT;
+        return false;
+    }
+    if (st.st_ino != path_st.st_ino || st.st_dev != path_st.st_dev) {
+        retry = true; // Replaced by another instance while we waited for the lock
+        return false;
+    }
+
+    if (st.st_size == 0) {
+        uint8_t header[kHeaderSize];
+        EncodeHeader(header, 0);
+        retry = AtomicFile::WriteFile(path_, header, kHeaderSize);
+        return false;
+    }
+
+    uint8_t header[kHeaderSize];
+    uint16_t version = 0;
+    if (st.st_size >= static_cast<off_t>(kHeaderSize) && ReadFully(fd_, header, kHeaderSize, 0)) {
+        version = ReadHeaderVersion(header);
+    }
+    if (version == 1) {
+        retry = UpgradeFromVersion1(static_cast<uint64_t>(st.st_size));
+        return false;
+    }
+    if (version != kVersion) {
+        // Keep the unreadable file for inspection and start a fresh log
+        std::string corrupt_path = path_ + ".corrupt";
+        std::cerr << "Warning: Score log " << path_ << " has an invalid header, moving it to "
+                  << corrupt_path << std::endl;
+        if (std::rename(path_.c_str(), corrupt_path.c_str()) != 0) {
+            std::cerr << "Warning: Could not move " << path_ << ", scores will not be saved" << std::endl;
+            return false;
+        }
+        std::remove(index_path_.c_str());
+        retry = true;
+        return false;
+    }
+
+    generation_ = GetU32(header + 8);
+    uint64_t body_size = static_cast<uint64_t>(st.st_size) - kHeaderSize;
+    record_count_ = body_size / kRecordSize;
+    read_position_ = record_count_;
+    if (body_size % kRecordSize != 0) {
+        // A write was interrupted part way through a record
+        std::cerr << "Warning: Dropping partial record at the end of " << path_ << std::endl;
+        if (::ftruncate(fd_, static_cast<off_t>(kHeaderSize + record_count_ * kRecordSize)) != 0) {
+            std::cerr << "Warning: Could not truncate " << path_ << std::endl;
+        }
+    }
+    return true;
+}
+
+bool ScoreLog::CreateLog() {
+    uint8_t header[kHeaderSize];
+    EncodeHeader(header, 0);
+
+    // Another instance may create the log at the same moment; whichever
+    // file is published first is kept
+    if (!AtomicFile::CreateExclusive(path_, header, kHeaderSize)) {
+        std::cerr << "Warning: Could not initialise score log " << path_ << std::endl;
+        return false;
+    }
+    record_count_ = 0;
+    return true;
+}
+
+bool ScoreLog::Sync() {
+    if (fd_ < 0) {
+        return false;
+    }
+    if (!AtomicFile::SyncFile(fd_)) {
+        std::cerr << "Warning: Could not sync score log " << path_ << ": "
+                  << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ScoreLog::UpgradeFromVersion1(uint64_t file_size) {
+    // Rewrite the whole log into a temporary file, then swap it in
+    // atomically; text timestamps that do not parse become 0 (unknown)
+    int old_fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    std::string temp_path = path_ + ".tmp";
+    int new_fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (old_fd < 0 || new_fd < 0) {
+        std::cerr << "Warning: Could not upgrade score log " << path_ << std::endl;
+        if (old_fd >= 0) ::close(old_fd);
+        if (new_fd >= 0) ::close(new_fd);
+        return false;
+    }
+
+    uint8_t header[kHeaderSize];
+    EncodeHeader(header, 0);
+    bool ok = WriteFully(new_fd, header, kHeaderSize, 0);
+
+    uint64_t old_count = (file_size - kHeaderSize) / kV1RecordSize;
+    uint64_t converted = 0;
+    std::vector<uint8_t> old_chunk(kReadChunkRecords * kV1RecordSize);
+    std::vector<uint8_t> new_chunk(kReadChunkRecords * kRecordSize);
+    for (uint64_t index = 0; ok && index < old_count; ) {
+        std::size_t batch = static_cast<std::size_t>(
+            std::min<uint64_t>(kReadChunkRecords, old_count - index));
+        ok = ReadFully(old_fd, old_chunk.data(), batch * kV1RecordSize,
+                       static_cast<off_t>(kHeaderSize + index * kV1RecordSize));
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; ok && i < batch; ++i) {
+            const uint8_t* in = old_chunk.data() + i * kV1RecordSize;
+            if (GetU32(in + kV1RecordSize - 4) != Checksum::Crc32(in, kV1RecordSize - 4)) {
+                continue; // Corrupt records are dropped rather than carried over
+            }
+            ScoreView entry;
+            entry.playerName = ReadPadded(in, kNameSize);
+            entry.score = static_cast<int32_t>(GetU32(in + kNameSize));
+            if (!TimestampFormat::ParseText(ReadPadded(in + kNameSize + 4, kV1TimestampSize),
+                                            entry.timestamp)) {
+                entry.timestamp = 0;
+            }
+            EncodeRecord(entry, new_chunk.data() + kept * kRecordSize);
+            ++kept;
+        }
+        ok = ok && WriteFully(new_fd, new_chunk.data(), kept * kRecordSize,
+                              static_cast<off_t>(kHeaderSize + converted * kRecordSize));
+        converted += kept;
+        index += batch;
+    }
+
+    ::close(old_fd);
+    ok = ok && AtomicFile::SyncFile(new_fd);
+    ok = ::close(new_fd) == 0 && ok;
+    ok = ok && std::rename(temp_path.c_str(), path_.c_str()) == 0;
+    if (!ok) {
+        std::cerr << "Warning: Could not upgrade score log " << path_ << std::endl;
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    AtomicFile::SyncParentDirectory(path_);
+    std::remove(index_path_.c_str());
+
+    std::cout << "Upgraded score log " << path_ << " to version " << kVersion << " ("
+              << converted << " records)" << std::endl;
+    return true;
+}
+
+void ScoreLog::EncodeHeader(uint8_t* header, uint32_t generation) {
+    std::memcpy(header, kLogMagic, 4);
+    PutU16(header + 4, kVersion);
+    PutU16(header + 6, static_cast<uint16_t>(kRecordSize));
+    PutU32(header + 8, generation);
+    PutU32(header + 12, Checksum::Crc32(header, 12));
+}
+
+uint16_t ScoreLog::ReadHeaderVersion(const uint8_t* header) {
+    if (std::memcmp(header, kLogMagic, 4) != 0 || GetU32(header + 12) != Checksum::Crc32(header, 12)) {
+        return 0;
+    }
+    uint16_t version = GetU16(header + 4);
+    uint16_t record_size = GetU16(header + 6);
+    if ((version == 1 && record_size == kV1RecordSize) ||
+        (version == kVersion && record_size == kRecordSize)) {
+        return version;
+    }
+    return 0;
+}
+
+void ScoreLog::EncodeRecord(const ScoreView& entry, uint8_t* out) {
+    CopyPadded(entry.playerName, out, kNameSize);
+    PutU32(out + kNameSize, static_cast<uint32_t>(entry.score));
+    PutU64(out + kNameSize + 4, static_cast<uint64_t>(entry.timestamp));
+    PutU32(out + kNameSize + 12, 0);
+    PutU32(out + kRecordSize - 4, Checksum::Crc32(out, kRecordSize - 4));
+}
+
+bool ScoreLog::DecodeRecord(const uint8_t* in, ScoreView& entry) {
+    if (GetU32(in + kRecordSize - 4) != Checksum::Crc32(in, kRecordSize - 4)) {
+        return false;
+    }
+    entry.playerName = ReadPadded(in, kNameSize);
+    entry.score = static_cast<int32_t>(GetU32(in + kNameSize));
+    entry.timestamp = static_cast<int64_t>(GetU64(in + kNameSize + 4));
+    return true;
+}
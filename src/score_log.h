@@ -0,0 +1,173 @@
+#ifndef SCORE_LOG_H
+#define SCORE_LOG_H
+
+#include "score_entry.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Leaderboard aggregates persisted beside the log, valid for the first
+// `covered_records` records
+struct ScoreIndex {
+    uint64_t covered_records{0};
+    std::vector<ScoreEntry> top_entries;
+    std::vector<ScoreEntry> player_bests;
+    std::vector<std::pair<int32_t, uint64_t>> score_counts; // (score, count), non-zero only
+};
+
+// Append-only binary score log.
+//
+// Log file layout (all integers little-endian):
+//   header : "SNKL", u16 version, u16 record size, u32 generation,
+//            u32 CRC-32 of the preceding 12 bytes
+//   body   : fixed-size records, appended one write per score
+//
+// Record layout, version 2 (40 bytes):
+//   char name[20]   NUL padded
+//   i32  score
+//   i64  timestamp  seconds since the Unix epoch
+//   u32  reserved   0
+//   u32  CRC-32 of the preceding 36 bytes
+//
+// Version 1 logs (48-byte records with a 20-character text timestamp) are
+// converted to version 2 when opened.
+//
+// A sidecar index ("<log>.idx") stores the leaderboard aggregates (top
+// records, per-player bests, score histogram) and the number of log records
+// they cover, so startup reads the index plus whatever was appended after it
+// was last written instead of the whole log.
+//
+// Several processes may share one log. Appends, clears and index writes
+// hold an advisory flock on the log file; an append first moves to the
+// file's current end, so instances never overwrite each other's records.
+// The generation in the header is bumped by Clear, and together with the
+// file size serves as the change sequence other instances poll.
+//
+// Not thread-safe: while a ScoreWriter is running it is the only user.
+class ScoreLog {
+public:
+    // Exclusive advisory lock on the log file. Reentrant within one ScoreLog;
+    // the hold time of the outermost lock is recorded in the lock statistics.
+    class Lock {
+    public:
+        explicit Lock(ScoreLog& log);
+        ~Lock();
+
+        Lock(const Lock& other) = delete;
+        Lock& operator=(const Lock& other) = delete;
+
+    private:
+        ScoreLog& log_;
+        std::chrono::steady_clock::time_point acquired_;
+        bool locked_{false};
+    };
+
+    struct LockStats {
+        uint64_t acquisitions{0};
+        std::chrono::nanoseconds average_wait{0};
+        std::chrono::nanoseconds average_hold{0};
+        std::chrono::nanoseconds max_hold{0};
+    };
+
+    explicit ScoreLog(const std::string& path);
+    ~ScoreLog();
+
+    ScoreLog(const ScoreLog& other) = delete;
+    ScoreLog& operator=(const ScoreLog& other) = delete;
+    ScoreLog(ScoreLog&& other) = delete;
+    ScoreLog& operator=(ScoreLog&& other) = delete;
+
+    bool IsOpen() const { return fd_ >= 0; }
+    uint64_t GetRecordCount() const { return record_count_.load(); }
+    const std::string& GetPath() const { return path_; }
+
+    // Writes records at the end of the log; a batch is a single write
+    bool Append(const ScoreEntry& entry);
+    bool AppendBatch(const std::vector<ScoreEntry>& entries);
+    bool AppendBatch(const ScoreView* views, std::size_t count);
+
+    // Makes every appended record durable (one fdatasync)
+    bool Sync();
+
+    // Calls visitor for each valid record from `first` to the end of the log.
+    // Views point into a read buffer and are only valid during the call.
+    // Returns the number of records skipped because their checksum failed.
+    std::size_t ReadRecords(uint64_t first,
+                            const std::function<void(const ScoreView&)>& visitor) const;
+
+    // Drops every record and the index, for every process sharing the log
+    bool Clear();
+
+    // Cheap check (fstat plus a header read, no lock) for records appended
+    // or a clear made by another process that have not been read yet
+    bool HasExternalChanges() const;
+
+    // Moves to the file's current end, noting records other processes
+    // appended and whether the log was cleared. Call with a Lock held.
+    void CatchUp();
+
+    // True once after another process cleared the log: everything read
+    // before is stale, and ReadExternalRecords restarts from record 0
+    bool TakeReset();
+
+    // Visits records, up to the end seen by the last CatchUp, that were
+    // appended by other processes and not read yet, then marks them read.
+    // Returns the number of records skipped because their checksum failed.
+    std::size_t ReadExternalRecords(const std::function<void(const ScoreView&)>& visitor);
+
+    // Marks every record up to the current end as read
+    void MarkRead();
+
+    LockStats GetLockStats() const;
+
+    bool ReadIndex(ScoreIndex& index) const;
+    bool WriteIndex(const ScoreIndex& index) const;
+
+    static constexpr uint16_t kVersion = 2;
+    static constexpr uint16_t kIndexVersion = 3;
+    static constexpr std::size_t kHeaderSize = 16;
+    static constexpr std::size_t kRecordSize = 40;
+    static constexpr std::size_t kNameSize = 20;
+
+private:
+    std::string path_;
+    std::string index_path_;
+    int fd_{-1};
+    std::atomic<uint64_t> record_count_{0};
+    std::atomic<uint32_t> generation_{0};
+
+    // Change tracking for logs shared between processes
+    uint64_t read_position_{0};                           // Records before this were read
+    std::vector<std::pair<uint64_t, uint64_t>> own_ranges_; // [begin, end) appended by this process
+    std::atomic<bool> external_pending_{false};
+    std::atomic<bool> reset_pending_{false};
+
+    // Lock state and statistics
+    int lock_depth_{0};
+    std::atomic<uint64_t> lock_acquisitions_{0};
+    std::atomic<uint64_t> lock_wait_ns_{0};
+    std::atomic<uint64_t> lock_hold_ns_{0};
+    std::atomic<uint64_t> lock_max_hold_ns_{0};
+
+    bool OpenLog();
+    bool CheckOpenedLog(bool& retry);
+    bool CreateLog();
+    bool UpgradeFromVersion1(uint64_t file_size);
+
+    std::size_t ReadRange(uint64_t first, uint64_t last,
+                          const std::function<void(const ScoreView&)>& visitor) const;
+    bool ReadFileState(uint64_t& record_count, uint32_t& generation) const;
+
+    static void EncodeHeader(uint8_t* header, uint32_t generation);
+    static uint16_t ReadHeaderVersion(const uint8_t* header); // 0 if invalid
+
+    static void EncodeRecord(const ScoreView& entry, uint8_t* out);
+    static bool DecodeRecord(const uint8_t* in, ScoreView& entry);
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "score_writer.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+ScoreWriter::ScoreWriter(ScoreLog& log, std::size_t capacity,
+                         std::chrono::microseconds coalesce_window)
+    : log_(log), capacity_(capacity > 0 ? capacity : 1), coalesce_window_(coalesce_window) {
+    pending_.reserve(capacity_);
+    pending_times_.reserve(capacity_);
+}
+
+ScoreWriter::~ScoreWriter() {
+    Stop();
+}
+
+void ScoreWriter::Start() {
+    if (worker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = false;
+    }
+    worker_ = std::thread(&ScoreWriter::WriterThread, this);
+}
+
+void ScoreWriter::Stop() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    work_available_.notify_one();
+    worker_.join();
+}
+
+void ScoreWriter::Enqueue(ScoreEntry entry) {
+    if (!worker_.joinable()) {
+        // Not running (or already stopped): commit synchronously
+        CommitBatch(std::vector<ScoreEntry>{std::move(entry)},
+                    std::vector<Clock::time_point>{Clock::now()});
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_available_.wait(lock, [this] { return pending_.size() < capacity_; });
+        pending_.push_back(std::move(entry));
+        pending_times_.push_back(Clock::now());
+    }
+    work_available_.notify_one();
+}
+
+void ScoreWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!worker_.joinable()) {
+        return;
+    }
+    if (!pending_.empty()) {
+        flush_requested_ = true;
+        work_available_.notify_one();
+    }
+    space_available_.wait(lock, [this] { return pending_.empty() && !writing_; });
+}
+
+std::chrono::nanoseconds ScoreWriter::GetAverageSyncTime() const {
+    uint64_t batches = written_batches_;
+    return std::chrono::nanoseconds(batches == 0 ? 0 : total_sync_time_ns_ / batches);
+}
+
+std::chrono::nanoseconds ScoreWriter::GetAverageCommitLatency() const {
+    uint64_t written = written_entries_;
+    return std::chrono::nanoseconds(written == 0 ? 0 : total_commit_latency_ns_ / written);
+}
+
+std::chrono::nanoseconds ScoreWriter::GetMaxCommitLatency() const {
+    return std::chrono::nanoseconds(max_commit_latency_ns_);
+}
+
+void ScoreWriter::WriterThread() {
+    std::vector<ScoreEntry> batch;
+    std::vector<Clock::time_point> batch_times;
+    batch.reserve(capacity_);
+    batch_times.reserve(capacity_);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_available_.wait(lock, [this] { return stop_requested_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return; // Stop requested and nothing left to write
+            }
+
+            // Give saves that arrive close together a chance to share this
+            // batch's fsync; a flush, a full queue or shutdown commits now
+            work_available_.wait_until(lock, pending_times_.front() + coalesce_window_, [this] {
+                return stop_requested_ || flush_requested_ || pending_.size() >= capacity_;
+            });
+            flush_requested_ = false;
+
+            batch.swap(pending_);
+            batch_times.swap(pending_times_);
+            writing_ = true;
+        }
+        space_available_.notify_all();
+
+        CommitBatch(batch, batch_times);
+        batch.clear();
+        batch_times.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writing_ = false;
+        }
+        space_available_.notify_all();
+    }
+}
+
+bool ScoreWriter::CommitBatch(const std::vector<ScoreEntry>& batch,
+                              const std::vector<Clock::time_point>& enqueue_times) {
+    if (!log_.AppendBatch(batch)) {
+        failed_entries_ += batch.size();
+        std::cerr << "Warning: Lost " << batch.size() << " score(s) that could not be written to "
+                  << log_.GetPath() << std::endl;
+        return false;
+    }
+
+    auto sync_start = Clock::now();
+    bool synced = log_.Sync(); // Records are in the file either way; only durability is at stake
+    auto committed = Clock::now();
+
+    total_sync_time_ns_ += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(committed - sync_start).count());
+    uint64_t max_latency = max_commit_latency_ns_;
+    for (const auto& enqueued : enqueue_times) {
+        uint64_t latency = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(committed - enqueued).count());
+        total_commit_latency_ns_ += latency;
+        max_latency = std::max(max_latency, latency);
+    }
+    max_commit_latency_ns_ = max_latency;
+
+    written_entries_ += batch.size();
+    ++written_batches_;
+    return synced;
+}
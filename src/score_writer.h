@@ -0,0 +1,78 @@
+#ifndef SCORE_WRITER_H
+#define SCORE_WRITER_H
+
+#include "score_entry.h"
+#include "score_log.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Moves score log appends off the game thread (group commit). After the
+// first entry arrives the writer waits up to `coalesce_window` for more,
+// then writes the whole batch with one append and one fsync. Entries queued
+// while a batch is being synced go into the next one.
+class ScoreWriter {
+public:
+    explicit ScoreWriter(ScoreLog& log, std::size_t capacity = 256,
+                         std::chrono::microseconds coalesce_window = std::chrono::milliseconds(5));
+    ~ScoreWriter();
+
+    // Rule of Five - owns a worker thread, neither copyable nor movable
+    ScoreWriter(const ScoreWriter& other) = delete;
+    ScoreWriter& operator=(const ScoreWriter& other) = delete;
+    ScoreWriter(ScoreWriter&& other) = delete;
+    ScoreWriter& operator=(ScoreWriter&& other) = delete;
+
+    void Start();
+    void Stop(); // Writes and syncs everything already queued, then joins the thread
+
+    // Only waits when `capacity` entries are already queued
+    void Enqueue(ScoreEntry entry);
+
+    // Commits without waiting out the coalescing window, and waits until
+    // every entry queued so far is durable
+    void Flush();
+
+    // Statistics
+    uint64_t GetWrittenCount() const { return written_entries_; }
+    uint64_t GetBatchCount() const { return written_batches_; }
+    uint64_t GetFailedCount() const { return failed_entries_; }
+    std::chrono::nanoseconds GetAverageSyncTime() const;
+    std::chrono::nanoseconds GetAverageCommitLatency() const; // Enqueue to durable
+    std::chrono::nanoseconds GetMaxCommitLatency() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ScoreLog& log_;
+    const std::size_t capacity_;
+    const std::chrono::microseconds coalesce_window_;
+
+    std::vector<ScoreEntry> pending_;
+    std::vector<Clock::time_point> pending_times_; // Enqueue time per pending entry
+    bool writing_{false};
+    bool flush_requested_{false};
+    bool stop_requested_{false};
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable space_available_; // Also signals "batch finished"
+
+    std::thread worker_;
+
+    std::atomic<uint64_t> written_entries_{0};
+    std::atomic<uint64_t> written_batches_{0};
+    std::atomic<uint64_t> failed_entries_{0};
+    std::atomic<uint64_t> total_sync_time_ns_{0};
+    std::atomic<uint64_t> total_commit_latency_ns_{0};
+    std::atomic<uint64_t> max_commit_latency_ns_{0};
+
+    void WriterThread();
+    bool CommitBatch(const std::vector<ScoreEntry>& batch,
+                     const std::vector<Clock::time_point>& enqueue_times);
+};
+
+#endif
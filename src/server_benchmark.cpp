@@ -0,0 +1,173 @@
+// Networked multiplayer benchmark: a GameServer and many GameClients in
+// one process over loopback TCP. Every tick the clients may turn, the
+// server steps and broadcasts its delta, and each client reads until it
+// has caught up. Reports the server's tick cost, the bytes each client
+// receives per tick against a full keyframe, and whether every client's
+// reconstructed state matches the server's. A few clients leave and rejoin
+// halfway, taking over snakes run by bots meanwhile.
+//
+// Usage: ServerBenchmark [clients] [grid size] [ticks] [seed]
+
+#include "board_config.h"
+#include "game_client.h"
+#include "game_server.h"
+#include "world_delta.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  // Polls until the client holds the server's latest tick; false on a
+  // lost connection or after a second without progress
+  bool CatchUp(GameClient &client, const GameServer &server) {
+    auto deadline = Clock::now() + std::chrono::seconds(1);
+    while (!client.IsReady() || client.GetFrame().tick != server.GetFrame().tick) {
+      if (!client.Poll() || Clock::now() > deadline) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unique_ptr<GameClient> Join(uint16_t port) {
+    auto client = std::make_unique<GameClient>();
+    if (!client->Connect(port)) {
+      return nullptr;
+    }
+    return client;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  std::size_t client_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 128;
+  uint32_t grid = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 256;
+  uint64_t ticks = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 600;
+  uint32_t seed = argc > 4 ? static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 1;
+  client_count = std::max<std::size_t>(client_count, 1);
+  grid = std::max<uint32_t>(grid, 8);
+  ticks = std::max<uint64_t>(ticks, 2);
+
+  BoardConfig config(grid, grid);
+  GameServer::Options options;
+  options.food_count = std::max<std::size_t>(1, client_count / 8);
+  options.seed = seed;
+  GameServer server(config, options);
+  if (!server.Start()) {
+    return 1;
+  }
+
+  std::vector<std::unique_ptr<GameClient>> clients;
+  for (std::size_t i = 0; i < client_count; ++i) {
+    if (i % 128 == 127) {
+      server.Tick(); // Accepts before the listen backlog fills
+    }
+    clients.push_back(Join(server.GetPort()));
+    if (!clients.back()) {
+      return 1;
+    }
+  }
+
+  std::cout << "Server benchmark: " << client_count << " clients on " << grid << "x" << grid
+            << ", " << ticks << " ticks over 127.0.0.1:" << server.GetPort() << std::endl;
+
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> turn(0, 19); // Turns about every 20 ticks
+  std::uniform_int_distribution<int> direction(0, 3);
+  const std::size_t rejoining = std::max<std::size_t>(1, client_count / 16);
+  WorldFrame empty;
+  empty.width = grid;
+  empty.height = grid;
+  std::vector<uint8_t> keyframe;
+  uint64_t keyframe_bytes = 0;
+  uint64_t keyframe_samples = 0;
+  uint64_t lost = 0;
+  uint64_t mismatches = 0;
+  double catch_up_seconds = 0.0;
+
+  for (uint64_t tick = 0; tick < ticks; ++tick) {
+    if (tick == ticks / 2) {
+      // Some players leave; bots take their snakes until others join
+      for (std::size_t i = 0; i < rejoining; ++i) {
+        clients[i].reset();
+      }
+      server.Tick();
+      for (std::size_t i = 0; i < rejoining; ++i) {
+        clients[i] = Join(server.GetPort());
+        if (!clients[i]) {
+          return 1;
+        }
+      }
+    }
+    if (tick == 1) {
+      server.ResetStats(); // Leaves out the first tick's keyframes
+    }
+
+    for (auto &client : clients) {
+      if (client->IsReady() && turn(engine) == 0) {
+        client->SendDirection(static_cast<Snake::Direction>(direction(engine)));
+      }
+    }
+    server.Tick();
+
+    auto start = Clock::now();
+    for (auto &client : clients) {
+      if (!CatchUp(*client, server)) {
+        ++lost;
+      }
+    }
+    catch_up_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (tick % 60 == 59) {
+      WorldDelta::Encode(empty, server.GetFrame(), keyframe);
+      keyframe_bytes += keyframe.size();
+      ++keyframe_samples;
+      for (const auto &client : clients) {
+        if (client->GetFrame() != server.GetFrame()) {
+          ++mismatches;
+        }
+      }
+    }
+  }
+
+  std::size_t in_sync = 0;
+  for (const auto &client : clients) {
+    if (client->GetFrame() == server.GetFrame()) {
+      ++in_sync;
+    }
+  }
+
+  double delta_bytes = server.GetAverageStateBytes();
+  double full_bytes = keyframe_samples > 0 ? static_cast<double>(keyframe_bytes) / keyframe_samples : 0.0;
+  const WorldFrame &frame = server.GetFrame();
+  std::size_t body_cells = 0;
+  for (const WorldFrame::SnakeState &snake : frame.snakes) {
+    body_cells += snake.body.size();
+  }
+
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "  server tick: " << server.GetAverageTickMicroseconds() << " us avg, "
+            << server.GetMaxTickMicroseconds() << " us max (budget " << 1e6 / config.tickRate
+            << " us at " << config.tickRate << " Hz)" << std::endl;
+  std::cout << "  clients catching up: " << catch_up_seconds * 1e6 / ticks << " us per tick for all "
+            << client_count << std::endl;
+  std::cout << "  world: " << frame.snakes.size() << " snakes, " << body_cells << " body cells, "
+            << frame.foods.size() << " foods, " << frame.obstacles.size() << " obstacles" << std::endl;
+  std::cout << "  per client: " << delta_bytes << " bytes per tick ("
+            << delta_bytes * 8 * config.tickRate / 1000 << " kbit/s), keyframe " << full_bytes
+            << " bytes, raw grid " << static_cast<uint64_t>(grid) * grid << " bytes" << std::endl;
+  std::cout << "  delta vs keyframe: " << (delta_bytes > 0 ? full_bytes / delta_bytes : 0.0)
+            << "x smaller; server sent " << server.GetBytesSent() / 1024 << " KiB, received "
+            << server.GetBytesReceived() << " bytes" << std::endl;
+  std::cout << "  " << in_sync << "/" << client_count << " clients in sync at the end, "
+            << mismatches << " mismatches in periodic checks, " << lost << " stalls, "
+            << server.GetDroppedClients() << " clients dropped or left" << std::endl;
+  return in_sync == client_count && mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,334 @@
+#include "sim_state.h"
+#include "movement_patterns.h"
+#include "noise_field.h"
+#include "obstacle_manager.h"
+#include "simulation.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+  // Same lifetimes as ObstacleManager's defaults
+  constexpr float kFixedLifetime = 12.0f;
+  constexpr float kMovingLifetime = 7.0f;
+  constexpr int kSwarmSize = 6; // ObstacleManager's swarm size
+  constexpr int kNoiseDriftLevel = 3; // ObstacleManager's first level with drifters
+}
+
+uint64_t SimState::NextRandom() {
+  // splitmix64
+  uint64_t z = (rng += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+void SimState::Reset(const BoardConfig &config, uint64_t seed) {
+  width = static_cast<uint16_t>(config.gridWidth);
+  height = static_cast<uint16_t>(config.gridHeight);
+  step_seconds = 1.0f / config.tickRate;
+  base_spawn_rate = config.baseSpawnRate;
+  spawn_rate_increase = config.spawnRateIncrease;
+  difficulty_interval = config.difficultyInterval;
+
+  head_x = width / 2;
+  head_y = height / 2;
+  speed = 0.1f;
+  direction = static_cast<uint8_t>(Snake::Direction::kUp);
+  alive = true;
+  growing = false;
+  size = 1;
+  body_start = 0;
+  body_length = 0;
+
+  score = 0;
+  ticks = 0;
+  spawn_timer = 0.0f;
+  obstacle_count = 0;
+  noise_field = nullptr;
+  rng = seed;
+  UpdateDifficulty();
+  PlaceFood();
+}
+
+bool SimState::Capture(const Simulation &simulation, uint64_t seed, SimState &state) {
+  const BoardConfig &config = simulation.GetConfig();
+  const Snake &snake = simulation.GetSnake();
+  const ObstacleManager &manager = simulation.GetObstacles();
+  if (static_cast<uint64_t>(config.gridWidth) * config.gridHeight > 65536 || snake.body.size() > kMaxBody ||
+      manager.GetObstacleCount() > static_cast<std::size_t>(kMaxObstacles)) {
+    return false;
+  }
+  state.Reset(config, seed);
+
+  state.head_x = snake.head_x;
+  state.head_y = snake.head_y;
+  state.speed = snake.speed;
+  state.direction = static_cast<uint8_t>(snake.direction);
+  state.alive = snake.alive;
+  state.growing = snake.IsGrowing();
+  state.size = snake.size;
+  for (const SDL_Point &cell : snake.body) {
+    state.PushBody(cell.x, cell.y);
+  }
+
+  state.score = simulation.GetScore();
+  state.ticks = static_cast<uint32_t>(simulation.GetTicks());
+  state.food_x = static_cast<int16_t>(simulation.GetFood().x);
+  state.food_y = static_cast<int16_t>(simulation.GetFood().y);
+
+  state.spawn_rate = manager.GetSpawnRate();
+  state.spawn_timer = manager.GetSpawnTimer();
+  state.moving_obstacle_speed = manager.GetMovingObstacleSpeed();
+  state.difficulty_level = manager.GetDifficultyLevel();
+  state.noise_field = manager.GetNoiseField();
+  std::vector<const Obstacle *> obstacles;
+  manager.QueryObstaclesInRect(SDL_Rect{0, 0, state.width, state.height}, obstacles);
+  state.obstacle_count = 0;
+  for (const Obstacle *obstacle : obstacles) {
+    ObstacleState &copy = state.obstacles[state.obstacle_count++];
+    copy = NewObstacle(obstacle->GetX(), obstacle->GetY(), obstacle->GetRemainingLifetime());
+    if (obstacle->GetType() == ObstacleType::MOVING) {
+      const auto *moving = static_cast<const MovingObstacle *>(obstacle);
+      copy.moving = 1;
+      copy.pattern = static_cast<uint8_t>(moving->GetPattern());
+      copy.direction = static_cast<int8_t>(moving->GetDirection());
+      copy.counter = moving->GetMovementCounter();
+      copy.speed = moving->GetSpeed();
+      copy.exact_x = moving->GetExactX();
+      copy.exact_y = moving->GetExactY();
+      copy.velocity_x = moving->GetVelocityX();
+      copy.velocity_y = moving->GetVelocityY();
+    }
+  }
+  return true;
+}
+
+void SimState::Steer(Snake::Direction turn) {
+  if (!IsReverse(turn)) {
+    direction = static_cast<uint8_t>(turn);
+  }
+}
+
+bool SimState::IsReverse(Snake::Direction turn) const {
+  if (size == 1) return false;
+  switch (turn) {
+  case Snake::Direction::kUp: return GetDirection() == Snake::Direction::kDown;
+  case Snake::Direction::kDown: return GetDirection() == Snake::Direction::kUp;
+  case Snake::Direction::kLeft: return GetDirection() == Snake::Direction::kRight;
+  case Snake::Direction::kRight: return GetDirection() == Snake::Direction::kLeft;
+  }
+  return false;
+}
+
+bool SimState::IsBodyCell(int x, int y) const {
+  uint16_t cell = Cell(x, y);
+  for (int i = 0; i < body_length; ++i) {
+    if (body[(body_start + i) % kMaxBody] == cell) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SimState::IsObstacleCell(int x, int y) const {
+  for (int i = 0; i < obstacle_count; ++i) {
+    if (obstacles[i].x == x && obstacles[i].y == y) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SimState::PushBody(int x, int y) {
+  if (body_length == kMaxBody) {
+    body_start = (body_start + 1) % kMaxBody; // Full: drop the tail
+    --body_length;
+  }
+  body[(body_start + body_length) % kMaxBody] = Cell(x, y);
+  ++body_length;
+}
+
+void SimState::Step() {
+  if (!alive) {
+    return;
+  }
+  ++ticks;
+
+  UpdateObstacles();
+  UpdateSnake();
+  if (alive && IsObstacleCell(static_cast<int>(head_x), static_cast<int>(head_y))) {
+    alive = false;
+  }
+  if (!alive) {
+    return;
+  }
+
+  if (food_x == static_cast<int>(head_x) && food_y == static_cast<int>(head_y)) {
+    score++;
+    PlaceFood();
+    growing = true;
+    speed += 0.02;
+    UpdateDifficulty();
+  }
+}
+
+// Snake::Update
+void SimState::UpdateSnake() {
+  int prev_x = static_cast<int>(head_x);
+  int prev_y = static_cast<int>(head_y);
+  switch (static_cast<Snake::Direction>(direction)) {
+  case Snake::Direction::kUp: head_y -= speed; break;
+  case Snake::Direction::kDown: head_y += speed; break;
+  case Snake::Direction::kLeft: head_x -= speed; break;
+  case Snake::Direction::kRight: head_x += speed; break;
+  }
+  head_x = std::fmod(head_x + width, static_cast<float>(width));
+  head_y = std::fmod(head_y + height, static_cast<float>(height));
+
+  int new_x = static_cast<int>(head_x);
+  int new_y = static_cast<int>(head_y);
+  if (new_x == prev_x && new_y == prev_y) {
+    return;
+  }
+  bool full = body_length == kMaxBody;
+  PushBody(prev_x, prev_y); // Drops the tail itself when full
+  if (!full) {
+    if (!growing) {
+      body_start = (body_start + 1) % kMaxBody;
+      --body_length;
+    } else {
+      size++;
+    }
+  }
+  growing = false;
+  if (IsBodyCell(new_x, new_y)) {
+    alive = false;
+  }
+}
+
+// ObstacleManager movement, lifetimes and spawning, in Simulation::Step order
+void SimState::UpdateObstacles() {
+  for (int i = 0; i < obstacle_count; ++i) {
+    ObstacleState &obstacle = obstacles[i];
+    if (!obstacle.moving) {
+      continue;
+    }
+    auto pattern = static_cast<MovementPattern>(obstacle.pattern);
+    if (pattern == MovementPattern::FLOCKING || pattern == MovementPattern::NOISE_DRIFT) {
+      // MovingObstacle::FollowNoise and AdvanceExactPosition
+      if (pattern == MovementPattern::NOISE_DRIFT && noise_field) {
+        float direction_x, direction_y;
+        noise_field->Sample(obstacle.exact_x, obstacle.exact_y, obstacle.counter, direction_x, direction_y);
+        obstacle.velocity_x = direction_x * obstacle.speed;
+        obstacle.velocity_y = direction_y * obstacle.speed;
+      }
+      obstacle.exact_x = std::fmod(obstacle.exact_x + obstacle.velocity_x + width, static_cast<float>(width));
+      obstacle.exact_y = std::fmod(obstacle.exact_y + obstacle.velocity_y + height, static_cast<float>(height));
+      obstacle.x = static_cast<int16_t>(std::min(static_cast<int>(obstacle.exact_x), width - 1));
+      obstacle.y = static_cast<int16_t>(std::min(static_cast<int>(obstacle.exact_y), height - 1));
+      obstacle.counter += obstacle.speed;
+      continue;
+    }
+    SDL_Point position{obstacle.x, obstacle.y};
+    SDL_Point next;
+    if (pattern == MovementPattern::RANDOM_WALK) {
+      // From the state's own generator, so clones step reproducibly
+      next = MovementPatterns::CalculateLinearMovement(position, RandomBelow(4), obstacle.speed);
+    } else {
+      next = MovementPatterns::MovementCalculator::ProcessMovement(
+          position, pattern, obstacle.speed, obstacle.counter, obstacle.direction, width, height);
+    }
+    next = MovementPatterns::ValidateMovement(position, [next](const SDL_Point &) { return next; },
+                                              width, height);
+    obstacle.x = static_cast<int16_t>(next.x);
+    obstacle.y = static_cast<int16_t>(next.y);
+    obstacle.counter += obstacle.speed;
+  }
+
+  int kept = 0;
+  for (int i = 0; i < obstacle_count; ++i) {
+    ObstacleState &obstacle = obstacles[i];
+    obstacle.lifetime = std::max(0.0f, obstacle.lifetime - step_seconds);
+    if (obstacle.lifetime >= std::numeric_limits<float>::epsilon()) {
+      obstacles[kept++] = obstacle;
+    }
+  }
+  obstacle_count = kept;
+
+  spawn_timer += step_seconds;
+  if (spawn_timer >= 1.0f / spawn_rate) {
+    spawn_timer = 0.0f;
+    SpawnObstacle();
+  }
+}
+
+void SimState::SpawnObstacle() {
+  int x = RandomBelow(width);
+  int y = RandomBelow(height);
+  if (obstacle_count == kMaxObstacles || IsObstacleCell(x, y)) {
+    return;
+  }
+  // 60% fixed, 35% moving (a seventh of them drifting from
+  // kNoiseDriftLevel on), 5% a flocking swarm sharing one heading, as in
+  // ObstacleManager::SpawnRandomObstacle
+  int type_roll = RandomBelow(20);
+  if (type_roll == 19) {
+    float angle = static_cast<float>((NextRandom() >> 11) * 0x1.0p-53 * 2.0 * M_PI);
+    float velocity_x = moving_obstacle_speed * std::cos(angle);
+    float velocity_y = moving_obstacle_speed * std::sin(angle);
+    for (int attempt = 0; attempt < kSwarmSize * 4 && obstacle_count < kMaxObstacles; ++attempt) {
+      int member_x = attempt == 0 ? x : (x + RandomBelow(5) - 2 + width) % width;
+      int member_y = attempt == 0 ? y : (y + RandomBelow(5) - 2 + height) % height;
+      if (!IsObstacleCell(member_x, member_y)) {
+        ObstacleState &member = obstacles[obstacle_count++];
+        member = NewObstacle(member_x, member_y, kMovingLifetime);
+        member.moving = 1;
+        member.pattern = static_cast<uint8_t>(MovementPattern::FLOCKING);
+        member.speed = moving_obstacle_speed;
+        member.velocity_x = velocity_x;
+        member.velocity_y = velocity_y;
+      }
+    }
+    return;
+  }
+  ObstacleState &obstacle = obstacles[obstacle_count++];
+  obstacle = NewObstacle(x, y, kFixedLifetime);
+  if (type_roll >= 12) {
+    // One of the five single patterns, or a drifter
+    bool drifting = type_roll == 18 && difficulty_level >= kNoiseDriftLevel;
+    obstacle.moving = 1;
+    obstacle.pattern = static_cast<uint8_t>(drifting ? MovementPattern::NOISE_DRIFT
+                                                     : static_cast<MovementPattern>(RandomBelow(5)));
+    obstacle.lifetime = kMovingLifetime;
+    obstacle.speed = moving_obstacle_speed;
+    MovingObstacle::StartingVelocity(x, y, obstacle.speed, obstacle.velocity_x, obstacle.velocity_y);
+  }
+}
+
+SimState::ObstacleState SimState::NewObstacle(int x, int y, float lifetime) {
+  return ObstacleState{static_cast<int16_t>(x), static_cast<int16_t>(y), 0, 0, 1, lifetime, 0.0f, 0.0f,
+                       x + 0.5f, y + 0.5f, 0.0f, 0.0f};
+}
+
+void SimState::PlaceFood() {
+  while (true) {
+    int x = RandomBelow(width);
+    int y = RandomBelow(height);
+    bool head = x == static_cast<int>(head_x) && y == static_cast<int>(head_y);
+    if (!head && !IsBodyCell(x, y) && !IsObstacleCell(x, y)) {
+      food_x = static_cast<int16_t>(x);
+      food_y = static_cast<int16_t>(y);
+      return;
+    }
+  }
+}
+
+// Simulation::UpdateDifficulty through ObstacleManager::SetDifficultyLevel
+// and SetSpawnRate
+void SimState::UpdateDifficulty() {
+  difficulty_level = score / std::max(1, static_cast<int>(difficulty_interval)) + 1;
+  moving_obstacle_speed = 0.05f + difficulty_level * 0.01f;
+  spawn_rate = base_spawn_rate + difficulty_level * spawn_rate_increase;
+}
@@ -0,0 +1,134 @@
+#ifndef SIM_STATE_H
+#define SIM_STATE_H
+
+#include "SDL.h"
+#include "board_config.h"
+#include "moving_obstacle.h"
+#include "snake.h"
+#include <cstdint>
+#include <type_traits>
+
+class NoiseField;
+class Simulation;
+
+// The whole state of one game in a fixed-size, trivially copyable block of
+// about 4.4 KB, for lookahead planners that clone a game thousands of times
+// per decision: a copy is one memcpy. Step applies the rules of
+// Simulation::Step (the same snake, food, spawn, movement-pattern and
+// difficulty rules) to the copy.
+//
+// The body is a ring of cell indices and obstacles a small array, so
+// collision checks scan them instead of using grids; both stay short in
+// play. Randomness comes from a 64-bit generator inside the state, so a
+// state always steps the same way, but not the same way as the
+// Simulation it was captured from. Boards are limited to 65536 cells,
+// bodies to kMaxBody cells (growth stops there) and boards to
+// kMaxObstacles obstacles (spawns are skipped beyond that). FLOCKING and
+// NOISE_DRIFT obstacles keep their fractional position and velocity:
+// flocks coast on their heading (steering them would need the whole
+// flock), and drifters follow the noise field of the Simulation the state
+// was captured from, which must outlive it (a state from Reset has none,
+// so its drifters coast too).
+class SimState {
+public:
+  static constexpr int kMaxBody = 1024;
+  static constexpr int kMaxObstacles = 64;
+
+  // A new game, like Simulation(config, seed)
+  void Reset(const BoardConfig &config, uint64_t seed);
+
+  // Copies a running game; false, leaving `state` untouched, if it does not
+  // fit (over 65536 cells, kMaxBody body cells or kMaxObstacles obstacles)
+  static bool Capture(const Simulation &simulation, uint64_t seed, SimState &state);
+
+  // Turns unless that reverses into the body (same rule as Controller)
+  void Steer(Snake::Direction direction);
+  bool IsReverse(Snake::Direction turn) const;
+  void Step(); // One fixed update
+
+  // Replaces the generator behind spawns and food, so clones of one state
+  // can play out different futures
+  void Reseed(uint64_t seed) { rng = seed; }
+
+  bool IsOver() const { return !alive; }
+  int GetScore() const { return score; }
+  uint32_t GetTicks() const { return ticks; }
+  Snake::Direction GetDirection() const { return static_cast<Snake::Direction>(direction); }
+  SDL_Point GetHead() const { return SDL_Point{static_cast<int>(head_x), static_cast<int>(head_y)}; }
+  SDL_Point GetFood() const { return SDL_Point{food_x, food_y}; }
+  int GetWidth() const { return width; }
+  int GetHeight() const { return height; }
+  int GetBodyLength() const { return body_length; }
+  int GetObstacleCount() const { return obstacle_count; }
+
+  bool IsBodyCell(int x, int y) const;
+  bool IsObstacleCell(int x, int y) const;
+
+private:
+  struct ObstacleState {
+    int16_t x;
+    int16_t y;
+    uint8_t moving;
+    uint8_t pattern; // MovementPattern
+    int8_t direction;
+    float lifetime;
+    float counter;
+    float speed;
+    float exact_x; // FLOCKING and NOISE_DRIFT, as in MovingObstacle
+    float exact_y;
+    float velocity_x;
+    float velocity_y;
+  };
+
+  // Board and difficulty curve
+  uint16_t width{0};
+  uint16_t height{0};
+  float step_seconds{0};
+  float base_spawn_rate{0};
+  float spawn_rate_increase{0};
+  int32_t difficulty_interval{1};
+  int32_t difficulty_level{1};
+
+  // Snake
+  float head_x{0};
+  float head_y{0};
+  float speed{0.1f};
+  uint8_t direction{0}; // Snake::Direction
+  bool alive{true};
+  bool growing{false};
+  int32_t size{1};
+  uint16_t body_start{0};  // Ring index of the tail
+  uint16_t body_length{0};
+  uint16_t body[kMaxBody]; // Cell indices, tail first
+
+  // Game
+  int32_t score{0};
+  uint32_t ticks{0};
+  int16_t food_x{0};
+  int16_t food_y{0};
+
+  // Obstacles
+  float spawn_rate{0};
+  float spawn_timer{0};
+  float moving_obstacle_speed{0.05f};
+  int32_t obstacle_count{0};
+  ObstacleState obstacles[kMaxObstacles];
+  const NoiseField *noise_field{nullptr}; // Owned by the captured Simulation's ObstacleManager
+
+  uint64_t rng{0};
+
+  uint64_t NextRandom();
+  int RandomBelow(int bound) { return static_cast<int>(NextRandom() % static_cast<uint64_t>(bound)); }
+  uint16_t Cell(int x, int y) const { return static_cast<uint16_t>(y * width + x); }
+  static ObstacleState NewObstacle(int x, int y, float lifetime); // Fixed, until made moving
+  void PushBody(int x, int y);
+  void UpdateSnake();
+  void UpdateObstacles();
+  void SpawnObstacle();
+  void PlaceFood();
+  void UpdateDifficulty();
+};
+
+static_assert(std::is_trivially_copyable<SimState>::value, "SimState is cloned with memcpy");
+
+#endif
@@ -0,0 +1,112 @@
+#include "simulation.h"
+#include "collision_detector.h"
+#include "movement_patterns.h"
+
+Simulation::Simulation(const BoardConfig& config, uint32_t seed,
+                       std::shared_ptr<const NoiseField> noise_field)
+    : config(config), step_seconds(1.0f / config.tickRate),
+      snake(config.gridWidth, config.gridHeight),
+      obstacles(config.gridWidth, config.gridHeight),
+      random_w(0, static_cast<int>(config.gridWidth) - 1),
+      random_h(0, static_cast<int>(config.gridHeight) - 1) {
+  if (noise_field) {
+    obstacles.SetNoiseField(std::move(noise_field));
+  } else {
+      obstacles.BuildNoiseField(0);
+  }
+  Reset(seed);
+}
+
+void Simulation::Reset(uint32_t seed) {
+  engine.seed(seed);
+  obstacles.SeedRandom(seed ^ 0x9E3779B9u);
+  // Per thread, so a game is reproducible as long as its thread steps
+  // only that game until it ends
+  MovementPatterns::MovementCalculator::SeedRandomWalk(seed ^ 0x85EBCA6Bu);
+  obstacles.ClearAllObstacles();
+  snake.Reset();
+  score = 0;
+  ticks = 0;
+  UpdateDifficulty();
+  PlaceFood();
+}
+
+void Simulation::Step() {
+  if (!snake.alive) {
+    return;
+  }
+  ++ticks;
+
+  // Same order as Game::Update; lifetimes are advanced here instead of by
+  // ThreadedObstacleManager's background thread
+  obstacles.UpdateObstacleMovement();
+  obstacles.UpdateObstacleLifetimes(step_seconds);
+  obstacles.ClearExpiredObstacles();
+  if (obstacles.ShouldSpawnObstacle(step_seconds)) {
+    obstacles.SpawnRandomObstacle();
+  }
+
+  snake.Update();
+  if (CollisionDetector::CheckCollisionOptimized(snake, obstacles)) {
+    snake.alive = false;
+  }
+  if (!snake.alive) {
+    return;
+  }
+
+  int new_x = static_cast<int>(snake.head_x);
+  int new_y = static_cast<int>(snake.head_y);
+  if (food.x == new_x && food.y == new_y) {
+    score++;
+    PlaceFood();
+    snake.GrowBody();
+    snake.speed += 0.02;
+    UpdateDifficulty();
+  }
+}
+
+void Simulation::CaptureSnapshot(GameSnapshot& snapshot) const {
+  snapshot.config_fingerprint = config.Fingerprint();
+  snapshot.grid_width = config.gridWidth;
+  snapshot.grid_height = config.gridHeight;
+  snapshot.player_name.clear();
+  snapshot.score = score;
+  snapshot.ticks = ticks;
+  snapshot.CaptureSnake(snake);
+  snapshot.food = food;
+  snapshot.CaptureObstacles(obstacles);
+  snapshot.food_engine = engine;
+  snapshot.random_walk_engine = MovementPatterns::MovementCalculator::GetRandomWalkEngine();
+}
+
+bool Simulation::RestoreSnapshot(const GameSnapshot& snapshot) {
+  if (snapshot.config_fingerprint != config.Fingerprint()) {
+    return false;
+  }
+  score = snapshot.score;
+  ticks = snapshot.ticks;
+  snapshot.RestoreSnake(snake);
+  food = snapshot.food;
+  snapshot.RestoreObstacles(obstacles);
+  engine = snapshot.food_engine;
+  MovementPatterns::MovementCalculator::SetRandomWalkEngine(snapshot.random_walk_engine);
+  return true;
+}
+
+void Simulation::PlaceFood() {
+  while (true) {
+    int x = random_w(engine);
+    int y = random_h(engine);
+    if (!snake.SnakeCell(x, y) && obstacles.IsValidFoodPosition(x, y)) {
+      food.x = x;
+      food.y = y;
+      return;
+    }
+  }
+}
+
+void Simulation::UpdateDifficulty() {
+  int difficulty_level = config.GetDifficultyLevel(score);
+  obstacles.SetDifficultyLevel(difficulty_level);
+  obstacles.SetSpawnRate(config.GetSpawnRate(difficulty_level));
+}
@@ -0,0 +1,62 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "SDL.h"
+#include "board_config.h"
+#include "game_snapshot.h"
+#include "snake.h"
+#include "obstacle_manager.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+
+// One game without a window: the rules of Game::Update (snake movement,
+// food, obstacle spawning, movement and lifetimes, collisions) stepped one
+// fixed tick at a time, with no rendering, input, threads or score
+// persistence. Food and obstacle placement are reproducible from the seed.
+//
+// Drifting obstacles follow `noise_field`, shared by a batch of games
+// (BatchSimulator, VectorEnv); without one the constructor builds its own
+// on every core. Reset keeps the field, so games played in turn reuse it.
+class Simulation {
+public:
+  Simulation(const BoardConfig& config, uint32_t seed,
+             std::shared_ptr<const NoiseField> noise_field = nullptr);
+
+  void Reset(uint32_t seed);
+  void Step(); // One fixed update (1 / config.tickRate seconds)
+
+  bool IsOver() const { return !snake.alive; }
+  int GetScore() const { return score; }
+  uint64_t GetTicks() const { return ticks; }
+  float GetElapsedSeconds() const { return ticks * step_seconds; }
+
+  const BoardConfig& GetConfig() const { return config; }
+  Snake& GetSnake() { return snake; }
+  const Snake& GetSnake() const { return snake; }
+  const SDL_Point& GetFood() const { return food; }
+  const ObstacleManager& GetObstacles() const { return obstacles; }
+
+  // Saving and resuming. Random-walk movement draws from a per-thread
+  // generator, which both calls save and replace for the calling thread.
+  void CaptureSnapshot(GameSnapshot& snapshot) const;
+  bool RestoreSnapshot(const GameSnapshot& snapshot); // False for another board
+
+private:
+  BoardConfig config;
+  float step_seconds;
+  Snake snake;
+  ObstacleManager obstacles;
+  SDL_Point food{0, 0};
+  int score{0};
+  uint64_t ticks{0};
+
+  std::mt19937 engine;
+  std::uniform_int_distribution<int> random_w;
+  std::uniform_int_distribution<int> random_h;
+
+  void PlaceFood();
+  void UpdateDifficulty();
+};
+
+#endif
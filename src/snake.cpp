@@ -47,34 +47,67 @@ void Snake::UpdateBody(SDL_Point &current_head_cell,
                        SDL_Point &prev_head_cell) {
   // Add previous head location to vector
   body.push_back(prev_head_cell);
+  Cells().Add(prev_head_cell.x, prev_head_cell.y);
 
   if (!growing) {
     // Remove the tail from the vector.
-    body.erase(body.begin());
+    Cells().Remove(body.front().x, body.front().y);
+    body.pop_front();
   } else {
     growing = false;
     size++;
   }
 
-  // Check if the snake has died.
-  for (auto const &item : body) {
-    if (current_head_cell.x == item.x && current_head_cell.y == item.y) {
-      alive = false;
-    }
+  // Check if the snake has died. On a shared grid the other snakes may not
+  // have moved yet, so the owner of the grid checks instead.
+  if (!shared_cells && Cells().IsOccupied(current_head_cell.x, current_head_cell.y)) {
+    alive = false;
   }
 }
 
+void Snake::Reset() {
+  ClearBody();
+  direction = Direction::kUp;
+  speed = 0.1f;
+  size = 1;
+  alive = true;
+  growing = false;
+  head_x = grid_width / 2;
+  head_y = grid_height / 2;
+}
+
 void Snake::GrowBody() { growing = true; }
 
-// Inefficient method to check if cell is occupied by snake.
-bool Snake::SnakeCell(int x, int y) {
+void Snake::ClearBody() {
+  OccupancyGrid &cells = Cells();
+  for (const SDL_Point &cell : body) {
+    cells.Remove(cell.x, cell.y);
+  }
+  body.clear();
+}
+
+void Snake::RestoreBody(const std::vector<SDL_Point> &cells) {
+  ClearBody();
+  OccupancyGrid &grid = Cells();
+  for (const SDL_Point &cell : cells) {
+    body.push_back(cell);
+    grid.Add(cell.x, cell.y);
+  }
+}
+
+bool Snake::SnakeCell(int x, int y) const {
   if (x == static_cast<int>(head_x) && y == static_cast<int>(head_y)) {
     return true;
   }
-  for (auto const &item : body) {
-    if (x == item.x && y == item.y) {
-      return true;
-    }
+  return Cells().IsOccupied(x, y);
+}
+bool Snake::IsReverse(Direction turn) const {
+  if (size == 1) return false;
+  switch (turn) {
+  case Direction::kUp: return direction == Direction::kDown;
+  case Direction::kDown: return direction == Direction::kUp;
+  case Direction::kLeft: return direction == Direction::kRight;
+  case Direction::kRight: return direction == Direction::kLeft;
   }
   return false;
-}
\ No newline at end of file
+}
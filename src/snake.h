@@ -2,6 +2,8 @@
 #define SNAKE_H
 
 #include "SDL.h"
+#include "occupancy_grid.h"
+#include <deque>
 #include <vector>
 
 class Snake {
@@ -10,12 +12,29 @@ public:
 
   Snake(int grid_width, int grid_height)
       : grid_width(grid_width), grid_height(grid_height),
-        head_x(grid_width / 2), head_y(grid_height / 2) {}
+        head_x(grid_width / 2), head_y(grid_height / 2),
+        body_cells(grid_width, grid_height) {}
+
+  // Records body cells in `shared_cells` (owned by the caller, shared by
+  // every snake on the board) instead of a grid of its own, and BodyCell
+  // answers for all snakes. Update then leaves collisions to the owner of
+  // the grid, which checks every head once all snakes have moved.
+  Snake(int grid_width, int grid_height, OccupancyGrid *shared_cells)
+      : grid_width(grid_width), grid_height(grid_height),
+        head_x(grid_width / 2), head_y(grid_height / 2),
+        body_cells(0, 0), shared_cells(shared_cells) {}
 
   void Update();
+  void Reset(); // Back to the starting state, keeping the allocated buffers
 
   void GrowBody();
-  bool SnakeCell(int x, int y);
+  bool IsGrowing() const { return growing; } // Grows on the next move
+  void ClearBody(); // Empties the body and its cells (a dead snake leaving the board)
+  void RestoreBody(const std::vector<SDL_Point> &cells); // Replaces the body, tail first (loading a saved game)
+  bool SnakeCell(int x, int y) const;
+  bool IsReverse(Direction turn) const; // Turning back into the body (same rule as Controller)
+  bool BodyCell(int x, int y) const { return Cells().IsOccupied(x, y); }
+  const OccupancyGrid &GetBodyCells() const { return Cells(); }
 
   Direction direction = Direction::kUp;
 
@@ -24,7 +43,7 @@ public:
   bool alive{true};
   float head_x;
   float head_y;
-  std::vector<SDL_Point> body;
+  std::deque<SDL_Point> body; // Tail first; moves are O(1) at both ends
 
 private:
   void UpdateHead();
@@ -33,6 +52,13 @@ private:
   bool growing{false};
   int grid_width;
   int grid_height;
+
+  // Mirrors `body` so cell lookups and self-collision are O(1)
+  OccupancyGrid body_cells;
+  OccupancyGrid *shared_cells{nullptr}; // Used instead of body_cells when set
+
+  OccupancyGrid &Cells() { return shared_cells ? *shared_cells : body_cells; }
+  const OccupancyGrid &Cells() const { return shared_cells ? *shared_cells : body_cells; }
 };
 
 #endif
\ No newline at end of file
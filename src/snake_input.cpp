@@ -0,0 +1,89 @@
+#include "snake_input.h"
+#include "arena.h"
+#include <cstdlib>
+
+namespace {
+  constexpr Snake::Direction kDirections[] = {Snake::Direction::kUp, Snake::Direction::kRight,
+                                              Snake::Direction::kDown, Snake::Direction::kLeft};
+  constexpr int kDirectionDx[] = {0, 1, 0, -1};
+  constexpr int kDirectionDy[] = {-1, 0, 1, 0};
+
+  // Signed step along one wrapped axis that shortens the distance to `to`
+  int WrappedDelta(int from, int to, int size) {
+    int delta = to - from;
+    if (delta > size / 2) delta -= size;
+    if (delta < -size / 2) delta += size;
+    return delta;
+  }
+}
+
+void DirectionInput::Steer(const Arena &, std::size_t, Snake &snake) {
+  if (pending && !snake.IsReverse(requested)) {
+    snake.direction = requested;
+  }
+  pending = false;
+}
+
+void BotInput::Steer(const Arena &arena, std::size_t index, Snake &snake) {
+  const int width = arena.GetWidth();
+  const int height = arena.GetHeight();
+  const int head_x = static_cast<int>(snake.head_x);
+  const int head_y = static_cast<int>(snake.head_y);
+  // Follow the food's flow field around fixed obstacles when the arena
+  // keeps one and its next step is open this tick
+  if (const FlowField *field = arena.GetFlowFieldFor(index)) {
+    SDL_Point next;
+    if (field->GetNextStep(head_x, head_y, next) && arena.IsCellFree(next.x, next.y)) {
+      for (int i = 0; i < 4; ++i) {
+        if ((head_x + kDirectionDx[i] + width) % width == next.x &&
+            (head_y + kDirectionDy[i] + height) % height == next.y) {
+          if (!snake.IsReverse(kDirections[i])) {
+            snake.direction = kDirections[i];
+            return;
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  const SDL_Point &food = arena.GetFoodFor(index);
+  const int dx = WrappedDelta(head_x, food.x, width);
+  const int dy = WrappedDelta(head_y, food.y, height);
+
+  // Rank the four directions: toward the food along the longer axis, then
+  // the shorter one, then straight on, then anything else
+  int order[4];
+  int count = 0;
+  auto add = [&order, &count](int direction) {
+    for (int i = 0; i < count; ++i) {
+      if (order[i] == direction) return;
+    }
+    order[count++] = direction;
+  };
+  int horizontal = dx > 0 ? 1 : 3;
+  int vertical = dy > 0 ? 2 : 0;
+  if (std::abs(dx) >= std::abs(dy)) {
+    if (dx != 0) add(horizontal);
+    if (dy != 0) add(vertical);
+  } else {
+    if (dy != 0) add(vertical);
+    if (dx != 0) add(horizontal);
+  }
+  for (int i = 0; i < 4; ++i) {
+    if (kDirections[i] == snake.direction) add(i);
+  }
+  for (int i = 0; i < 4; ++i) add(i);
+
+  for (int i = 0; i < 4; ++i) {
+    int direction = order[i];
+    if (snake.IsReverse(kDirections[direction])) continue;
+    int x = (head_x + kDirectionDx[direction] + width) % width; // The board wraps
+    int y = (head_y + kDirectionDy[direction] + height) % height;
+    if (arena.IsCellFree(x, y)) {
+      snake.direction = kDirections[direction];
+      return;
+    }
+  }
+  // Boxed in: keep going
+}
@@ -0,0 +1,37 @@
+#ifndef SNAKE_INPUT_H
+#define SNAKE_INPUT_H
+
+#include "snake.h"
+#include <cstddef>
+
+class Arena;
+
+// Steers one snake of an Arena; called once per tick before the snakes move
+class SnakeInput {
+public:
+  virtual ~SnakeInput() = default;
+  virtual void Steer(const Arena &arena, std::size_t index, Snake &snake) = 0;
+};
+
+// Applies the last direction it was given (a local player's keys, or an
+// external agent's action). Reversing into the body is ignored, as in
+// Controller.
+class DirectionInput : public SnakeInput {
+public:
+  void SetDirection(Snake::Direction direction) { requested = direction; pending = true; }
+  void Steer(const Arena &arena, std::size_t index, Snake &snake) override;
+
+private:
+  Snake::Direction requested{Snake::Direction::kUp};
+  bool pending{false};
+};
+
+// Heads for its food item by the shortest wrapped distance, turning away
+// from occupied cells and obstacles one step ahead. O(1) per tick: no
+// search, so thousands of bots cost little more than their movement.
+class BotInput : public SnakeInput {
+public:
+  void Steer(const Arena &arena, std::size_t index, Snake &snake) override;
+};
+
+#endif
@@ -0,0 +1,181 @@
+// Game snapshot benchmark: plays autopiloted games, saving each one every
+// few seconds through a SnapshotWriter, and reports what a save costs the
+// game thread (capture and hand-off) against what the writer thread spends
+// encoding and writing. Each game is also saved and resumed part way
+// through, and the resumed copy must finish exactly like the original.
+// Last, the windowed Game resumes a saved game, saves it again and resumes
+// that, and the parts a save carries over must come back unchanged.
+//
+// Usage: SnapshotBenchmark [games] [seed] [snapshot file]
+
+#include "autopilot.h"
+#include "game.h"
+#include "game_snapshot.h"
+#include "simulation.h"
+#include "snapshot_writer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  double Microseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  }
+
+  // Plays until the game ends or `max_ticks` have passed
+  void Play(Simulation &simulation, Autopilot &autopilot, uint64_t max_ticks) {
+    while (!simulation.IsOver() && simulation.GetTicks() < max_ticks) {
+      autopilot.Steer(simulation.GetSnake(), simulation.GetFood(), simulation.GetObstacles());
+      simulation.Step();
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int games = argc > 1 ? std::atoi(argv[1]) : 20;
+  uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1;
+  std::string path = argc > 3 ? argv[3] : "snapshot_benchmark.bin";
+  games = std::max(games, 1);
+  const uint64_t max_ticks = 60 * 60 * 10; // Ten simulated minutes per game
+
+  BoardConfig config;
+  const uint64_t save_interval = static_cast<uint64_t>(config.tickRate) * 5;
+  SnapshotWriter writer(path);
+  writer.Start();
+  auto capture = std::make_unique<GameSnapshot>();
+
+  // Saving: capture on this thread, encode and write on the writer's
+  uint64_t saves = 0;
+  Clock::duration capture_time{0};
+  Clock::duration submit_time{0};
+  Clock::duration max_stall{0};
+  for (int game = 0; game < games; ++game) {
+    Simulation simulation(config, seed + game);
+    Autopilot autopilot;
+    while (!simulation.IsOver() && simulation.GetTicks() < max_ticks) {
+      Play(simulation, autopilot, simulation.GetTicks() + save_interval);
+      auto start = Clock::now();
+      simulation.CaptureSnapshot(*capture);
+      auto captured = Clock::now();
+      writer.Submit(capture);
+      auto submitted = Clock::now();
+      capture_time += captured - start;
+      submit_time += submitted - captured;
+      max_stall = std::max(max_stall, submitted - start);
+      ++saves;
+    }
+  }
+  writer.Discard();
+  writer.Stop();
+
+  // Encoding alone, on the last capture
+  std::vector<uint8_t> encoded;
+  const int encode_count = 2000;
+  auto encode_start = Clock::now();
+  for (int i = 0; i < encode_count; ++i) {
+    GameSnapshotFile::Encode(*capture, encoded);
+  }
+  double encode_us = Microseconds(Clock::now() - encode_start) / encode_count;
+
+  // Exact resume: save part way through, play on, then resume the save
+  // elsewhere and play the same ticks; the final states must match
+  int mismatches = 0;
+  std::vector<uint8_t> original_end;
+  std::vector<uint8_t> resumed_end;
+  for (int game = 0; game < games; ++game) {
+    Simulation original(config, seed + game);
+    Autopilot autopilot;
+    Play(original, autopilot, 600 + 97 * game);
+    original.CaptureSnapshot(*capture);
+    if (!GameSnapshotFile::Write(path, *capture)) {
+      ++mismatches;
+      continue;
+    }
+
+    autopilot.Reset();
+    Play(original, autopilot, original.GetTicks() + 3600);
+    GameSnapshot end;
+    original.CaptureSnapshot(end);
+    GameSnapshotFile::Encode(end, original_end);
+
+    GameSnapshot saved;
+    Simulation resumed(config, seed + game + 1000);
+    Autopilot resumed_autopilot;
+    if (!GameSnapshotFile::Read(path, saved) || !resumed.RestoreSnapshot(saved)) {
+      ++mismatches;
+      continue;
+    }
+    Play(resumed, resumed_autopilot, saved.ticks + 3600);
+    resumed.CaptureSnapshot(end);
+    GameSnapshotFile::Encode(end, resumed_end);
+    if (resumed_end != original_end) {
+      ++mismatches;
+    }
+  }
+
+  // The windowed game: its obstacle lifetimes run on a thread, so only the
+  // parts a save must carry over exactly are compared
+  bool game_resumed = false;
+  double game_capture_us = 0.0;
+  {
+    Simulation source(config, seed);
+    Autopilot autopilot;
+    Play(source, autopilot, 600);
+    GameSnapshot saved;
+    source.CaptureSnapshot(saved);
+    saved.player_name = "benchmark";
+
+    const std::string score_file = path + ".scores";
+    {
+      Game original(config.gridWidth, config.gridHeight, score_file, "");
+      Game resumed(config.gridWidth, config.gridHeight, score_file, "");
+      GameSnapshot captured;
+      GameSnapshot reread;
+      GameSnapshot end;
+      if (original.RestoreSnapshot(saved)) {
+        const int game_capture_count = 2000;
+        auto start = Clock::now();
+        for (int i = 0; i < game_capture_count; ++i) {
+          original.CaptureSnapshot(captured);
+        }
+        game_capture_us = Microseconds(Clock::now() - start) / game_capture_count;
+
+        if (GameSnapshotFile::Write(path, captured) && GameSnapshotFile::Read(path, reread) &&
+            resumed.RestoreSnapshot(reread)) {
+          resumed.CaptureSnapshot(end);
+          game_resumed = end.score == saved.score && end.body.size() == saved.body.size() &&
+                         end.head_x == saved.head_x && end.head_y == saved.head_y &&
+                         end.noise_seed == saved.noise_seed && end.food_engine == saved.food_engine &&
+                         end.obstacle_engine == saved.obstacle_engine;
+        }
+      }
+    }
+    std::remove(score_file.c_str());
+    std::remove((score_file + ".idx").c_str());
+  }
+  std::remove(path.c_str());
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Saves: " << saves << " (" << writer.GetWrittenCount() << " written, "
+            << writer.GetReplacedCount() << " replaced before writing, "
+            << writer.GetFailedCount() << " failed)" << std::endl;
+  std::cout << "Snapshot size: " << writer.GetLastSize() << " bytes" << std::endl;
+  std::cout << "Game thread per save: capture " << Microseconds(capture_time) / saves
+            << " us, hand-off " << Microseconds(submit_time) / saves
+            << " us (max " << Microseconds(max_stall) << " us)" << std::endl;
+  std::cout << "Writer thread per save: encode " << encode_us << " us, encode + write + fsync "
+            << std::chrono::duration<double, std::micro>(writer.GetAverageWriteTime()).count()
+            << " us" << std::endl;
+  std::cout << "Resumed games matching the original: " << games - mismatches << "/" << games << std::endl;
+  std::cout << "Windowed game: capture " << game_capture_us << " us, "
+            << (game_resumed ? "resumed" : "MISMATCH") << std::endl;
+  return mismatches == 0 && game_resumed ? 0 : 1;
+}
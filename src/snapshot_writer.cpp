@@ -0,0 +1,139 @@
+#include "snapshot_writer.h"
+#include "atomic_file.h"
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+SnapshotWriter::SnapshotWriter(std::string path)
+    : path_(std::move(path)),
+      pending_snapshot_(std::make_unique<GameSnapshot>()),
+      writing_snapshot_(std::make_unique<GameSnapshot>()) {
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    Stop();
+}
+
+void SnapshotWriter::Start() {
+    if (worker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = false;
+    }
+    worker_ = std::thread(&SnapshotWriter::WriterThread, this);
+}
+
+void SnapshotWriter::Stop() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    work_available_.notify_one();
+    worker_.join();
+}
+
+void SnapshotWriter::Submit(std::unique_ptr<GameSnapshot>& snapshot) {
+    if (!worker_.joinable()) {
+        // Not running (or already stopped): write synchronously
+        WriteSnapshot(*snapshot);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_ == Pending::kWrite) {
+            ++replaced_count_;
+        }
+        std::swap(pending_snapshot_, snapshot);
+        pending_ = Pending::kWrite;
+    }
+    work_available_.notify_one();
+}
+
+void SnapshotWriter::Discard() {
+    if (!worker_.joinable()) {
+        RemoveFile();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_ == Pending::kWrite) {
+            ++replaced_count_;
+        }
+        pending_ = Pending::kDiscard;
+    }
+    work_available_.notify_one();
+}
+
+void SnapshotWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!worker_.joinable()) {
+        return;
+    }
+    idle_.wait(lock, [this] { return pending_ == Pending::kNone && !writing_; });
+}
+
+std::chrono::nanoseconds SnapshotWriter::GetAverageWriteTime() const {
+    uint64_t written = written_count_;
+    return std::chrono::nanoseconds(written == 0 ? 0 : total_write_time_ns_ / written);
+}
+
+void SnapshotWriter::WriterThread() {
+    while (true) {
+        Pending job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_available_.wait(lock, [this] { return stop_requested_ || pending_ != Pending::kNone; });
+            if (pending_ == Pending::kNone) {
+                return; // Stop requested and nothing left to write
+            }
+            job = pending_;
+            if (job == Pending::kWrite) {
+                std::swap(writing_snapshot_, pending_snapshot_);
+            }
+            pending_ = Pending::kNone;
+            writing_ = true;
+        }
+
+        if (job == Pending::kWrite) {
+            WriteSnapshot(*writing_snapshot_);
+        } else {
+            RemoveFile();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writing_ = false;
+        }
+        idle_.notify_all();
+    }
+}
+
+bool SnapshotWriter::WriteSnapshot(const GameSnapshot& snapshot) {
+    auto start = std::chrono::steady_clock::now();
+    GameSnapshotFile::Encode(snapshot, encoded_);
+    bool ok = AtomicFile::WriteFile(path_, encoded_.data(), encoded_.size());
+    if (!ok) {
+        ++failed_count_;
+        std::cerr << "Warning: could not save the game to " << path_ << std::endl;
+        return false;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    total_write_time_ns_ += static_cast<uint64_t>(elapsed.count());
+    last_size_ = encoded_.size();
+    ++written_count_;
+    return true;
+}
+
+void SnapshotWriter::RemoveFile() {
+    if (std::remove(path_.c_str()) != 0 && errno != ENOENT) {
+        std::cerr << "Warning: could not remove saved game " << path_ << std::endl;
+    }
+}
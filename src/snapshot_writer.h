@@ -0,0 +1,81 @@
+#ifndef SNAPSHOT_WRITER_H
+#define SNAPSHOT_WRITER_H
+
+#include "game_snapshot.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Saves game snapshots on a background thread, so autosaving costs the
+// game thread one capture and a pointer swap. Snapshots are triple-buffered:
+// Submit swaps the caller's snapshot into the pending slot and the writer
+// swaps the pending slot with the one it encodes from, so after the first
+// few saves no snapshot allocates. Only the newest state matters, so a
+// snapshot still pending when another arrives is replaced, never queued.
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::string path);
+    ~SnapshotWriter();
+
+    // Rule of Five - owns a worker thread, neither copyable nor movable
+    SnapshotWriter(const SnapshotWriter& other) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter& other) = delete;
+    SnapshotWriter(SnapshotWriter&& other) = delete;
+    SnapshotWriter& operator=(SnapshotWriter&& other) = delete;
+
+    void Start();
+    void Stop(); // Writes (or deletes) whatever is pending, then joins the thread
+
+    // Never waits for the disk. `snapshot` comes back holding an older
+    // buffer (never null) for the caller to capture into next time.
+    void Submit(std::unique_ptr<GameSnapshot>& snapshot);
+
+    // Deletes the save file once any write in progress lands (the run ended)
+    void Discard();
+
+    // Waits until everything submitted so far is on disk
+    void Flush();
+
+    const std::string& GetPath() const { return path_; }
+
+    // Statistics
+    uint64_t GetWrittenCount() const { return written_count_; }
+    uint64_t GetReplacedCount() const { return replaced_count_; } // Superseded before being written
+    uint64_t GetFailedCount() const { return failed_count_; }
+    std::size_t GetLastSize() const { return last_size_; }          // Bytes
+    std::chrono::nanoseconds GetAverageWriteTime() const;           // Encode, fsync and rename
+
+private:
+    enum class Pending { kNone, kWrite, kDiscard };
+
+    const std::string path_;
+    std::unique_ptr<GameSnapshot> pending_snapshot_;
+    std::unique_ptr<GameSnapshot> writing_snapshot_;
+    std::vector<uint8_t> encoded_; // Reused by the writer thread
+    Pending pending_{Pending::kNone};
+    bool writing_{false};
+    bool stop_requested_{false};
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable idle_;
+
+    std::thread worker_;
+
+    std::atomic<uint64_t> written_count_{0};
+    std::atomic<uint64_t> replaced_count_{0};
+    std::atomic<uint64_t> failed_count_{0};
+    std::atomic<std::size_t> last_size_{0};
+    std::atomic<uint64_t> total_write_time_ns_{0};
+
+    void WriterThread();
+    bool WriteSnapshot(const GameSnapshot& snapshot);
+    void RemoveFile();
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "SDL.h"
+#include <algorithm>
+#include <vector>
+
+// Uniform bucket grid for cell-positioned items. Each bucket covers
+// bucket_size x bucket_size cells, so rectangle queries only touch the
+// buckets overlapping the rectangle instead of every item.
+template<typename T>
+class SpatialGrid {
+public:
+    SpatialGrid(int grid_width, int grid_height, int bucket_size = 8);
+
+    void Insert(const T& item, int x, int y);
+    void Remove(const T& item, int x, int y);
+    void Move(const T& item, int old_x, int old_y, int new_x, int new_y);
+    void Clear();
+
+    // Visits every item in buckets overlapping `cells`; items may lie just
+    // outside the rectangle, so callers filter on exact position.
+    template<typename Visitor>
+    void Query(const SDL_Rect& cells, Visitor&& visitor) const;
+
+    // Early-exit search of the bucket containing (x, y)
+    template<typename Predicate>
+    bool AnyInBucket(int x, int y, Predicate&& predicate) const;
+
+private:
+    int bucket_size;
+    int buckets_x;
+    int buckets_y;
+    std::vector<std::vector<T>> buckets;
+
+    int BucketIndex(int x, int y) const;
+};
+
+// Template implementations
+template<typename T>
+SpatialGrid<T>::SpatialGrid(int grid_width, int grid_height, int bucket_size)
+    : bucket_size(bucket_size),
+      buckets_x((grid_width + bucket_size - 1) / bucket_size),
+      buckets_y((grid_height + bucket_size - 1) / bucket_size),
+      buckets(static_cast<std::size_t>(buckets_x) * buckets_y) {
+}
+
+template<typename T>
+void SpatialGrid<T>::Insert(const T& item, int x, int y) {
+    buckets[BucketIndex(x, y)].push_back(item);
+}
+
+template<typename T>
+void SpatialGrid<T>::Remove(const T& item, int x, int y) {
+    auto& bucket = buckets[BucketIndex(x, y)];
+    auto it = std::find(bucket.begin(), bucket.end(), item);
+    if (it != bucket.end()) {
+        // Order within a bucket is irrelevant, so swap-and-pop
+        *it = bucket.back();
+        bucket.pop_back();
+    }
+}
+
+template<typename T>
+void SpatialGrid<T>::Move(const T& item, int old_x, int old_y, int new_x, int new_y) {
+    if (BucketIndex(old_x, old_y) != BucketIndex(new_x, new_y)) {
+        Remove(item, old_x, old_y);
+        Insert(item, new_x, new_y);
+    }
+}
+
+template<typename T>
+void SpatialGrid<T>::Clear() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+}
+
+template<typename T>
+template<typename Visitor>
+void SpatialGrid<T>::Query(const SDL_Rect& cells, Visitor&& visitor) const {
+    if (cells.w <= 0 || cells.h <= 0) {
+        return;
+    }
+
+    int bx0 = std::max(0, cells.x / bucket_size);
+    int by0 = std::max(0, cells.y / bucket_size);
+    int bx1 = std::min(buckets_x - 1, (cells.x + cells.w - 1) / bucket_size);
+    int by1 = std::min(buckets_y - 1, (cells.y + cells.h - 1) / bucket_size);
+
+    for (int by = by0; by <= by1; ++by) {
+        for (int bx = bx0; bx <= bx1; ++bx) {
+            for (const auto& item : buckets[by * buckets_x + bx]) {
+                visitor(item);
+            }
+        }
+    }
+}
+
+template<typename T>
+template<typename Predicate>
+bool SpatialGrid<T>::AnyInBucket(int x, int y, Predicate&& predicate) const {
+    const auto& bucket = buckets[BucketIndex(x, y)];
+    return std::any_of(bucket.begin(), bucket.end(), predicate);
+}
+
+template<typename T>
+int SpatialGrid<T>::BucketIndex(int x, int y) const {
+    int bx = std::clamp(x / bucket_size, 0, buckets_x - 1);
+    int by = std::clamp(y / bucket_size, 0, buckets_y - 1);
+    return by * buckets_x + bx;
+}
+
+#endif
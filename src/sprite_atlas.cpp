@@ -0,0 +1,295 @@
+#include "sprite_atlas.h"
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// Software drawing into one sprite slot of the RGBA32 atlas buffer
+class SpriteCanvas {
+public:
+    SpriteCanvas(std::vector<uint8_t>& pixels, int atlas_width, int origin_x, int size)
+        : pixels(pixels), atlas_width(atlas_width), origin_x(origin_x), size(size) {}
+
+    void SetColor(const SDL_Color& color) { this->color = color; }
+
+    void DrawPoint(int x, int y) {
+        if (x < 0 || y < 0 || x >= size || y >= size) {
+            return;
+        }
+        std::size_t offset = (static_cast<std::size_t>(y) * atlas_width + origin_x + x) * 4;
+        pixels[offset] = color.r;
+        pixels[offset + 1] = color.g;
+        pixels[offset + 2] = color.b;
+        pixels[offset + 3] = color.a;
+    }
+
+    void FillRect(int x, int y, int w, int h) {
+        for (int py = y; py < y + h; ++py) {
+            for (int px = x; px < x + w; ++px) {
+                DrawPoint(px, py);
+            }
+        }
+    }
+
+    void DrawLine(int x0, int y0, int x1, int y1) {
+        // Bresenham
+        int dx = std::abs(x1 - x0);
+        int dy = -std::abs(y1 - y0);
+        int sx = x0 < x1 ? 1 : -1;
+        int sy = y0 < y1 ? 1 : -1;
+        int error = dx + dy;
+        while (true) {
+            DrawPoint(x0, y0);
+            if (x0 == x1 && y0 == y1) {
+                break;
+            }
+            int doubled = 2 * error;
+            if (doubled >= dy) {
+                error += dy;
+                x0 += sx;
+            }
+            if (doubled <= dx) {
+                error += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    void DrawThickLine(int x0, int y0, int x1, int y1) {
+        DrawLine(x0, y0, x1, y1);
+        DrawLine(x0 + 1, y0, x1 + 1, y1);
+        DrawLine(x0, y0 + 1, x1, y1 + 1);
+    }
+
+    void DrawBorder(int thickness) {
+        FillRect(0, 0, size, thickness);
+        FillRect(0, size - thickness, size, thickness);
+        FillRect(0, 0, thickness, size);
+        FillRect(size - thickness, 0, thickness, size);
+    }
+
+    int Size() const { return size; }
+
+private:
+    std::vector<uint8_t>& pixels;
+    const int atlas_width;
+    const int origin_x;
+    const int size;
+    SDL_Color color{255, 255, 255, 255};
+};
+
+// Palette matches the colours previously drawn with SDL_RenderFillRect
+constexpr SDL_Color kSnakeHeadColor{0x00, 0x7A, 0xCC, 0xFF};
+constexpr SDL_Color kSnakeDeadColor{0xFF, 0x00, 0x00, 0xFF};
+constexpr SDL_Color kSnakeBodyColor{0xFF, 0xFF, 0xFF, 0xFF};
+constexpr SDL_Color kSnakeBodyEdgeColor{0xC8, 0xC8, 0xC8, 0xFF};
+constexpr SDL_Color kFoodColor{0xFF, 0xCC, 0x00, 0xFF};
+constexpr SDL_Color kFixedObstacleColor{128, 64, 0, 255};
+constexpr SDL_Color kFixedObstacleMortarColor{96, 48, 0, 255};
+constexpr SDL_Color kMovingObstacleColor{255, 165, 0, 255};
+constexpr SDL_Color kMovingObstacleAccentColor{255, 200, 100, 255};
+constexpr SDL_Color kEyeColor{0xFF, 0xFF, 0xFF, 0xFF};
+
+void DrawPatternAccent(SpriteCanvas& canvas, MovementPattern pattern) {
+    const int s = canvas.Size();
+    canvas.SetColor(kMovingObstacleAccentColor);
+
+    switch (pattern) {
+    case MovementPattern::LINEAR_HORIZONTAL:
+        canvas.DrawThickLine(3, s / 2, s - 4, s / 2);
+        canvas.DrawThickLine(s - 10, s / 2 - 5, s - 4, s / 2);
+        canvas.DrawThickLine(s - 10, s / 2 + 5, s - 4, s / 2);
+        break;
+
+    case MovementPattern::LINEAR_VERTICAL:
+        canvas.DrawThickLine(s / 2, 3, s / 2, s - 4);
+        canvas.DrawThickLine(s / 2 - 5, s - 10, s / 2, s - 4);
+        canvas.DrawThickLine(s / 2 + 5, s - 10, s / 2, s - 4);
+        break;
+
+    case MovementPattern::CIRCULAR:
+        for (int i = 0; i < 12; ++i) {
+            float angle = (2.0f * static_cast<float>(M_PI) * i) / 12.0f;
+            int px = s / 2 + static_cast<int>((s / 3) * std::cos(angle));
+            int py = s / 2 + static_cast<int>((s / 3) * std::sin(angle));
+            canvas.FillRect(px - 1, py - 1, 2, 2);
+        }
+        canvas.FillRect(s / 2 - 1, s / 2 - 1, 3, 3);
+        break;
+
+    case MovementPattern::ZIGZAG:
+        canvas.DrawThickLine(3, s / 3, s / 2, 2 * s / 3);
+        canvas.DrawThickLine(s / 2, 2 * s / 3, s - 4, s / 3);
+        canvas.DrawThickLine(s / 4, s / 6, 3 * s / 4, 5 * s / 6);
+        break;
+
+    case MovementPattern::RANDOM_WALK:
+        canvas.FillRect(s / 4 - 1, s / 4 - 1, 3, 3);
+        canvas.FillRect(3 * s / 4 - 1, s / 4 - 1, 3, 3);
+        canvas.FillRect(s / 4 - 1, 3 * s / 4 - 1, 3, 3);
+        canvas.FillRect(3 * s / 4 - 1, 3 * s / 4 - 1, 3, 3);
+        canvas.DrawThickLine(s / 2 - 3, s / 2, s / 2 + 3, s / 2);
+        canvas.DrawThickLine(s / 2, s / 2 - 3, s / 2, s / 2 + 3);
+        break;
+
+    case MovementPattern::FLOCKING:
+        for (int i = 0; i < 3; ++i) {
+            int cx = (i + 1) * s / 4;
+            int cy = i == 1 ? s / 3 : 2 * s / 3;
+            canvas.DrawThickLine(cx - 4, cy + 4, cx, cy);
+            canvas.DrawThickLine(cx, cy, cx + 4, cy + 4);
+        }
+        break;
+
+    case MovementPattern::NOISE_DRIFT:
+        for (int row = 1; row <= 2; ++row) {
+            int wave_y = row * s / 3;
+            canvas.DrawThickLine(3, wave_y, s / 3, wave_y - 4);
+            canvas.DrawThickLine(s / 3, wave_y - 4, 2 * s / 3, wave_y + 4);
+            canvas.DrawThickLine(2 * s / 3, wave_y + 4, s - 4, wave_y);
+        }
+        break;
+    }
+}
+
+} // namespace
+
+SpriteAtlas::SpriteAtlas(SDL_Renderer* renderer) : renderer(renderer) {
+    BuildTexture();
+}
+
+SpriteId SpriteAtlas::GetMovingObstacleSprite(MovementPattern pattern) {
+    return static_cast<SpriteId>(static_cast<int>(SpriteId::MOVING_OBSTACLE_FIRST) +
+                                 static_cast<int>(pattern));
+}
+
+void SpriteAtlas::Begin() {
+    vertices.clear();
+    indices.clear();
+    copy_destinations.clear();
+    copy_sprites.clear();
+}
+
+void SpriteAtlas::Queue(SpriteId sprite, const SDL_Rect& destination) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const SDL_Rect source = GetSourceRect(sprite);
+    const float u0 = static_cast<float>(source.x) / kAtlasWidth;
+    const float v0 = static_cast<float>(source.y) / kAtlasHeight;
+    const float u1 = static_cast<float>(source.x + source.w) / kAtlasWidth;
+    const float v1 = static_cast<float>(source.y + source.h) / kAtlasHeight;
+    const float x0 = static_cast<float>(destination.x);
+    const float y0 = static_cast<float>(destination.y);
+    const float x1 = static_cast<float>(destination.x + destination.w);
+    const float y1 = static_cast<float>(destination.y + destination.h);
+    const SDL_Color white{255, 255, 255, 255};
+
+    const int base = static_cast<int>(vertices.size());
+    vertices.push_back({{x0, y0}, white, {u0, v0}});
+    vertices.push_back({{x1, y0}, white, {u1, v0}});
+    vertices.push_back({{x1, y1}, white, {u1, v1}});
+    vertices.push_back({{x0, y1}, white, {u0, v1}});
+
+    const int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+    indices.insert(indices.end(), quad, quad + 6);
+#else
+    copy_sprites.push_back(sprite);
+    copy_destinations.push_back(destination);
+#endif
+}
+
+void SpriteAtlas::Flush() {
+    if (!texture) {
+        return;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    last_batch_size = vertices.size() / 4;
+    if (!indices.empty()) {
+        SDL_RenderGeometry(renderer, texture.get(), vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+#else
+    // Older SDL: still one texture bind, but one copy per sprite
+    last_batch_size = copy_sprites.size();
+    for (std::size_t i = 0; i < copy_sprites.size(); ++i) {
+        SDL_Rect source = GetSourceRect(copy_sprites[i]);
+        SDL_RenderCopy(renderer, texture.get(), &source, &copy_destinations[i]);
+    }
+#endif
+    Begin();
+}
+
+void SpriteAtlas::BuildTexture() {
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(kAtlasWidth) * kAtlasHeight * 4, 0);
+    for (int i = 0; i < kSpriteCount; ++i) {
+        DrawSprite(pixels, static_cast<SpriteId>(i), i * (kSpriteSize + kSpritePadding));
+    }
+
+    texture.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                    kAtlasWidth, kAtlasHeight));
+    if (!texture) {
+        std::cerr << "Could not create sprite atlas, falling back to solid cells.\n";
+        std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
+        return;
+    }
+
+    if (SDL_UpdateTexture(texture.get(), nullptr, pixels.data(), kAtlasWidth * 4) != 0) {
+        std::cerr << "Could not upload sprite atlas: " << SDL_GetError() << "\n";
+        texture.reset();
+        return;
+    }
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+}
+
+void SpriteAtlas::DrawSprite(std::vector<uint8_t>& pixels, SpriteId sprite, int origin_x) {
+    SpriteCanvas canvas(pixels, kAtlasWidth, origin_x, kSpriteSize);
+    const int s = kSpriteSize;
+
+    switch (sprite) {
+    case SpriteId::SNAKE_HEAD:
+    case SpriteId::SNAKE_HEAD_DEAD:
+        canvas.SetColor(sprite == SpriteId::SNAKE_HEAD ? kSnakeHeadColor : kSnakeDeadColor);
+        canvas.FillRect(0, 0, s, s);
+        canvas.SetColor(kEyeColor);
+        canvas.FillRect(s / 4 - 2, s / 4, 5, 5);
+        canvas.FillRect(3 * s / 4 - 3, s / 4, 5, 5);
+        break;
+
+    case SpriteId::SNAKE_BODY:
+        canvas.SetColor(kSnakeBodyColor);
+        canvas.FillRect(0, 0, s, s);
+        canvas.SetColor(kSnakeBodyEdgeColor);
+        canvas.DrawBorder(1);
+        break;
+
+    case SpriteId::FOOD:
+        // Square with clipped corners so food reads differently from walls
+        canvas.SetColor(kFoodColor);
+        canvas.FillRect(3, 0, s - 6, s);
+        canvas.FillRect(0, 3, s, s - 6);
+        canvas.FillRect(1, 1, s - 2, s - 2);
+        break;
+
+    case SpriteId::FIXED_OBSTACLE:
+        canvas.SetColor(kFixedObstacleColor);
+        canvas.FillRect(0, 0, s, s);
+        canvas.SetColor(kFixedObstacleMortarColor);
+        canvas.FillRect(0, s / 2 - 1, s, 2);
+        canvas.FillRect(s / 2 - 1, 0, 2, s / 2);
+        canvas.FillRect(s / 4 - 1, s / 2, 2, s / 2);
+        canvas.FillRect(3 * s / 4 - 1, s / 2, 2, s / 2);
+        break;
+
+    default: {
+        int pattern = static_cast<int>(sprite) - static_cast<int>(SpriteId::MOVING_OBSTACLE_FIRST);
+        canvas.SetColor(kMovingObstacleColor);
+        canvas.FillRect(0, 0, s, s);
+        DrawPatternAccent(canvas, static_cast<MovementPattern>(pattern));
+        break;
+    }
+    }
+}
+
+SDL_Rect SpriteAtlas::GetSourceRect(SpriteId sprite) const {
+    return {static_cast<int>(sprite) * (kSpriteSize + kSpritePadding), 0, kSpriteSize, kSpriteSize};
+}
@@ -0,0 +1,73 @@
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include "SDL.h"
+#include "moving_obstacle.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum class SpriteId {
+    SNAKE_HEAD,
+    SNAKE_HEAD_DEAD,
+    SNAKE_BODY,
+    FOOD,
+    FIXED_OBSTACLE,
+    MOVING_OBSTACLE_FIRST // One sprite per MovementPattern follows
+};
+
+// Custom deleter for SDL textures
+struct SDLTextureDeleter {
+    void operator()(SDL_Texture* texture) const {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+        }
+    }
+};
+
+using SDLTexturePtr = std::unique_ptr<SDL_Texture, SDLTextureDeleter>;
+
+// All playfield sprites generated into one texture at startup. Sprites are
+// queued as quads and submitted with a single geometry call per frame.
+class SpriteAtlas {
+public:
+    explicit SpriteAtlas(SDL_Renderer* renderer);
+
+    SpriteAtlas(const SpriteAtlas& other) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas& other) = delete;
+
+    bool IsReady() const { return texture != nullptr; }
+
+    static SpriteId GetMovingObstacleSprite(MovementPattern pattern);
+
+    // Batching: Begin, Queue any number of sprites, then Flush
+    void Begin();
+    void Queue(SpriteId sprite, const SDL_Rect& destination);
+    void Flush();
+
+    std::size_t GetLastBatchSize() const { return last_batch_size; }
+
+private:
+    SDL_Renderer* renderer;
+    SDLTexturePtr texture;
+
+    // Reused across frames so steady-state drawing does not allocate
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::vector<SDL_Rect> copy_destinations;
+    std::vector<SpriteId> copy_sprites;
+    std::size_t last_batch_size{0};
+
+    static constexpr int kSpriteSize = 32;
+    static constexpr int kSpritePadding = 2;
+    static constexpr int kSpriteCount =
+        static_cast<int>(SpriteId::MOVING_OBSTACLE_FIRST) + kMovementPatternCount;
+    static constexpr int kAtlasWidth = kSpriteCount * (kSpriteSize + kSpritePadding);
+    static constexpr int kAtlasHeight = kSpriteSize;
+
+    void BuildTexture();
+    static void DrawSprite(std::vector<uint8_t>& pixels, SpriteId sprite, int origin_x);
+    SDL_Rect GetSourceRect(SpriteId sprite) const;
+};
+
+#endif
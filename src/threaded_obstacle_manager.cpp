@@ -66,6 +66,28 @@ bool ThreadedObstacleManager::IsValidFoodPosition(int x, int y) const {
     return result;
 }
 
+void ThreadedObstacleManager::QueryObstaclesInRect(const SDL_Rect& cells,
+                                                   std::vector<const Obstacle*>& out) const {
+    std::shared_lock<std::shared_mutex> lock(obstacles_mutex);
+    ObstacleManager::QueryObstaclesInRect(cells, out);
+}
+
+void ThreadedObstacleManager::ForEachObstacleInRect(const SDL_Rect& cells,
+                                                    const std::function<void(const Obstacle&)>& visit) const {
+    std::shared_lock<std::shared_mutex> lock(obstacles_mutex);
+    ObstacleManager::ForEachObstacleInRect(cells, visit);
+}
+
+void ThreadedObstacleManager::CaptureObstacles(std::vector<ObstacleState>& out) const {
+    std::shared_lock<std::shared_mutex> lock(obstacles_mutex);
+    ObstacleManager::CaptureObstacles(out);
+}
+
+void ThreadedObstacleManager::RestoreObstacles(const std::vector<ObstacleState>& states) {
+    std::unique_lock<std::shared_mutex> lock(obstacles_mutex);
+    ObstacleManager::RestoreObstacles(states);
+}
+
 std::size_t ThreadedObstacleManager::GetObstacleCountSafe() const {
     std::shared_lock<std::shared_mutex> lock(obstacles_mutex);
     return ObstacleManager::GetObstacleCount();
@@ -133,23 +155,14 @@ void ThreadedObstacleManager::NotifyLifetimeThread() {
 }
 
 void ThreadedObstacleManager::SafelyUpdateMovingObstacles() {
-    std::shared_lock<std::shared_mutex> lock(obstacles_mutex);
-    for (auto& obstacle : obstacles) {
-        if (obstacle->GetType() == ObstacleType::MOVING) {
-            obstacle->Update();
-        }
-    }
+    // Exclusive: movement rewrites positions and the spatial index
+    std::unique_lock<std::shared_mutex> lock(obstacles_mutex);
+    MoveObstacles();
 }
 
 void ThreadedObstacleManager::SafelyCleanupExpired() {
     // This method assumes the caller already holds a unique lock
-    obstacles.erase(
-        std::remove_if(obstacles.begin(), obstacles.end(),
-                      [](const std::unique_ptr<Obstacle>& obstacle) {
-                          return obstacle->IsExpired();
-                      }),
-        obstacles.end()
-    );
+    EraseExpiredObstacles();
 }
 
 const PerformanceMonitor& ThreadedObstacleManager::GetPerformanceMonitor() const {
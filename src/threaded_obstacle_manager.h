@@ -24,6 +24,12 @@ public:
     bool CheckCollisionWithPoint(int x, int y) const override;
     bool CheckCollisionWithSnake(const Snake& snake) const override;
     bool IsValidFoodPosition(int x, int y) const override;
+    void QueryObstaclesInRect(const SDL_Rect& cells,
+                              std::vector<const Obstacle*>& out) const override;
+    void ForEachObstacleInRect(const SDL_Rect& cells,
+                               const std::function<void(const Obstacle&)>& visit) const override;
+    void CaptureObstacles(std::vector<ObstacleState>& out) const override;
+    void RestoreObstacles(const std::vector<ObstacleState>& states) override;
 
     // Thread-safe getters
     std::size_t GetObstacleCountSafe() const;
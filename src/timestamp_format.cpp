@@ -0,0 +1,154 @@
+#include "timestamp_format.h"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+
+namespace {
+    constexpr int64_t kSecondsPerHour = 3600;
+    constexpr int64_t kSecondsPerDay = 86400;
+    const char* const kMonthNames[12] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+    };
+
+    struct CivilTime {
+        int year;
+        int month;  // 1-12
+        int day;    // 1-31
+        int hour;
+        int minute;
+        int second;
+    };
+
+    // Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant)
+    int64_t DaysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const int64_t year_of_era = year - era * 400;
+        const int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        return era * 146097 + day_of_era - 719468;
+    }
+
+    void CivilFromDays(int64_t days, int& year, int& month, int& day) {
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const int64_t day_of_era = days - era * 146097;
+        const int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+        const int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+        const int64_t month_index = (5 * day_of_year + 2) / 153;
+        day = static_cast<int>(day_of_year - (153 * month_index + 2) / 5 + 1);
+        month = static_cast<int>(month_index < 10 ? month_index + 3 : month_index - 9);
+        year = static_cast<int>(year_of_era + era * 400 + (month <= 2));
+    }
+
+    // UTC offset of local time at the given instant, cached per hour
+    int64_t LocalOffset(int64_t timestamp) {
+        thread_local int64_t cached_hour = INT64_MIN;
+        thread_local int64_t cached_offset = 0;
+
+        int64_t hour = timestamp >= 0 ? timestamp / kSecondsPerHour : (timestamp + 1) / kSecondsPerHour - 1;
+        if (hour != cached_hour) {
+            std::time_t instant = static_cast<std::time_t>(hour * kSecondsPerHour);
+            std::tm local{};
+            localtime_r(&instant, &local);
+            cached_offset = local.tm_gmtoff;
+            cached_hour = hour;
+        }
+        return cached_offset;
+    }
+
+    CivilTime ToLocal(int64_t timestamp) {
+        int64_t local = timestamp + LocalOffset(timestamp);
+        int64_t days = local >= 0 ? local / kSecondsPerDay : (local + 1) / kSecondsPerDay - 1;
+        int64_t seconds_of_day = local - days * kSecondsPerDay;
+
+        CivilTime civil{};
+        CivilFromDays(days, civil.year, civil.month, civil.day);
+        civil.hour = static_cast<int>(seconds_of_day / kSecondsPerHour);
+        civil.minute = static_cast<int>(seconds_of_day / 60 % 60);
+        civil.second = static_cast<int>(seconds_of_day % 60);
+        return civil;
+    }
+
+    // Fixed-width unsigned field; cheaper than from_chars for 2-4 digits
+    bool ParseField(std::string_view text, std::size_t offset, std::size_t length, int& value) {
+        value = 0;
+        for (std::size_t i = offset; i < offset + length; ++i) {
+            unsigned digit = static_cast<unsigned>(text[i] - '0');
+            if (digit > 9) {
+                return false;
+            }
+            value = value * 10 + static_cast<int>(digit);
+        }
+        return true;
+    }
+
+    void WriteDigits(char* out, int value, int digits) {
+        for (int i = digits - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+}
+
+namespace TimestampFormat {
+
+int64_t Now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool ParseText(std::string_view text, int64_t& timestamp) {
+    if (text.size() != kTextLength || text[4] != '-' || text[7] != '-' ||
+        (text[10] != '_' && text[10] != ' ') || text[13] != ':' || text[16] != ':') {
+        return false;
+    }
+
+    CivilTime civil{};
+    if (!ParseField(text, 0, 4, civil.year) || !ParseField(text, 5, 2, civil.month) ||
+        !ParseField(text, 8, 2, civil.day) || !ParseField(text, 11, 2, civil.hour) ||
+        !ParseField(text, 14, 2, civil.minute) || !ParseField(text, 17, 2, civil.second)) {
+        return false;
+    }
+    if (civil.month < 1 || civil.month > 12 || civil.day < 1 || civil.day > 31 ||
+        civil.hour > 23 || civil.minute > 59 || civil.second > 60) {
+        return false;
+    }
+
+    // Treat the fields as UTC, then correct by the local offset at (about)
+    // that instant; the second lookup settles the guess near DST changes
+    int64_t as_utc = DaysFromCivil(civil.year, civil.month, civil.day) * kSecondsPerDay +
+                     civil.hour * kSecondsPerHour + civil.minute * 60 + civil.second;
+    int64_t guess = as_utc - LocalOffset(as_utc);
+    timestamp = as_utc - LocalOffset(guess);
+    return true;
+}
+
+void FormatText(int64_t timestamp, char* out) {
+    CivilTime civil = ToLocal(timestamp);
+    WriteDigits(out, civil.year, 4);
+    out[4] = '-';
+    WriteDigits(out + 5, civil.month, 2);
+    out[7] = '-';
+    WriteDigits(out + 8, civil.day, 2);
+    out[10] = '_';
+    WriteDigits(out + 11, civil.hour, 2);
+    out[13] = ':';
+    WriteDigits(out + 14, civil.minute, 2);
+    out[16] = ':';
+    WriteDigits(out + 17, civil.second, 2);
+}
+
+std::string FormatDisplay(int64_t timestamp) {
+    if (timestamp == 0) {
+        return "Unknown";
+    }
+    CivilTime civil = ToLocal(timestamp);
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%s %02d, %04d %02d:%02d",
+                  kMonthNames[civil.month - 1], civil.day, civil.year, civil.hour, civil.minute);
+    return buffer;
+}
+
+}
@@ -0,0 +1,26 @@
+#ifndef TIMESTAMP_FORMAT_H
+#define TIMESTAMP_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Conversions between epoch-second score timestamps and their text forms,
+// in local time. Local offsets are looked up once per hour of input and
+// cached, so converting millions of timestamps does not call mktime or
+// localtime per value.
+namespace TimestampFormat {
+    constexpr std::size_t kTextLength = 19; // "YYYY-MM-DD_HH:MM:SS"
+
+    int64_t Now();
+
+    // Text form used by the score files: "2025-09-28_02:12:53"
+    bool ParseText(std::string_view text, int64_t& timestamp);
+    void FormatText(int64_t timestamp, char* out); // Writes kTextLength chars
+
+    // Display form: "Sep 28, 2025 02:12", or "Unknown" for 0
+    std::string FormatDisplay(int64_t timestamp);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "vector_env.h"
+#include "noise_field.h"
+#include <algorithm>
+
+namespace {
+  constexpr Snake::Direction kDirections[] = {Snake::Direction::kUp, Snake::Direction::kRight,
+                                              Snake::Direction::kDown, Snake::Direction::kLeft};
+  constexpr int kDirectionDx[] = {0, 1, 0, -1};
+  constexpr int kDirectionDy[] = {-1, 0, 1, 0};
+
+  int WrappedDelta(int from, int to, int size) {
+    int delta = to - from;
+    if (delta > size / 2) delta -= size;
+    if (delta < -size / 2) delta += size;
+    return delta;
+  }
+}
+
+VectorEnv::VectorEnv(const Options &options) : options(options) {
+  this->options.envCount = std::max<std::size_t>(this->options.envCount, 1);
+  this->options.frameSkip = std::max(this->options.frameSkip, 1);
+  this->options.maxEpisodeSteps = std::max<uint32_t>(this->options.maxEpisodeSteps, 1);
+
+  const std::size_t count = this->options.envCount;
+  auto noise_field = std::make_shared<const NoiseField>(this->options.noiseSeed);
+  games.reserve(count);
+  for (std::size_t env = 0; env < count; ++env) {
+    games.push_back(std::make_unique<Simulation>(this->options.board, static_cast<uint32_t>(env), noise_field));
+  }
+  observations.assign(count * kObservationSize, 0.0f);
+  rewards.assign(count, 0.0f);
+  dones.assign(count, 0);
+  truncated.assign(count, 0);
+  episode_steps.assign(count, 0);
+  episode_seed.assign(count, 0);
+  last_episode_score.assign(count, 0);
+  last_episode_steps.assign(count, 0);
+  Reset(0);
+}
+
+void VectorEnv::Reset(uint32_t seed) {
+  for (std::size_t env = 0; env < options.envCount; ++env) {
+    ResetGame(env, seed + static_cast<uint32_t>(env));
+    rewards[env] = 0.0f;
+    dones[env] = 0;
+    truncated[env] = 0;
+  }
+  finished_episodes = 0;
+}
+
+void VectorEnv::ResetGame(std::size_t env, uint32_t seed) {
+  games[env]->Reset(seed);
+  episode_seed[env] = seed;
+  episode_steps[env] = 0;
+  Observe(env);
+}
+
+void VectorEnv::Step(const int32_t *actions) {
+  for (std::size_t env = 0; env < options.envCount; ++env) {
+    Simulation &game = *games[env];
+    Snake &snake = game.GetSnake();
+    int32_t action = actions[env];
+    if (action >= 0 && action < kActionCount && !snake.IsReverse(kDirections[action])) {
+      snake.direction = kDirections[action];
+    }
+
+    int score_before = game.GetScore();
+    for (int tick = 0; tick < options.frameSkip && !game.IsOver(); ++tick) {
+      game.Step();
+    }
+    ++episode_steps[env];
+
+    float reward = static_cast<float>(game.GetScore() - score_before);
+    bool over = game.IsOver();
+    bool out_of_time = !over && episode_steps[env] >= options.maxEpisodeSteps;
+    if (over) {
+      reward -= 1.0f;
+    }
+    rewards[env] = reward;
+    dones[env] = over || out_of_time;
+    truncated[env] = out_of_time;
+
+    if (dones[env]) {
+      last_episode_score[env] = game.GetScore();
+      last_episode_steps[env] = episode_steps[env];
+      ++finished_episodes;
+      // Seeds of one game step by the game count, so no two games share one
+      ResetGame(env, episode_seed[env] + static_cast<uint32_t>(options.envCount));
+    } else {
+      Observe(env);
+    }
+  }
+}
+
+void VectorEnv::Observe(std::size_t env) {
+  const Simulation &game = *games[env];
+  const Snake &snake = game.GetSnake();
+  const ObstacleManager &obstacles = game.GetObstacles();
+  const int width = static_cast<int>(options.board.gridWidth);
+  const int height = static_cast<int>(options.board.gridHeight);
+  const int head_x = static_cast<int>(snake.head_x);
+  const int head_y = static_cast<int>(snake.head_y);
+  float *row = &observations[env * kObservationSize];
+
+  for (int i = 0; i < 4; ++i) {
+    int x = (head_x + kDirectionDx[i] + width) % width; // The board wraps
+    int y = (head_y + kDirectionDy[i] + height) % height;
+    row[i] = snake.BodyCell(x, y) || obstacles.CheckCollisionWithPoint(x, y) ? 1.0f : 0.0f;
+    row[4 + i] = snake.direction == kDirections[i] ? 1.0f : 0.0f;
+  }
+  const SDL_Point &food = game.GetFood();
+  row[8] = WrappedDelta(head_x, food.x, width) / (width * 0.5f);
+  row[9] = WrappedDelta(head_y, food.y, height) / (height * 0.5f);
+  row[10] = static_cast<float>(snake.size) / (static_cast<float>(width) * height);
+  row[11] = static_cast<float>(episode_steps[env]) / options.maxEpisodeSteps;
+}
@@ -0,0 +1,88 @@
+#ifndef VECTOR_ENV_H
+#define VECTOR_ENV_H
+
+#include "board_config.h"
+#include "simulation.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Training environment: a batch of independent games (Simulation) stepped
+// in lockstep, one action per game per step.
+//
+// Actions are absolute directions (0 up, 1 right, 2 down, 3 left); turning
+// back into the body is ignored, as with the keyboard. Each step advances
+// every game by frameSkip ticks and fills, per game:
+//   observation  kObservationSize floats, see below
+//   reward       +1 per food eaten, -1 on death
+//   done         the episode ended (death or maxEpisodeSteps); the game
+//                has already been reset and its observation is the first
+//                one of the next episode
+//   truncated    the episode ended at maxEpisodeSteps rather than death
+// All results live in contiguous buffers allocated by the constructor and
+// overwritten by each Step, so stepping itself allocates nothing (the
+// games allocate only when an obstacle spawns). The NOISE_DRIFT flow
+// field is built once, on every core, and shared. SDL supplies types only.
+class VectorEnv {
+public:
+  // Observation layout, one row per game:
+  //   0-3   danger one cell up / right / down / left (body or obstacle)
+  //   4-7   current direction, one-hot in the same order
+  //   8-9   wrapped x / y offset to the food, scaled to [-1, 1]
+  //   10    snake length as a fraction of the board
+  //   11    elapsed fraction of maxEpisodeSteps
+  static constexpr std::size_t kObservationSize = 12;
+  static constexpr int kActionCount = 4;
+
+  struct Options {
+    std::size_t envCount{64};
+    BoardConfig board;
+    int frameSkip{1};                // Ticks per step
+    uint32_t maxEpisodeSteps{18000}; // Truncation limit
+    uint32_t noiseSeed{1};           // Flow field every game's drifters share
+  };
+
+  explicit VectorEnv(const Options &options);
+
+  // Starts a new episode in every game; game i gets seed + i, and its later
+  // episodes continue from there, so a run is reproducible from `seed`
+  void Reset(uint32_t seed);
+
+  // `actions` holds GetEnvCount() entries
+  void Step(const int32_t *actions);
+  void Step(const std::vector<int32_t> &actions) { Step(actions.data()); }
+
+  std::size_t GetEnvCount() const { return options.envCount; }
+  const Options &GetOptions() const { return options; }
+  const Simulation &GetGame(std::size_t env) const { return *games[env]; } // E.g. for BitplaneEncoder
+
+  const float *GetObservations() const { return observations.data(); }
+  const float *GetRewards() const { return rewards.data(); }
+  const uint8_t *GetDones() const { return dones.data(); }
+  const uint8_t *GetTruncated() const { return truncated.data(); }
+
+  // Score and length of the last finished episode of game i
+  int GetLastEpisodeScore(std::size_t env) const { return last_episode_score[env]; }
+  uint32_t GetLastEpisodeSteps(std::size_t env) const { return last_episode_steps[env]; }
+  uint64_t GetFinishedEpisodes() const { return finished_episodes; }
+
+private:
+  Options options;
+  std::vector<std::unique_ptr<Simulation>> games;
+
+  std::vector<float> observations;
+  std::vector<float> rewards;
+  std::vector<uint8_t> dones;
+  std::vector<uint8_t> truncated;
+
+  std::vector<uint32_t> episode_steps;
+  std::vector<uint32_t> episode_seed;
+  std::vector<int> last_episode_score;
+  std::vector<uint32_t> last_episode_steps;
+  uint64_t finished_episodes{0};
+
+  void ResetGame(std::size_t env, uint32_t seed);
+  void Observe(std::size_t env);
+};
+
+#endif
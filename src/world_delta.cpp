@@ -0,0 +1,407 @@
+#include "world_delta.h"
+#include <algorithm>
+
+namespace {
+    // Longest run of head steps sent as steps; longer changes send the body
+    constexpr std::size_t kMaxSteps = 64;
+
+    enum SnakeFlags : uint8_t {
+        kAlive = 1,
+        kScore = 2,
+        kBodySteps = 4,
+        kBodyWhole = 8,
+        kDirection = 16
+    };
+
+    constexpr uint8_t kMaxDirection = 3; // Snake::Direction::kRight
+
+    // Head steps, 2 bits each: up, right, down, left (not Snake::Direction
+    // values)
+    constexpr int kStepDx[] = {0, 1, 0, -1};
+    constexpr int kStepDy[] = {-1, 0, 1, 0};
+
+    void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Reads varints and bytes; once a read runs past the end (or a varint
+    // is too long) every later read returns 0 and Ok() is false
+    class Reader {
+    public:
+        Reader(const uint8_t* data, std::size_t length) : data_(data), length_(length) {}
+
+        bool Ok() const { return ok_; }
+        bool AtEnd() const { return position_ == length_; }
+
+        uint8_t U8() {
+            if (!ok_ || position_ >= length_) {
+                ok_ = false;
+                return 0;
+            }
+            return data_[position_++];
+        }
+
+        uint64_t Varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = U8();
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return ok_ ? value : 0;
+                }
+            }
+            ok_ = false;
+            return 0;
+        }
+
+    private:
+        const uint8_t* data_;
+        std::size_t length_;
+        std::size_t position_{0};
+        bool ok_{true};
+    };
+
+    // The step (0-3) from cell `from` to the adjacent cell `to` on the
+    // wrapping board, or -1 if they are not adjacent
+    int StepBetween(uint32_t from, uint32_t to, uint32_t width, uint32_t height) {
+        int from_x = static_cast<int>(from % width), from_y = static_cast<int>(from / width);
+        for (int step = 0; step < 4; ++step) {
+            int x = (from_x + kStepDx[step] + static_cast<int>(width)) % static_cast<int>(width);
+            int y = (from_y + kStepDy[step] + static_cast<int>(height)) % static_cast<int>(height);
+            if (static_cast<uint32_t>(y) * width + static_cast<uint32_t>(x) == to) {
+                return step;
+            }
+        }
+        return -1;
+    }
+
+    uint32_t StepFrom(uint32_t from, int step, uint32_t width, uint32_t height) {
+        int x = (static_cast<int>(from % width) + kStepDx[step] + static_cast<int>(width)) % static_cast<int>(width);
+        int y = (static_cast<int>(from / width) + kStepDy[step] + static_cast<int>(height)) % static_cast<int>(height);
+        return static_cast<uint32_t>(y) * width + static_cast<uint32_t>(x);
+    }
+
+    // Finds how the body `from` became `to` by dropping `tail_drop` tail
+    // cells and stepping the head `steps` times; false if it did not
+    bool FindBodySteps(const std::vector<uint32_t>& from, const std::vector<uint32_t>& to,
+                       uint32_t width, uint32_t height, std::size_t& tail_drop, std::vector<uint8_t>& steps) {
+        const std::size_t old_size = from.size();
+        const std::size_t new_size = to.size();
+        for (std::size_t drop = 0; drop < old_size && drop <= kMaxSteps; ++drop) {
+            const std::size_t kept = old_size - drop;
+            if (kept > new_size || new_size - kept > kMaxSteps || to[0] != from[drop] ||
+                !std::equal(from.begin() + drop, from.end(), to.begin())) {
+                continue;
+            }
+            steps.clear();
+            for (std::size_t i = kept; i < new_size; ++i) {
+                int step = StepBetween(to[i - 1], to[i], width, height);
+                if (step < 0) {
+                    return false;
+                }
+                steps.push_back(static_cast<uint8_t>(step));
+            }
+            tail_drop = drop;
+            return true;
+        }
+        return false;
+    }
+
+    void EncodeSnakes(const WorldFrame& from, const WorldFrame& to, std::vector<uint8_t>& out) {
+        static const WorldFrame::SnakeState kAbsent;
+        std::vector<uint8_t> steps;
+        std::size_t changed = 0;
+        PutVarint(out, to.snakes.size());
+
+        // Changed snakes are counted as they are written; the count goes in
+        // front afterwards
+        std::vector<uint8_t> entries;
+        std::size_t next_index = 0;
+        for (std::size_t i = 0; i < to.snakes.size(); ++i) {
+            const WorldFrame::SnakeState& before = i < from.snakes.size() ? from.snakes[i] : kAbsent;
+            const WorldFrame::SnakeState& after = to.snakes[i];
+            bool body_changed = before.body != after.body;
+            if (before.alive == after.alive && before.score == after.score &&
+                before.direction == after.direction && !body_changed) {
+                continue;
+            }
+            ++changed;
+            PutVarint(entries, i - next_index);
+            next_index = i + 1;
+
+            std::size_t tail_drop = 0;
+            bool as_steps = body_changed && !before.body.empty() && !after.body.empty() &&
+                            FindBodySteps(before.body, after.body, to.width, to.height, tail_drop, steps);
+            uint8_t flags = (after.alive ? kAlive : 0) | (before.score != after.score ? kScore : 0) |
+                            (before.direction != after.direction ? kDirection : 0) |
+                            (body_changed ? (as_steps ? kBodySteps : kBodyWhole) : 0);
+            entries.push_back(flags);
+            if (flags & kScore) {
+                PutVarint(entries, static_cast<uint32_t>(after.score));
+            }
+            if (flags & kDirection) {
+                entries.push_back(after.direction);
+            }
+            if (flags & kBodySteps) {
+                PutVarint(entries, tail_drop);
+                PutVarint(entries, steps.size());
+                for (std::size_t s = 0; s < steps.size(); s += 4) {
+                    uint8_t packed = 0;
+                    for (std::size_t j = s; j < std::min(s + 4, steps.size()); ++j) {
+                        packed |= static_cast<uint8_t>(steps[j] << (2 * (j - s)));
+                    }
+                    entries.push_back(packed);
+                }
+            } else if (flags & kBodyWhole) {
+                PutVarint(entries, after.body.size());
+                for (uint32_t cell : after.body) {
+                    PutVarint(entries, cell);
+                }
+            }
+        }
+        PutVarint(out, changed);
+        out.insert(out.end(), entries.begin(), entries.end());
+    }
+
+    void EncodeFoods(const WorldFrame& from, const WorldFrame& to, std::vector<uint8_t>& out) {
+        std::size_t changed = 0;
+        for (std::size_t i = 0; i < to.foods.size(); ++i) {
+            if (i >= from.foods.size() || from.foods[i] != to.foods[i]) {
+                ++changed;
+            }
+        }
+        PutVarint(out, to.foods.size());
+        PutVarint(out, changed);
+        std::size_t next_index = 0;
+        for (std::size_t i = 0; i < to.foods.size(); ++i) {
+            if (i >= from.foods.size() || from.foods[i] != to.foods[i]) {
+                PutVarint(out, i - next_index);
+                PutVarint(out, to.foods[i]);
+                next_index = i + 1;
+            }
+        }
+    }
+
+    // Both lists are sorted by id, so one merge pass sorts every obstacle
+    // into expired, spawned or moved. An id whose type or pattern changed
+    // is sent as an expiry and a spawn.
+    void EncodeObstacles(const WorldFrame& from, const WorldFrame& to, std::vector<uint8_t>& out) {
+        std::vector<uint32_t> expired;
+        std::vector<const WorldFrame::ObstacleState*> spawned;
+        std::vector<const WorldFrame::ObstacleState*> moved;
+        std::size_t i = 0, j = 0;
+        while (i < from.obstacles.size() || j < to.obstacles.size()) {
+            if (j == to.obstacles.size() ||
+                (i < from.obstacles.size() && from.obstacles[i].id < to.obstacles[j].id)) {
+                expired.push_back(from.obstacles[i++].id);
+            } else if (i == from.obstacles.size() || to.obstacles[j].id < from.obstacles[i].id) {
+                spawned.push_back(&to.obstacles[j++]);
+            } else {
+                const auto& before = from.obstacles[i++];
+                const auto& after = to.obstacles[j++];
+                if (before.type != after.type || before.pattern != after.pattern) {
+                    expired.push_back(before.id);
+                    spawned.push_back(&after);
+                } else if (before.cell != after.cell) {
+                    moved.push_back(&after);
+                }
+            }
+        }
+        uint32_t next_id = 0;
+        PutVarint(out, expired.size());
+        for (uint32_t id : expired) {
+            PutVarint(out, id - next_id);
+            next_id = id + 1;
+        }
+        next_id = 0;
+        PutVarint(out, spawned.size());
+        for (const auto* obstacle : spawned) {
+            PutVarint(out, obstacle->id - next_id);
+            PutVarint(out, obstacle->cell);
+            out.push_back(obstacle->type);
+            out.push_back(obstacle->pattern);
+            next_id = obstacle->id + 1;
+        }
+        next_id = 0;
+        PutVarint(out, moved.size());
+        for (const auto* obstacle : moved) {
+            PutVarint(out, obstacle->id - next_id);
+            PutVarint(out, obstacle->cell);
+            next_id = obstacle->id + 1;
+        }
+    }
+}
+
+bool WorldFrame::operator==(const WorldFrame& other) const {
+    if (width != other.width || height != other.height || tick != other.tick ||
+        snakes.size() != other.snakes.size() || foods != other.foods || obstacles != other.obstacles) {
+        return false;
+    }
+    for (std::size_t i = 0; i < snakes.size(); ++i) {
+        if (snakes[i].alive != other.snakes[i].alive || snakes[i].direction != other.snakes[i].direction ||
+            snakes[i].score != other.snakes[i].score || snakes[i].body != other.snakes[i].body) {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace WorldDelta {
+
+void Encode(const WorldFrame& from, const WorldFrame& to, std::vector<uint8_t>& out) {
+    out.clear();
+    PutVarint(out, to.tick);
+    EncodeSnakes(from, to, out);
+    EncodeFoods(from, to, out);
+    EncodeObstacles(from, to, out);
+}
+
+bool Apply(WorldFrame& frame, const uint8_t* data, std::size_t length) {
+    const uint64_t cell_count = static_cast<uint64_t>(frame.width) * frame.height;
+    if (cell_count == 0) {
+        return false;
+    }
+    Reader reader(data, length);
+    frame.tick = reader.Varint();
+
+    // Snakes
+    uint64_t snake_count = reader.Varint();
+    uint64_t changed = reader.Varint();
+    if (!reader.Ok() || snake_count > cell_count || changed > snake_count) {
+        return false;
+    }
+    frame.snakes.resize(static_cast<std::size_t>(snake_count));
+    uint64_t index = 0;
+    for (uint64_t n = 0; n < changed; ++n) {
+        index += reader.Varint();
+        if (!reader.Ok() || index >= snake_count) {
+            return false;
+        }
+        WorldFrame::SnakeState& snake = frame.snakes[static_cast<std::size_t>(index)];
+        ++index;
+        uint8_t flags = reader.U8();
+        snake.alive = (flags & kAlive) != 0;
+        if (flags & kScore) {
+            snake.score = static_cast<int32_t>(reader.Varint());
+        }
+        if (flags & kDirection) {
+            snake.direction = reader.U8();
+            if (snake.direction > kMaxDirection) {
+                return false;
+            }
+        }
+        if (flags & kBodySteps) {
+            uint64_t tail_drop = reader.Varint();
+            uint64_t steps = reader.Varint();
+            if (!reader.Ok() || tail_drop >= snake.body.size() || steps > kMaxSteps) {
+                return false;
+            }
+            snake.body.erase(snake.body.begin(), snake.body.begin() + static_cast<std::ptrdiff_t>(tail_drop));
+            uint8_t packed = 0;
+            for (uint64_t s = 0; s < steps; ++s) {
+                if (s % 4 == 0) {
+                    packed = reader.U8();
+                }
+                int step = (packed >> (2 * (s % 4))) & 3;
+                snake.body.push_back(StepFrom(snake.body.back(), step, frame.width, frame.height));
+            }
+        } else if (flags & kBodyWhole) {
+            uint64_t size = reader.Varint();
+            if (!reader.Ok() || size > cell_count) {
+                return false;
+            }
+            snake.body.resize(static_cast<std::size_t>(size));
+            for (uint32_t& cell : snake.body) {
+                uint64_t value = reader.Varint();
+                if (value >= cell_count) {
+                    return false;
+                }
+                cell = static_cast<uint32_t>(value);
+            }
+        }
+    }
+
+    // Food
+    uint64_t food_count = reader.Varint();
+    changed = reader.Varint();
+    if (!reader.Ok() || food_count > cell_count || changed > food_count) {
+        return false;
+    }
+    frame.foods.resize(static_cast<std::size_t>(food_count), 0);
+    index = 0;
+    for (uint64_t n = 0; n < changed; ++n) {
+        index += reader.Varint();
+        uint64_t cell = reader.Varint();
+        if (!reader.Ok() || index >= food_count || cell >= cell_count) {
+            return false;
+        }
+        frame.foods[static_cast<std::size_t>(index++)] = static_cast<uint32_t>(cell);
+    }
+
+    // Obstacles: expiries, spawns, then moves, each in ascending id order
+    auto find = [&frame](uint64_t id) {
+        auto it = std::lower_bound(frame.obstacles.begin(), frame.obstacles.end(), id,
+                                   [](const WorldFrame::ObstacleState& obstacle, uint64_t value) {
+                                       return obstacle.id < value;
+                                   });
+        return it != frame.obstacles.end() && it->id == id ? it : frame.obstacles.end();
+    };
+    uint64_t count = reader.Varint();
+    if (!reader.Ok() || count > frame.obstacles.size()) {
+        return false;
+    }
+    uint64_t id = 0;
+    for (uint64_t n = 0; n < count; ++n) {
+        id += reader.Varint();
+        auto it = find(id);
+        if (!reader.Ok() || it == frame.obstacles.end()) {
+            return false;
+        }
+        frame.obstacles.erase(it);
+        ++id;
+    }
+    count = reader.Varint();
+    if (!reader.Ok() || count > cell_count) {
+        return false;
+    }
+    id = 0;
+    for (uint64_t n = 0; n < count; ++n) {
+        id += reader.Varint();
+        uint64_t cell = reader.Varint();
+        uint8_t type = reader.U8();
+        uint8_t pattern = reader.U8();
+        if (!reader.Ok() || id > UINT32_MAX || cell >= cell_count || find(id) != frame.obstacles.end()) {
+            return false;
+        }
+        WorldFrame::ObstacleState obstacle{static_cast<uint32_t>(id), static_cast<uint32_t>(cell), type, pattern};
+        auto it = std::lower_bound(frame.obstacles.begin(), frame.obstacles.end(), obstacle.id,
+                                   [](const WorldFrame::ObstacleState& existing, uint32_t value) {
+                                       return existing.id < value;
+                                   });
+        frame.obstacles.insert(it, obstacle);
+        ++id;
+    }
+    count = reader.Varint();
+    if (!reader.Ok() || count > frame.obstacles.size()) {
+        return false;
+    }
+    id = 0;
+    for (uint64_t n = 0; n < count; ++n) {
+        id += reader.Varint();
+        uint64_t cell = reader.Varint();
+        auto it = find(id);
+        if (!reader.Ok() || it == frame.obstacles.end() || cell >= cell_count) {
+            return false;
+        }
+        it->cell = static_cast<uint32_t>(cell);
+        ++id;
+    }
+
+    return reader.Ok() && reader.AtEnd();
+}
+
+}
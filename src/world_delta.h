@@ -0,0 +1,73 @@
+#ifndef WORLD_DELTA_H
+#define WORLD_DELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What a network client sees of an Arena: every snake's body, heading,
+// score and liveness, the food items and the obstacles, with cells as indices
+// (y * width + x). Obstacles carry server-assigned ids, sorted ascending.
+struct WorldFrame {
+    struct SnakeState {
+        bool alive{false};
+        uint8_t direction{0}; // Snake::Direction
+        int32_t score{0};
+        std::vector<uint32_t> body; // Tail first, head last; empty while dead
+    };
+
+    struct ObstacleState {
+        uint32_t id;
+        uint32_t cell;
+        uint8_t type;    // ObstacleType
+        uint8_t pattern; // MovementPattern, moving obstacles only
+
+        bool operator==(const ObstacleState& other) const {
+            return id == other.id && cell == other.cell && type == other.type && pattern == other.pattern;
+        }
+    };
+
+    uint32_t width{0};
+    uint32_t height{0};
+    uint64_t tick{0};
+    std::vector<SnakeState> snakes;
+    std::vector<uint32_t> foods;
+    std::vector<ObstacleState> obstacles;
+
+    bool operator==(const WorldFrame& other) const;
+    bool operator!=(const WorldFrame& other) const { return !(*this == other); }
+};
+
+// Delta encoding between two frames of the same board. Only what changed
+// is written, as LEB128 varints:
+//   tick, snake count, changed snakes (index gap, flags, score and
+//     direction byte if they changed, and either head steps or a whole
+//     body),
+//   food count, moved foods (index gap, cell),
+//   expired obstacle ids, spawned obstacles (id gap, cell, type, pattern),
+//   moved obstacles (id gap, cell).
+// A snake that moved drops cells from its tail and adds head cells, each
+// one step from the last (2 bits per step on the wrapping board), so a
+// moving snake costs a few bytes whatever its length. Anything else (a
+// spawn, a respawn) is sent as the whole body.
+//
+// A frame encoded against an empty one (same board) is a keyframe.
+namespace WorldDelta {
+    // `out` is cleared first
+    void Encode(const WorldFrame& from, const WorldFrame& to, std::vector<uint8_t>& out);
+
+    // Updates `frame` in place; false (frame left partly updated) for a
+    // malformed delta or one that does not fit the frame's board
+    bool Apply(WorldFrame& frame, const uint8_t* data, std::size_t length);
+}
+
+// Messages between GameServer and GameClient, framed by MessageStream
+namespace NetMessage {
+    enum Type : uint8_t {
+        kWelcome = 1, // Server: u32 width, u32 height, u32 the client's snake index
+        kState = 2,   // Server: a WorldDelta against the previous state (the first is a keyframe)
+        kInput = 3    // Client: u8 Snake::Direction
+    };
+}
+
+#endif